@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/parallel_apply_permutation.h>
+#include "../benchmarking-tools/filesystem.h"
+#include "../benchmarking-tools/statistics.h"
+
+using namespace std::chrono_literals;
+
+////////////////////////////////////////////////////////////
+// Benchmark configuration variables
+
+// Type of the elements to permute: big enough for the moves to
+// dominate the accesses to the indices
+struct value_t
+{
+    std::uint64_t data[4];
+};
+
+using collection_t = std::vector<value_t>;
+using indices_t = std::vector<std::ptrdiff_t>;
+
+// Ways to apply a permutation to benchmark
+using permute_f = void (*)(collection_t&, indices_t&);
+std::pair<std::string, permute_f> permutations[] = {
+    { "apply_permutation", [](collection_t& collection, indices_t& indices) {
+        // The indices are modified, work on a copy
+        indices_t copy = indices;
+        cppsort::utility::apply_permutation(collection, copy);
+    }},
+    { "apply_const_permutation", [](collection_t& collection, indices_t& indices) {
+        cppsort::utility::apply_const_permutation(collection, indices);
+    }},
+    { "parallel_apply_permutation", [](collection_t& collection, indices_t& indices) {
+        cppsort::utility::parallel_apply_permutation(collection, indices);
+    }},
+    { "gather", [](collection_t& collection, indices_t& indices) {
+        // Out-of-place: gather into a fresh buffer and move it back
+        collection_t buffer;
+        buffer.reserve(collection.size());
+        for (auto idx: indices) {
+            buffer.push_back(std::move(collection[idx]));
+        }
+        collection = std::move(buffer);
+    }},
+};
+
+// Sizes of the collections to permute
+std::uint64_t size_min = 1u << 10;
+std::uint64_t size_max = 1u << 24;
+
+// Maximum time to let the benchmark run for a given size before giving up
+auto max_run_time = 20s;
+// Maximum number of benchmark runs per size
+std::size_t max_runs_per_size = 25;
+
+
+////////////////////////////////////////////////////////////
+// Benchmark code proper
+
+int main(int argc, char** argv)
+{
+    // Choose the output directory
+    std::string output_directory = ".";
+    if (argc > 1) {
+        output_directory = argv[1];
+    }
+
+    // Always use a steady clock
+    using clock_type = std::conditional_t<
+        std::chrono::high_resolution_clock::is_steady,
+        std::chrono::high_resolution_clock,
+        std::chrono::steady_clock
+    >;
+
+    // Poor seed, yet enough for our benchmarks
+    std::uint_fast32_t seed = std::time(nullptr);
+    std::cout << "SEED: " << seed << '\n';
+
+    for (auto& permutation: permutations) {
+        // Create a file to store the results
+        std::string output_filename = output_directory + '/' + safe_file_name(permutation.first) + ".csv";
+        std::ofstream output_file(output_filename);
+        output_file << permutation.first << '\n';
+        std::cout << permutation.first << '\n';
+
+        // Seed the generator manually to ensure that all algorithms
+        // apply the same permutations
+        std::mt19937_64 prng(seed);
+
+        std::uint64_t pow_of_2 = 9;  // For logs
+        for (auto size = size_min ; size <= size_max ; size <<= 1) {
+            std::vector<double> times;
+
+            auto total_start = clock_type::now();
+            auto total_end = clock_type::now();
+            while (total_end - total_start < max_run_time && times.size() < max_runs_per_size) {
+                collection_t collection(size);
+                for (std::size_t idx = 0 ; idx < size ; ++idx) {
+                    collection[idx].data[0] = idx;
+                }
+                indices_t indices(size);
+                std::iota(indices.begin(), indices.end(), 0);
+                std::shuffle(indices.begin(), indices.end(), prng);
+
+                auto start = clock_type::now();
+                permutation.second(collection, indices);
+                auto end = clock_type::now();
+                assert(std::equal(collection.begin(), collection.end(), indices.begin(),
+                                  [](const value_t& value, std::ptrdiff_t idx) {
+                                      return value.data[0] == static_cast<std::uint64_t>(idx);
+                                  }));
+
+                times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                total_end = clock_type::now();
+            }
+
+            // Compute and display stats & numbers
+            double avg = average(times);
+
+            std::ostringstream ss;
+            ss << ++pow_of_2 << ", "
+               << size << ", "
+               << avg << ", "
+               << standard_deviation(times, avg) << '\n';
+            output_file << ss.str();
+            std::cout << ss.str();
+
+            // Abort if the allocated time was merely enough to benchmark a single run
+            if (times.size() < 2) break;
+        }
+    }
+}
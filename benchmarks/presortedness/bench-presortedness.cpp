@@ -37,6 +37,9 @@ std::pair<std::string, sort_f> sorts[] = {
     { "heap_sort",                      cppsort::heap_sort                                  },
     { "drop_merge_adapter(heap_sort)",  cppsort::drop_merge_adapter<cppsort::heap_sorter>{} },
     { "split_adapter(heap_sort)",       cppsort::split_adapter<cppsort::heap_sorter>{}      },
+    { "tim_sort",                       cppsort::tim_sort                                   },
+    { "adaptive_shivers_sort",          cppsort::adaptive_shivers_sort                      },
+    { "tim_sort(powersort)",            cppsort::powersort_sort                             },
 };
 
 // Size of the collections to sort
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+
+////////////////////////////////////////////////////////////
+// Helps to tune the thresholds of auto_sorter_table for the
+// current machine: for every distribution, it prints the
+// features measured by auto_sorter, the algorithm it picks
+// and the time taken by every candidate algorithm. When the
+// fastest candidate differs from the picked one, moving the
+// corresponding thresholds of the decision table towards the
+// printed features improves the decisions.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorters/auto_sorter.h>
+#include "../benchmarking-tools/cpu_cycles.h"
+#include "../benchmarking-tools/distributions.h"
+
+////////////////////////////////////////////////////////////
+// Benchmark configuration variables
+
+// Type of data to sort during the benchmark
+using value_t = int;
+// Type of collection to sort
+using collection_t = std::vector<value_t>;
+
+// Size of the collections to sort
+constexpr std::size_t size = 1'000'000;
+
+// Number of runs per candidate, the median is kept
+constexpr std::size_t runs_per_candidate = 5;
+
+////////////////////////////////////////////////////////////
+// Candidates
+
+struct forced_table
+{
+    cppsort::auto_sorter_choice choice;
+
+    auto choose(const cppsort::auto_sorter_features& features) const
+        -> cppsort::auto_sorter_decision
+    {
+        return { choice, "forced", features };
+    }
+};
+
+std::pair<const char*, cppsort::auto_sorter_choice> candidates[] = {
+    { "counting",   cppsort::auto_sorter_choice::counting   },
+    { "ska",        cppsort::auto_sorter_choice::ska        },
+    { "verge",      cppsort::auto_sorter_choice::verge      },
+    { "drop_merge", cppsort::auto_sorter_choice::drop_merge },
+    { "split",      cppsort::auto_sorter_choice::split      },
+    { "pdq",        cppsort::auto_sorter_choice::pdq        },
+};
+
+auto choice_name(cppsort::auto_sorter_choice choice)
+    -> const char*
+{
+    for (auto& candidate: candidates) {
+        if (candidate.second == choice) {
+            return candidate.first;
+        }
+    }
+    return "?";
+}
+
+////////////////////////////////////////////////////////////
+// Benchmark code proper
+
+template<typename Distribution>
+auto tune(const std::string& name, Distribution distribution, std::uint_fast32_t seed)
+    -> void
+{
+    distributions_prng.seed(seed);
+    collection_t collection;
+    distribution(std::back_inserter(collection), size);
+
+    auto decision = cppsort::auto_sorter<>{}.decide(collection);
+    const auto& features = decision.features;
+    std::cout << name << ','
+              << double(features.runs) / double(features.size - 1) << ','
+              << features.inversion_ratio << ','
+              << features.key_range << ','
+              << features.key_width << ','
+              << choice_name(decision.choice);
+
+    const char* fastest = nullptr;
+    std::uint64_t fastest_cycles = 0;
+    for (auto& candidate: candidates) {
+        auto sorter = cpu_cycles<cppsort::auto_sorter<forced_table>>(
+            cppsort::auto_sorter<forced_table>(forced_table{candidate.second})
+        );
+        std::vector<std::uint64_t> cycles;
+        for (std::size_t idx = 0; idx < runs_per_candidate; ++idx) {
+            auto copy = collection;
+            cycles.push_back(sorter(copy).value());
+            assert(std::is_sorted(copy.begin(), copy.end()));
+        }
+        std::nth_element(cycles.begin(), cycles.begin() + cycles.size() / 2, cycles.end());
+        auto median = cycles[cycles.size() / 2];
+        std::cout << ',' << double(median) / size;
+        if (fastest == nullptr || median < fastest_cycles) {
+            fastest = candidate.first;
+            fastest_cycles = median;
+        }
+    }
+    std::cout << ',' << fastest << std::endl;
+}
+
+int main()
+{
+    // Poor seed, yet enough for our benchmarks
+    std::uint_fast32_t seed = std::time(nullptr);
+    std::cerr << "SEED: " << seed << '\n';
+
+    std::cout << "distribution,runs ratio,inversion ratio,key range,key width,picked";
+    for (auto& candidate: candidates) {
+        std::cout << ',' << candidate.first;
+    }
+    std::cout << ",fastest\n";
+
+    tune("shuffled", dist::shuffled{}, seed);
+    tune("shuffled_16_values", dist::shuffled_16_values{}, seed);
+    tune("pipe_organ", dist::pipe_organ{}, seed);
+    tune("push_middle", dist::push_middle{}, seed);
+    tune("ascending_sawtooth", dist::ascending_sawtooth{}, seed);
+    tune("descending_sawtooth", dist::descending_sawtooth{}, seed);
+    tune("alternating", dist::alternating{}, seed);
+    for (int idx = 0; idx <= 50; idx += 2) {
+        double factor = 0.01 * idx;
+        tune("inv(" + std::to_string(factor) + ")", dist::inv(factor), seed);
+    }
+}
@@ -8,11 +8,13 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cpp-sort/adapters/compact_schwartz_adapter.h>
 #include <cpp-sort/adapters/container_aware_adapter.h>
 #include <cpp-sort/adapters/counting_adapter.h>
 #include <cpp-sort/adapters/drop_merge_adapter.h>
 #include <cpp-sort/adapters/hybrid_adapter.h>
 #include <cpp-sort/adapters/indirect_adapter.h>
+#include <cpp-sort/adapters/memory_resource_adapter.h>
 #include <cpp-sort/adapters/out_of_place_adapter.h>
 #include <cpp-sort/adapters/schwartz_adapter.h>
 #include <cpp-sort/adapters/self_sort_adapter.h>
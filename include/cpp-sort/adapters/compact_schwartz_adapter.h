@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_ADAPTERS_COMPACT_SCHWARTZ_ADAPTER_H_
+#define CPPSORT_ADAPTERS_COMPACT_SCHWARTZ_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/checkers.h"
+#include "../detail/config.h"
+#include "../detail/immovable_vector.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/ska_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    namespace detail
+    {
+        struct key_getter
+        {
+            template<typename T>
+            constexpr auto operator()(T&& value) const noexcept
+                -> decltype(auto)
+            {
+                // Braces matter here
+                return (std::forward<T>(value).first);
+            }
+        };
+    }
+
+    namespace utility
+    {
+        template<typename T>
+        struct is_probably_branchless_projection<cppsort::detail::key_getter, T>:
+            std::true_type
+        {};
+    }
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Whether the keys can be sorted with a radix sort instead of
+        // the adapted sorter: it is only done for integral keys, for
+        // which equivalent keys are also identical, which makes the
+        // order of the (key, index) pairs a stable order
+
+        template<typename Compare, typename Key>
+        struct is_compact_radix_sortable:
+            conjunction<
+                std::is_integral<Key>,
+                is_ska_sortable<Key>,
+                disjunction<
+                    std::is_same<Compare, std::less<>>,
+                    std::is_same<Compare, std::less<Key>>
+#ifdef __cpp_lib_ranges
+                    , std::is_same<Compare, std::ranges::less>
+#endif
+                >
+            >
+        {};
+
+        template<typename Key, typename Index, typename Compare, typename Sorter>
+        auto sort_compact_keys(immovable_vector<std::pair<Key, Index>>& keys,
+                               Compare compare, Sorter&& sorter, std::true_type)
+            -> void
+        {
+            (void)compare;
+            (void)sorter;
+            ska_sort(keys.begin(), keys.end(), utility::identity{});
+        }
+
+        template<typename Key, typename Index, typename Compare, typename Sorter>
+        auto sort_compact_keys(immovable_vector<std::pair<Key, Index>>& keys,
+                               Compare compare, Sorter&& sorter, std::false_type)
+            -> void
+        {
+            std::forward<Sorter>(sorter)(keys.begin(), keys.end(),
+                                         std::move(compare), key_getter{});
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Algorithm proper
+
+        template<
+            typename Index,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename Sorter
+        >
+        auto sort_with_compact_schwartz(RandomAccessIterator first, RandomAccessIterator last,
+                                        Compare compare, Projection projection, Sorter&& sorter)
+            -> void
+        {
+            using utility::iter_move;
+            using key_type = remove_cvref_t<projected_t<RandomAccessIterator, Projection>>;
+            auto&& proj = utility::as_function(projection);
+
+            // Project every element once into a dense array of keys
+            // tagged with the position of the element they come from
+            auto size = static_cast<Index>(last - first);
+            immovable_vector<std::pair<key_type, Index>> keys(size);
+            for (Index idx = 0; idx < size; ++idx) {
+                keys.emplace_back(proj(first[idx]), idx);
+            }
+
+            sort_compact_keys(keys, std::move(compare), std::forward<Sorter>(sorter),
+                              is_compact_radix_sortable<Compare, key_type>{});
+
+            // Move the elements to their sorted position by following
+            // the cycles of the permutation, the indices are reset
+            // as they are visited to mark the processed positions
+            for (Index idx = 0; idx < size; ++idx) {
+                if (keys[idx].second == idx) continue;
+                auto current = idx;
+                auto tmp = iter_move(first + current);
+                while (keys[current].second != idx) {
+                    auto next = keys[current].second;
+                    first[current] = iter_move(first + next);
+                    keys[current].second = current;
+                    current = next;
+                }
+                keys[current].second = current;
+                first[current] = std::move(tmp);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Adapter
+
+        template<typename Sorter>
+        struct compact_schwartz_adapter_impl:
+            utility::adapter_storage<Sorter>,
+            check_is_always_stable<Sorter>
+        {
+            compact_schwartz_adapter_impl() = default;
+
+            constexpr explicit compact_schwartz_adapter_impl(Sorter&& sorter):
+                utility::adapter_storage<Sorter>(std::move(sorter))
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "compact_schwartz_adapter requires at least random-access iterators"
+                );
+
+                if (last - first < 2) return;
+                if (static_cast<std::uintmax_t>(last - first) <= (std::numeric_limits<std::uint32_t>::max)()) {
+                    sort_with_compact_schwartz<std::uint32_t>(first, last,
+                                                              std::move(compare), std::move(projection),
+                                                              this->get());
+                } else {
+                    sort_with_compact_schwartz<std::size_t>(first, last,
+                                                            std::move(compare), std::move(projection),
+                                                            this->get());
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+        };
+    }
+
+    template<typename Sorter>
+    struct compact_schwartz_adapter:
+        sorter_facade<detail::compact_schwartz_adapter_impl<Sorter>>
+    {
+        compact_schwartz_adapter() = default;
+
+        constexpr explicit compact_schwartz_adapter(Sorter sorter):
+            sorter_facade<detail::compact_schwartz_adapter_impl<Sorter>>(std::move(sorter))
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<compact_schwartz_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_ADAPTERS_COMPACT_SCHWARTZ_ADAPTER_H_
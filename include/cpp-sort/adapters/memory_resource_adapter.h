@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
+#define CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../detail/config.h"
+
+#if __cplusplus > 201402L && __has_include(<memory_resource>)
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include "../detail/checkers.h"
+#include "../detail/memory.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Adapter
+
+    namespace detail
+    {
+        class memory_resource_source:
+            public scratch_memory_source
+        {
+            public:
+
+                explicit memory_resource_source(std::pmr::memory_resource* resource) noexcept:
+                    resource(resource)
+                {}
+
+                auto allocate(std::size_t bytes)
+                    -> void* override
+                {
+                    return resource->allocate(bytes, alignof(std::max_align_t));
+                }
+
+                auto deallocate(void* ptr, std::size_t bytes) noexcept
+                    -> void override
+                {
+                    resource->deallocate(ptr, bytes, alignof(std::max_align_t));
+                }
+
+            private:
+
+                std::pmr::memory_resource* resource;
+        };
+    }
+
+    template<typename Sorter>
+    struct memory_resource_adapter:
+        utility::adapter_storage<Sorter>,
+        detail::check_iterator_category<Sorter>,
+        detail::check_is_always_stable<Sorter>
+    {
+        memory_resource_adapter() = default;
+
+        constexpr explicit memory_resource_adapter(std::pmr::memory_resource* resource):
+            resource_(resource)
+        {}
+
+        constexpr explicit memory_resource_adapter(Sorter sorter,
+                                                   std::pmr::memory_resource* resource=nullptr):
+            utility::adapter_storage<Sorter>(std::move(sorter)),
+            resource_(resource)
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(this->get()(std::forward<Args>(args)...))
+        {
+            detail::memory_resource_source source(
+                resource_ ? resource_ : std::pmr::get_default_resource()
+            );
+            return detail::with_scratch_memory_source(&source, [&]() -> decltype(auto) {
+                return this->get()(std::forward<Args>(args)...);
+            });
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Accessors
+
+        auto resource() const noexcept
+            -> std::pmr::memory_resource*
+        {
+            return resource_ ? resource_ : std::pmr::get_default_resource();
+        }
+
+        private:
+
+            std::pmr::memory_resource* resource_ = nullptr;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<memory_resource_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // __cplusplus > 201402L && __has_include(<memory_resource>)
+
+#endif // CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
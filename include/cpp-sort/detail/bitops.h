@@ -129,6 +129,27 @@ namespace detail
         return x != 0 && (x & (x - 1)) == 0;
     }
 
+    // Returns the number of trailing zero bits, assumes n > 0
+
+#if defined(__GNUC__) || defined(__clang__)
+    constexpr auto countr_zero(unsigned long long n)
+        -> int
+    {
+        return __builtin_ctzll(n);
+    }
+#else
+    constexpr auto countr_zero(unsigned long long n)
+        -> int
+    {
+        int count = 0;
+        while ((n & 1u) == 0) {
+            n >>= 1;
+            ++count;
+        }
+        return count;
+    }
+#endif
+
     // Left bit rotation
     template<typename Unsigned>
     constexpr auto rotl(Unsigned x, int s)
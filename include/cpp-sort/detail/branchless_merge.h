@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
+#define CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "move.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Whether two runs can be merged without branching on the
+    // result of the comparisons: the comparison and projections
+    // must be branchless, and the iterators must be random-access
+    // so that the element to move can be selected with a
+    // conditional move, then both cursors advanced by the result
+    // of the comparison
+
+    template<
+        typename Iterator1,
+        typename Iterator2,
+        typename Compare,
+        typename Projection1,
+        typename Projection2 = Projection1
+    >
+    struct is_branchless_merge:
+        conjunction<
+            std::is_base_of<std::random_access_iterator_tag, iterator_category_t<Iterator1>>,
+            std::is_base_of<std::random_access_iterator_tag, iterator_category_t<Iterator2>>,
+            std::is_same<rvalue_reference_t<Iterator1>, rvalue_reference_t<Iterator2>>,
+            std::is_reference<rvalue_reference_t<Iterator1>>,
+            std::is_same<projected_t<Iterator1, Projection1>, projected_t<Iterator2, Projection2>>,
+            utility::is_probably_branchless_comparison<Compare, projected_t<Iterator1, Projection1>>,
+            utility::is_probably_branchless_projection<Projection1, value_type_t<Iterator1>>,
+            utility::is_probably_branchless_projection<Projection2, value_type_t<Iterator2>>
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Forward merge: every step is unguarded as long as it can't
+    // exhaust any of the runs, which is true for as many steps
+    // as there are elements in the smallest run; this is done
+    // again until one of the runs is exhausted. Returns the
+    // position of the output iterator at that point, leaving
+    // the first and second iterators at the end of the merged
+    // elements of their respective runs.
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename OutputIterator,
+        typename Compare,
+        typename Projection1,
+        typename Projection2
+    >
+    auto branchless_merge_loop(RandomAccessIterator1& first1, RandomAccessIterator1 last1,
+                               RandomAccessIterator2& first2, RandomAccessIterator2 last2,
+                               OutputIterator result, Compare compare,
+                               Projection1 projection1, Projection2 projection2)
+        -> OutputIterator
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator1>;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj1 = utility::as_function(projection1);
+        auto&& proj2 = utility::as_function(projection2);
+
+        while (true) {
+            auto n = (std::min)(
+                static_cast<difference_type>(last1 - first1),
+                static_cast<difference_type>(last2 - first2)
+            );
+            if (n == 0) {
+                return result;
+            }
+            do {
+                bool take2 = comp(proj2(*first2), proj1(*first1));
+                *result = take2 ? iter_move(first2) : iter_move(first1);
+                ++result;
+                first2 += take2;
+                first1 += not take2;
+            } while (--n != 0);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Bidirectional merge: the front of the output is filled
+    // with the smallest elements while its back is concurrently
+    // filled with the biggest ones, giving two independent
+    // dependency chains per iteration. Both ends are unguarded
+    // for as many steps as there are elements in the smallest
+    // run, the elements left in the middle are merged forward.
+    //
+    // The front step might read an element that was already
+    // moved by the back step once a run is exhausted, which is
+    // fine as long as moving doesn't alter the moved-from value,
+    // hence the trivially copyable requirement.
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename RandomAccessIterator3,
+        typename Compare,
+        typename Projection1,
+        typename Projection2
+    >
+    auto bidirectional_branchless_merge_move(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                             RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                             RandomAccessIterator3 result, Compare compare,
+                                             Projection1 projection1, Projection2 projection2)
+        -> RandomAccessIterator3
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator1>;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj1 = utility::as_function(projection1);
+        auto&& proj2 = utility::as_function(projection2);
+
+        auto len1 = static_cast<difference_type>(last1 - first1);
+        auto len2 = static_cast<difference_type>(last2 - first2);
+        auto result_last = result + (len1 + len2);
+        auto back = result_last;
+
+        for (auto n = (std::min)(len1, len2) ; n != 0 ; --n) {
+            bool take2 = comp(proj2(*first2), proj1(*first1));
+            *result = take2 ? iter_move(first2) : iter_move(first1);
+            ++result;
+            first2 += take2;
+            first1 += not take2;
+
+            auto prev1 = last1 - 1;
+            auto prev2 = last2 - 1;
+            bool take1 = comp(proj2(*prev2), proj1(*prev1));
+            --back;
+            *back = take1 ? iter_move(prev1) : iter_move(prev2);
+            last1 -= take1;
+            last2 -= not take1;
+        }
+
+        result = branchless_merge_loop(first1, last1, first2, last2, result,
+                                       std::move(compare), std::move(projection1),
+                                       std::move(projection2));
+        result = detail::move(first1, last1, result);
+        detail::move(first2, last2, result);
+        return result_last;
+    }
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename OutputIterator,
+        typename Compare,
+        typename Projection1,
+        typename Projection2
+    >
+    auto branchless_merge_move(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                               OutputIterator result, Compare compare,
+                               Projection1 projection1, Projection2 projection2,
+                               std::false_type /* bidirectional */)
+        -> OutputIterator
+    {
+        result = branchless_merge_loop(first1, last1, first2, last2, result,
+                                       std::move(compare), std::move(projection1),
+                                       std::move(projection2));
+        result = detail::move(first1, last1, result);
+        return detail::move(first2, last2, result);
+    }
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename RandomAccessIterator3,
+        typename Compare,
+        typename Projection1,
+        typename Projection2
+    >
+    auto branchless_merge_move(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                               RandomAccessIterator3 result, Compare compare,
+                               Projection1 projection1, Projection2 projection2,
+                               std::true_type /* bidirectional */)
+        -> RandomAccessIterator3
+    {
+        return bidirectional_branchless_merge_move(
+            std::move(first1), std::move(last1),
+            std::move(first2), std::move(last2),
+            std::move(result), std::move(compare),
+            std::move(projection1), std::move(projection2)
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Out-of-place merge, moves the elements of both runs to
+    // the output range and returns the end of that range
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename OutputIterator,
+        typename Compare,
+        typename Projection1,
+        typename Projection2
+    >
+    auto branchless_merge_move(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                               OutputIterator result, Compare compare,
+                               Projection1 projection1, Projection2 projection2)
+        -> OutputIterator
+    {
+        using is_bidirectional = conjunction<
+            std::is_base_of<std::random_access_iterator_tag, iterator_category_t<OutputIterator>>,
+            std::is_trivially_copyable<value_type_t<RandomAccessIterator1>>
+        >;
+        return branchless_merge_move(
+            std::move(first1), std::move(last1),
+            std::move(first2), std::move(last2),
+            std::move(result), std::move(compare),
+            std::move(projection1), std::move(projection2),
+            std::integral_constant<bool, is_bidirectional::value>{}
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merge where the second run is already at the end of the
+    // output range, hence it doesn't need to be moved once the
+    // first run is exhausted
+
+    template<
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename OutputIterator,
+        typename Compare,
+        typename Projection
+    >
+    auto branchless_half_inplace_merge(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                       RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                       OutputIterator result,
+                                       Compare compare, Projection projection)
+        -> void
+    {
+        result = branchless_merge_loop(first1, last1, first2, last2, result,
+                                       std::move(compare), projection, projection);
+        // If the first run is exhausted, the elements of the
+        // second one are already in the right spot
+        detail::move(first1, last1, result);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_BRANCHLESS_MERGE_H_
@@ -19,10 +19,12 @@
 ////////////////////////////////////////////////////////////
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "branchless_merge.h"
 #include "config.h"
 #include "iterator_traits.h"
 #include "memory.h"
@@ -42,7 +44,8 @@ namespace detail
     auto half_inplace_merge(InputIterator1 first1, InputIterator1 last1,
                             InputIterator2 first2, InputIterator2 last2,
                             OutputIterator result, Size min_len,
-                            Compare compare, Projection projection)
+                            Compare compare, Projection projection,
+                            std::false_type /* branchless */)
         -> void
     {
         using utility::iter_move;
@@ -95,6 +98,42 @@ namespace detail
         }
     }
 
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+             typename OutputIterator, typename Size,
+             typename Compare, typename Projection>
+    auto half_inplace_merge(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                            RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                            OutputIterator result, Size,
+                            Compare compare, Projection projection,
+                            std::true_type /* branchless */)
+        -> void
+    {
+        branchless_half_inplace_merge(std::move(first1), std::move(last1),
+                                      std::move(first2), std::move(last2),
+                                      std::move(result),
+                                      std::move(compare), std::move(projection));
+    }
+
+    template<typename InputIterator1, typename InputIterator2,
+             typename OutputIterator, typename Size,
+             typename Compare, typename Projection>
+    auto half_inplace_merge(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2,
+                            OutputIterator result, Size min_len,
+                            Compare compare, Projection projection)
+        -> void
+    {
+        using is_branchless = is_branchless_merge<
+            InputIterator1, InputIterator2,
+            Compare, Projection
+        >;
+        half_inplace_merge(std::move(first1), std::move(last1),
+                           std::move(first2), std::move(last2),
+                           std::move(result), min_len,
+                           std::move(compare), std::move(projection),
+                           std::integral_constant<bool, is_branchless::value>{});
+    }
+
     ////////////////////////////////////////////////////////////
     // Prepare the buffer prior to the blind merge (only for
     // bidirectional iterator)
@@ -27,6 +27,10 @@
 #   define __has_cpp_attribute(x) 0
 #endif
 
+#ifndef __has_builtin
+#   define __has_builtin(x) 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // Check for C++17 features
 
@@ -39,6 +43,23 @@
 #   define CPPSORT_INLINE_VARIABLE static
 #endif
 
+////////////////////////////////////////////////////////////
+// Execution policies
+
+// Some components of the library accept standard execution
+// policies when <execution> is available; this can be disabled
+// by defining CPPSORT_DISABLE_EXECUTION_POLICIES, for example
+// with standard library implementations that require to link
+// against an additional library as soon as <execution> is
+// included
+
+#if !defined(CPPSORT_DISABLE_EXECUTION_POLICIES) && \
+    defined(__cpp_lib_execution) && __has_include(<execution>)
+#   define CPPSORT_EXECUTION_POLICIES 1
+#else
+#   define CPPSORT_EXECUTION_POLICIES 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // Check for C++20 features
 
@@ -58,6 +79,20 @@
 #   define CPPSORT_STD_IDENTITY_AVAILABLE 0
 #endif
 
+// The vectorized algorithms can't run during constant evaluation,
+// the compilers that can detect it provide a builtin that also
+// works before C++20, CPPSORT_IS_CONSTANT_EVALUATED() is only
+// defined when it is available
+
+#if __has_builtin(__builtin_is_constant_evaluated) || \
+    (defined(__GNUC__) && __GNUC__ >= 9) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1925)
+#   define CPPSORT_IS_CONSTANT_EVALUATED_AVAILABLE 1
+#   define CPPSORT_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#   define CPPSORT_IS_CONSTANT_EVALUATED_AVAILABLE 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // General: assertions
 
@@ -134,6 +169,22 @@
 #   define CPPSORT_ASSUME(cond) ((void)0)
 #endif
 
+////////////////////////////////////////////////////////////
+// Vectorized code paths
+
+// Some algorithms have code paths using x86 SIMD instructions,
+// which are compiled with function-level target attributes and
+// selected at runtime depending on the instructions supported
+// by the processor: they don't require specific compiler flags
+// and can be disabled by defining CPPSORT_DISABLE_SIMD
+
+#if !defined(CPPSORT_DISABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__)) && __has_include(<immintrin.h>)
+#   define CPPSORT_SIMD_X86 1
+#else
+#   define CPPSORT_SIMD_X86 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // CPPSORT_UNREACHABLE
 
@@ -33,6 +33,7 @@
 #include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "is_sorted_until.h"
 #include "iterator_traits.h"
 #include "type_traits.h"
 
@@ -65,9 +66,14 @@ namespace detail
         using rvalue_type = rvalue_type_t<BidirectionalIterator>;
         std::vector<rvalue_type> dropped;
 
+        // Elements of the sorted prefix are never dropped nor moved,
+        // skip them all at once, vectorized when possible
+        auto write = detail::is_sorted_until(begin, end, compare, projection);
+        if (write == end) {
+            return;
+        }
+        auto read = write;
         difference_type num_dropped_in_row = 0;
-        auto write = begin;
-        auto read = begin;
 
         constexpr difference_type recency = 8;
 
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_EXECUTION_POLICY_H_
+#define CPPSORT_DETAIL_EXECUTION_POLICY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <type_traits>
+#include "config.h"
+#include "type_traits.h"
+
+#if CPPSORT_EXECUTION_POLICIES
+#   include <execution>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+#if CPPSORT_EXECUTION_POLICIES
+    template<typename T>
+    struct is_execution_policy:
+        std::is_execution_policy<remove_cvref_t<T>>
+    {};
+
+    // Policies allowing an algorithm to spread its work over
+    // several threads, other policies are executed on the
+    // calling thread
+    template<typename T>
+    struct is_parallel_policy:
+        disjunction<
+            std::is_same<remove_cvref_t<T>, std::execution::parallel_policy>,
+            std::is_same<remove_cvref_t<T>, std::execution::parallel_unsequenced_policy>
+        >
+    {};
+#else
+    template<typename T>
+    struct is_execution_policy:
+        std::false_type
+    {};
+
+    template<typename T>
+    struct is_parallel_policy:
+        std::false_type
+    {};
+#endif
+}}
+
+#endif // CPPSORT_DETAIL_EXECUTION_POLICY_H_
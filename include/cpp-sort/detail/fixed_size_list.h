@@ -142,7 +142,7 @@ namespace detail
 
             explicit fixed_size_list_node_pool(std::ptrdiff_t capacity):
                 // Allocate enough space to store N nodes
-                buffer_(static_cast<node_type*>(::operator new(capacity * sizeof(node_type))),
+                buffer_(static_cast<node_type*>(allocate_scratch(capacity * sizeof(node_type))),
                        operator_deleter(capacity * sizeof(node_type))),
                 first_free_(buffer_.get()),
                 capacity_(capacity)
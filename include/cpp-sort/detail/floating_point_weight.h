@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016 Morwenn
+ * Copyright (c) 2016-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_DETAIL_FLOATING_POINT_WEIGHT_H_
@@ -8,7 +8,12 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <climits>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "memcpy_cast.h"
 
 namespace cppsort
 {
@@ -75,6 +80,33 @@ namespace detail
                 return 0;
         }
     }
+
+    template<typename FloatingPoint>
+    using total_order_key_t = std::conditional_t<
+        sizeof(FloatingPoint) == sizeof(std::uint32_t),
+        std::uint32_t,
+        std::uint64_t
+    >;
+
+    template<typename FloatingPoint>
+    auto total_order_key(FloatingPoint value)
+        -> total_order_key_t<FloatingPoint>
+    {
+        // Maps an IEEE 754 number to an unsigned integer such that
+        // the integers are ordered according to IEEE 754 totalOrder:
+        // the sign bit is set for positive numbers, while every bit
+        // is flipped for negative ones so that the negative numbers
+        // with the biggest magnitude come first. Sorting numbers that
+        // aren't NaN by key also sorts them according to std::less.
+        static_assert(std::numeric_limits<FloatingPoint>::is_iec559, "");
+        using key_type = total_order_key_t<FloatingPoint>;
+        constexpr int sign_shift = sizeof(key_type) * CHAR_BIT - 1;
+        constexpr key_type sign_mask = key_type(1) << sign_shift;
+
+        auto bits = memcpy_cast<key_type>(value);
+        key_type flip_mask = key_type(0) - (bits >> sign_shift);
+        return bits ^ (flip_mask | sign_mask);
+    }
 }}
 
 #endif // CPPSORT_DETAIL_FLOATING_POINT_WEIGHT_H_
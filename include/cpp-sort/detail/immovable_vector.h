@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Morwenn
+ * Copyright (c) 2021-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_DETAIL_IMMOVABLE_VECTOR_H_
@@ -48,9 +48,10 @@ namespace detail
             explicit immovable_vector(std::ptrdiff_t n):
                 capacity_(n),
                 memory_(
-                    static_cast<T*>(::operator new(n * sizeof(T)))
+                    static_cast<T*>(allocate_scratch(n * sizeof(T)))
                 ),
-                end_(memory_)
+                end_(memory_),
+                source_(current_scratch_memory_source())
             {}
 
             ////////////////////////////////////////////////////////////
@@ -62,11 +63,7 @@ namespace detail
                 detail::destroy(memory_, end_);
 
                 // Free the allocated memory
-#ifdef __cpp_sized_deallocation
-                ::operator delete(memory_, capacity_ * sizeof(T));
-#else
-                ::operator delete(memory_);
-#endif
+                deallocate_scratch(memory_, capacity_ * sizeof(T), source_);
             }
 
             ////////////////////////////////////////////////////////////
@@ -154,6 +151,7 @@ namespace detail
             std::ptrdiff_t capacity_;
             T* memory_;
             T* end_;
+            scratch_memory_source* source_;
     };
 }}
 
@@ -8,7 +8,12 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <type_traits>
+#include <utility>
 #include <cpp-sort/utility/as_function.h>
+#include "config.h"
+#include "simd.h"
+#include "simd_adjacent_find.h"
 
 namespace cppsort
 {
@@ -16,7 +21,7 @@ namespace detail
 {
     template<typename ForwardIterator, typename Compare, typename Projection>
     constexpr auto is_sorted_until(ForwardIterator first, ForwardIterator last,
-                                   Compare compare, Projection projection)
+                                   Compare compare, Projection projection, std::false_type)
         -> ForwardIterator
     {
         if (first != last) {
@@ -34,6 +39,36 @@ namespace detail
         return last;
     }
 
+    template<typename ContiguousIterator, typename Compare, typename Projection>
+    constexpr auto is_sorted_until(ContiguousIterator first, ContiguousIterator last,
+                                   Compare compare, Projection projection, std::true_type)
+        -> ContiguousIterator
+    {
+#if CPPSORT_IS_CONSTANT_EVALUATED_AVAILABLE
+        if (CPPSORT_IS_CONSTANT_EVALUATED()) {
+            return detail::is_sorted_until(std::move(first), std::move(last),
+                                           std::move(compare), std::move(projection),
+                                           std::false_type{});
+        }
+#endif
+        // Vectorized search for the first step-down
+        auto it = detail::find_adjacent_pair(first, last, adjacent_descent{},
+                                             std::move(compare), std::move(projection));
+        return it == last ? last : it + 1;
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    constexpr auto is_sorted_until(ForwardIterator first, ForwardIterator last,
+                                   Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        return detail::is_sorted_until(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection),
+            is_simd_compatible<ForwardIterator, Compare, Projection>{}
+        );
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     constexpr auto is_sorted(ForwardIterator first, ForwardIterator last,
                              Compare compare, Projection projection)
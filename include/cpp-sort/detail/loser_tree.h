@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_LOSER_TREE_H_
+#define CPPSORT_DETAIL_LOSER_TREE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "config.h"
+#include "iterator_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Tournament tree of losers used to merge k sorted sources:
+    // every internal node remembers the source that lost the match
+    // played there, and the overall winner is stored at the root.
+    // Replacing the head of the winning source only replays the
+    // matches on the path from its leaf to the root, which takes
+    // log2(k) comparisons.
+    //
+    // Sources are identified by their index in [0, k) and the tree
+    // stores an iterator to the current head of every source along
+    // with whether the source is exhausted, which keeps everything
+    // needed to play a match in the same cache line. Ties are
+    // broken in favour of the source with the smallest index, which
+    // makes merges stable when the sources are given in order.
+
+    template<typename Iterator, typename Compare, typename Projection>
+    class loser_tree
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            loser_tree(std::size_t nb_sources, Compare compare, Projection projection):
+                nb_sources_(nb_sources),
+                heads_(nb_sources),
+                nodes_(nb_sources == 0 ? 1 : nb_sources, 0),
+                data_(std::move(compare), std::move(projection))
+            {}
+
+            // Sets the initial head of a source, build() must be
+            // called once all of the heads are set; sources without
+            // a head are considered exhausted
+            auto set_head(std::size_t source, Iterator head)
+                -> void
+            {
+                CPPSORT_ASSERT(source < nb_sources_);
+                heads_[source].it = std::move(head);
+                heads_[source].exhausted = false;
+            }
+
+            auto build()
+                -> void
+            {
+                if (nb_sources_ == 0) {
+                    return;
+                }
+                nodes_[0] = build_subtree(1);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            auto size() const noexcept
+                -> std::size_t
+            {
+                return nb_sources_;
+            }
+
+            // Whether all of the sources are exhausted
+            auto empty() const noexcept
+                -> bool
+            {
+                return nb_sources_ == 0 || heads_[nodes_[0]].exhausted;
+            }
+
+            // Source holding the smallest head
+            auto winner() const noexcept
+                -> std::size_t
+            {
+                return nodes_[0];
+            }
+
+            // Iterator to the smallest head
+            auto top_iterator() const
+                -> Iterator
+            {
+                CPPSORT_ASSERT(not empty());
+                return heads_[nodes_[0]].it;
+            }
+
+            auto top() const
+                -> reference_t<Iterator>
+            {
+                CPPSORT_ASSERT(not empty());
+                return *heads_[nodes_[0]].it;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Modifiers
+
+            // Replaces the head of the winning source with a new head
+            auto replace_top(Iterator head)
+                -> void
+            {
+                heads_[nodes_[0]].it = std::move(head);
+                replay();
+            }
+
+            // Marks the winning source as exhausted
+            auto pop_top()
+                -> void
+            {
+                heads_[nodes_[0]].exhausted = true;
+                replay();
+            }
+
+        private:
+
+            struct source_head
+            {
+                Iterator it {};
+                bool exhausted = true;
+            };
+
+            // Replays the matches of the winning source up to the root
+            auto replay()
+                -> void
+            {
+                auto winner = nodes_[0];
+                for (auto node = (winner + nb_sources_) / 2; node > 0; node /= 2) {
+                    if (beats(nodes_[node], winner)) {
+                        std::swap(nodes_[node], winner);
+                    }
+                }
+                nodes_[0] = winner;
+            }
+
+            // Whether the source lhs wins the match against rhs
+            auto beats(std::size_t lhs, std::size_t rhs)
+                -> bool
+            {
+                const source_head& lhs_head = heads_[lhs];
+                const source_head& rhs_head = heads_[rhs];
+                if (rhs_head.exhausted) {
+                    return not lhs_head.exhausted || lhs < rhs;
+                }
+                if (lhs_head.exhausted) {
+                    return false;
+                }
+
+                auto&& comp = utility::as_function(data_.first);
+                auto&& proj = utility::as_function(data_.second);
+                // Only compare the other way around to give the priority
+                // to the smallest index among equivalent heads, branching
+                // on the indices first makes the merge noticeably slower
+                return comp(proj(*lhs_head.it), proj(*rhs_head.it)) ||
+                       (lhs < rhs && not comp(proj(*rhs_head.it), proj(*lhs_head.it)));
+            }
+
+            // Plays the matches of a subtree and returns its winner,
+            // leaves are the nodes [k, 2k)
+            auto build_subtree(std::size_t node)
+                -> std::size_t
+            {
+                if (node >= nb_sources_) {
+                    return node - nb_sources_;
+                }
+                auto left = build_subtree(2 * node);
+                auto right = build_subtree(2 * node + 1);
+                if (beats(left, right)) {
+                    nodes_[node] = right;
+                    return left;
+                }
+                nodes_[node] = left;
+                return right;
+            }
+
+            std::size_t nb_sources_;
+            std::vector<source_head> heads_;
+            // nodes_[0] holds the overall winner
+            std::vector<std::size_t> nodes_;
+            std::pair<Compare, Projection> data_;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_LOSER_TREE_H_
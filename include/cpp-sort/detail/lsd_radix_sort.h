@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+#define CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "move.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Least significant digit radix sort: the elements are sorted
+    // according to an unsigned integer key split into digits of
+    // DigitBits bits, with one stable counting sort per digit from
+    // the least significant to the most significant one. The
+    // elements go back and forth between the collection and a
+    // buffer big enough to hold all of them.
+    //
+    // The histograms of all the digits are computed in a single
+    // read pass over the collection before the first scatter, which
+    // also allows to skip the digits for which all the keys have
+    // the same value.
+
+    template<bool Construct>
+    struct lsd_radix_writer;
+
+    template<>
+    struct lsd_radix_writer<true>
+    {
+        // Writes to the uninitialized buffer
+        template<typename T, typename U>
+        static auto write(T* ptr, U&& value)
+            -> void
+        {
+            ::new(static_cast<void*>(ptr)) T(std::forward<U>(value));
+        }
+    };
+
+    template<>
+    struct lsd_radix_writer<false>
+    {
+        template<typename Iterator, typename U>
+        static auto write(Iterator it, U&& value)
+            -> void
+        {
+            *it = std::forward<U>(value);
+        }
+    };
+
+    template<typename Iterator>
+    auto prefetch_write(Iterator it, std::true_type /* lvalue reference */) noexcept
+        -> void
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(std::addressof(*it), 1);
+#else
+        (void) it;
+#endif
+    }
+
+    template<typename Iterator>
+    auto prefetch_write(Iterator, std::false_type /* lvalue reference */) noexcept
+        -> void
+    {}
+
+    template<
+        bool Construct,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename KeyFunction,
+        typename Key
+    >
+    auto lsd_radix_scatter(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                           RandomAccessIterator2 out, std::size_t* offsets,
+                           int shift, Key mask,
+                           KeyFunction& key)
+        -> void
+    {
+        using utility::iter_move;
+        using can_prefetch = std::is_lvalue_reference<reference_t<RandomAccessIterator2>>;
+
+        // The destination of the element a few iterations ahead
+        // is prefetched, which hides the latency of the scattered
+        // writes when the buckets don't fit in the cache
+        constexpr difference_type_t<RandomAccessIterator1> prefetch_distance = 16;
+        auto prefetch_last = last - std::min(last - first, prefetch_distance);
+
+        for (; first != prefetch_last ; ++first) {
+            auto next = static_cast<std::size_t>((key(first[prefetch_distance]) >> shift) & mask);
+            prefetch_write(out + offsets[next], can_prefetch{});
+            auto digit = static_cast<std::size_t>((key(*first) >> shift) & mask);
+            lsd_radix_writer<Construct>::write(out + offsets[digit], iter_move(first));
+            ++offsets[digit];
+        }
+        for (; first != last ; ++first) {
+            auto digit = static_cast<std::size_t>((key(*first) >> shift) & mask);
+            lsd_radix_writer<Construct>::write(out + offsets[digit], iter_move(first));
+            ++offsets[digit];
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Scatter with software write-combining: the elements are
+    // first copied to a small staging area per bucket, and each
+    // area is written to its destination when it is full, which
+    // writes whole cache lines instead of scattering individual
+    // elements across lots of different memory pages. It is only
+    // used for small trivial types.
+
+    template<typename T>
+    constexpr auto lsd_radix_wc_size() noexcept
+        -> std::size_t
+    {
+        return 64 / sizeof(T);
+    }
+
+    template<typename T>
+    using can_lsd_radix_write_combine = std::integral_constant<bool,
+        std::is_trivial<T>::value && lsd_radix_wc_size<T>() >= 4
+    >;
+
+    template<
+        bool Construct,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename KeyFunction,
+        typename Key
+    >
+    auto lsd_radix_scatter_wc(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                              RandomAccessIterator2 out, std::size_t* offsets,
+                              int shift, Key mask,
+                              KeyFunction& key,
+                              value_type_t<RandomAccessIterator1>* staging, unsigned char* fill,
+                              std::size_t radix)
+        -> void
+    {
+        using can_prefetch = std::is_lvalue_reference<reference_t<RandomAccessIterator2>>;
+        constexpr std::size_t wc_size = lsd_radix_wc_size<value_type_t<RandomAccessIterator1>>();
+        auto size = static_cast<std::size_t>(last - first);
+
+        for (; first != last ; ++first) {
+            auto digit = static_cast<std::size_t>((key(*first) >> shift) & mask);
+            auto bucket = staging + digit * wc_size;
+            std::size_t count = fill[digit];
+            bucket[count] = *first;
+            if (++count == wc_size) {
+                auto dest = offsets[digit];
+                for (std::size_t idx = 0 ; idx < wc_size ; ++idx) {
+                    lsd_radix_writer<Construct>::write(out + (dest + idx), bucket[idx]);
+                }
+                dest += wc_size;
+                offsets[digit] = dest;
+                count = 0;
+                if (dest + wc_size < size) {
+                    prefetch_write(out + (dest + wc_size), can_prefetch{});
+                }
+            }
+            fill[digit] = static_cast<unsigned char>(count);
+        }
+
+        // Flush the partially filled staging areas
+        for (std::size_t digit = 0 ; digit < radix ; ++digit) {
+            auto dest = out + offsets[digit];
+            for (std::size_t idx = 0 ; idx < fill[digit] ; ++idx) {
+                lsd_radix_writer<Construct>::write(dest + idx, staging[digit * wc_size + idx]);
+            }
+            offsets[digit] += fill[digit];
+            fill[digit] = 0;
+        }
+    }
+
+    template<
+        bool Construct,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename KeyFunction,
+        typename Key,
+        typename T
+    >
+    auto lsd_radix_scatter_dispatch(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                    RandomAccessIterator2 out, std::size_t* offsets,
+                                    int shift, Key mask,
+                                    KeyFunction& key, T*, unsigned char*, std::size_t,
+                                    std::false_type /* write-combine */)
+        -> void
+    {
+        lsd_radix_scatter<Construct>(std::move(first), std::move(last), std::move(out),
+                                     offsets, shift, mask, key);
+    }
+
+    template<
+        bool Construct,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename KeyFunction,
+        typename Key,
+        typename T
+    >
+    auto lsd_radix_scatter_dispatch(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                    RandomAccessIterator2 out, std::size_t* offsets,
+                                    int shift, Key mask,
+                                    KeyFunction& key,
+                                    T* staging, unsigned char* fill, std::size_t radix,
+                                    std::true_type /* write-combine */)
+        -> void
+    {
+        lsd_radix_scatter_wc<Construct>(std::move(first), std::move(last), std::move(out),
+                                        offsets, shift, mask, key, staging, fill, radix);
+    }
+
+    template<typename T>
+    auto make_lsd_radix_staging(std::size_t radix, std::true_type /* can write-combine */)
+        -> std::pair<std::unique_ptr<T[]>, std::unique_ptr<unsigned char[]>>
+    {
+        return {
+            std::unique_ptr<T[]>(new T[radix * lsd_radix_wc_size<T>()]),
+            std::unique_ptr<unsigned char[]>(new unsigned char[radix]())
+        };
+    }
+
+    template<typename T>
+    auto make_lsd_radix_staging(std::size_t, std::false_type /* can write-combine */)
+        -> std::pair<std::unique_ptr<T[]>, std::unique_ptr<unsigned char[]>>
+    {
+        return {};
+    }
+
+    template<
+        int DigitBits,
+        bool WriteCombine = false,
+        typename RandomAccessIterator,
+        typename KeyFunction
+    >
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        value_type_t<RandomAccessIterator>* buffer,
+                        KeyFunction key)
+        -> void
+    {
+        using value_type = value_type_t<RandomAccessIterator>;
+        using key_type = remove_cvref_t<decltype(key(*first))>;
+        static_assert(detail::is_unsigned<key_type>::value,
+                      "lsd_radix_sort requires unsigned integer keys");
+
+        constexpr int key_bits = sizeof(key_type) * CHAR_BIT;
+        constexpr int nb_digits = (key_bits + DigitBits - 1) / DigitBits;
+        constexpr std::size_t radix = std::size_t(1) << DigitBits;
+        constexpr auto mask = static_cast<key_type>(radix - 1);
+
+        auto size = last - first;
+        if (size < 2) return;
+
+        // Compute the histograms of every digit at once
+        std::vector<std::size_t> histograms(nb_digits * radix);
+        for (auto it = first ; it != last ; ++it) {
+            key_type value = key(*it);
+            for (int digit = 0 ; digit < nb_digits ; ++digit) {
+                ++histograms[digit * radix + ((value >> (digit * DigitBits)) & mask)];
+            }
+        }
+
+        // Only keep the digits that don't have the same value for
+        // all of the keys, and turn their histograms into offsets
+        int digits[nb_digits];
+        int nb_passes = 0;
+        key_type first_key = key(*first);
+        for (int digit = 0 ; digit < nb_digits ; ++digit) {
+            auto counts = histograms.data() + digit * radix;
+            if (counts[(first_key >> (digit * DigitBits)) & mask] == static_cast<std::size_t>(size)) {
+                continue;
+            }
+            digits[nb_passes++] = digit;
+            std::size_t sum = 0;
+            for (std::size_t idx = 0 ; idx < radix ; ++idx) {
+                auto count = counts[idx];
+                counts[idx] = sum;
+                sum += count;
+            }
+        }
+        if (nb_passes == 0) return;
+
+        using can_write_combine = std::integral_constant<bool,
+            WriteCombine && can_lsd_radix_write_combine<value_type>::value
+        >;
+        auto staging = make_lsd_radix_staging<value_type>(radix, can_write_combine{});
+
+        // Trivially copyable elements are directly scattered to the
+        // buffer during the first pass, other elements are moved to
+        // it first so that they can be destroyed properly afterwards
+        bool in_buffer = false;
+        destruct_n<value_type> destroyer(0);
+        std::unique_ptr<value_type, destruct_n<value_type>&> guard(buffer, destroyer);
+        if (not std::is_trivially_copyable<value_type>::value) {
+            uninitialized_move(first, last, buffer, destroyer);
+            in_buffer = true;
+        }
+
+        // Counting sort for every remaining digit, alternating
+        // between the collection and the buffer
+        for (int pass = 0 ; pass < nb_passes ; ++pass) {
+            auto offsets = histograms.data() + digits[pass] * radix;
+            int shift = digits[pass] * DigitBits;
+            if (in_buffer) {
+                lsd_radix_scatter_dispatch<false>(buffer, buffer + size, first, offsets, shift, mask, key,
+                                                  staging.first.get(), staging.second.get(), radix,
+                                                  can_write_combine{});
+            } else if (pass == 0) {
+                lsd_radix_scatter_dispatch<true>(first, last, buffer, offsets, shift, mask, key,
+                                                 staging.first.get(), staging.second.get(), radix,
+                                                 can_write_combine{});
+            } else {
+                lsd_radix_scatter_dispatch<false>(first, last, buffer, offsets, shift, mask, key,
+                                                  staging.first.get(), staging.second.get(), radix,
+                                                  can_write_combine{});
+            }
+            in_buffer = not in_buffer;
+        }
+        if (in_buffer) {
+            detail::move(buffer, buffer + size, first);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // LSD radix sort with a digit size suitable for the size of
+    // the collection: small digits are preferred for small
+    // collections, where the cost of clearing and scanning the
+    // histograms matters the most, while bigger digits reduce the
+    // number of passes over big collections. 16-bit digits sort
+    // 32-bit keys in two passes, but make the passes over wider
+    // keys too slow: those rather use write-combining, which only
+    // pays off when the collection is much bigger than the cache.
+
+    template<typename RandomAccessIterator, typename KeyFunction>
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        value_type_t<RandomAccessIterator>* buffer,
+                        KeyFunction key)
+        -> void
+    {
+        using key_type = remove_cvref_t<decltype(key(*first))>;
+        constexpr bool small_key = sizeof(key_type) <= 4;
+
+        auto size = last - first;
+        if (size < (small_key ? 1 << 18 : 1 << 16)) {
+            lsd_radix_sort<8>(std::move(first), std::move(last), buffer, std::move(key));
+        } else if (size < (1 << 22)) {
+            lsd_radix_sort<11>(std::move(first), std::move(last), buffer, std::move(key));
+        } else if (small_key) {
+            lsd_radix_sort<16>(std::move(first), std::move(last), buffer, std::move(key));
+        } else {
+            lsd_radix_sort<11, true>(std::move(first), std::move(last), buffer, std::move(key));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Runs an LSD radix sort if the collection is big enough for
+    // it to be worth it, returns whether the collection was sorted.
+    // The elements are moved to a raw buffer, which is why they
+    // need to be trivially copyable.
+
+    template<typename Key>
+    constexpr auto lsd_radix_sort_threshold() noexcept
+        -> std::ptrdiff_t
+    {
+        return sizeof(Key) <= 4 ? 1 << 10 : 1 << 13;
+    }
+
+    template<typename RandomAccessIterator, typename KeyFunction>
+    auto try_lsd_radix_sort(RandomAccessIterator, RandomAccessIterator,
+                            KeyFunction, std::false_type /* trivially copyable */)
+        -> bool
+    {
+        return false;
+    }
+
+    template<typename RandomAccessIterator, typename KeyFunction>
+    auto try_lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            KeyFunction key, std::true_type /* trivially copyable */)
+        -> bool
+    {
+        using key_type = remove_cvref_t<decltype(key(*first))>;
+
+        auto size = last - first;
+        if (size < lsd_radix_sort_threshold<key_type>()) {
+            return false;
+        }
+        temporary_buffer<value_type_t<RandomAccessIterator>> buffer(size);
+        if (buffer.size() < size) {
+            return false;
+        }
+        lsd_radix_sort(std::move(first), std::move(last), buffer.data(), std::move(key));
+        return true;
+    }
+
+    template<typename RandomAccessIterator, typename KeyFunction>
+    auto try_lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            KeyFunction key)
+        -> bool
+    {
+        using is_trivially_copyable = std::is_trivially_copyable<value_type_t<RandomAccessIterator>>;
+        return try_lsd_radix_sort(std::move(first), std::move(last), std::move(key),
+                                  std::integral_constant<bool, is_trivially_copyable::value>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LSD_RADIX_SORT_H_
@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////
 #include <cmath>
 #include <iterator>
+#include <utility>
 #include <vector>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/utility/as_function.h>
@@ -19,6 +20,7 @@
 #include "lower_bound.h"
 #include "merge_move.h"
 #include "move.h"
+#include "multiway_merge.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -76,39 +78,25 @@ namespace detail
             }), lists.end());
         }
 
-        // Merge lists pairwise, picking a list from each half
-        // of the collection instead of adjacent ones
-        while (lists.size() > 2) {
-            if (lists.size() % 2 != 0) {
-                auto last_it = std::prev(lists.end());
-                auto last_1_it = std::prev(last_it);
-                last_1_it->merge(*last_it, compare, projection);
-                lists.pop_back();
-            }
-
-            auto first_it = lists.begin();
-            auto half_it = first_it + lists.size() / 2;
-            while (half_it != lists.end()) {
-                first_it->merge(*half_it, compare, projection);
-                ++first_it;
-                ++half_it;
-            }
-
-            lists.erase(lists.begin() + lists.size() / 2, lists.end());
-        }
-
         // If the edges were split into a single sorted list,
         // add it back to the collection of encroaching lists
         if (extract_edges) {
-            if (lists.empty()) {
-                lists.push_back(std::move(edges));
-            } else {
-                lists.back().merge_unsafe(edges, compare, projection);
-            }
+            lists.push_back(std::move(edges));
         }
 
-        // Merge remaining list(s) back into the original collection
-        if (lists.size() == 2) {
+        // Merge the lists back into the original collection
+        if (lists.size() > 2) {
+            // Merge all the lists in a single pass instead of
+            // merging them pairwise, which would walk through
+            // every node log2(k) times
+            using list_iterator = typename fixed_size_list<NodeType>::iterator;
+            std::vector<std::pair<list_iterator, list_iterator>> runs;
+            runs.reserve(lists.size());
+            for (auto& list: lists) {
+                runs.emplace_back(list.begin(), list.end());
+            }
+            detail::multiway_merge<true>(runs, first, std::move(compare), std::move(projection));
+        } else if (lists.size() == 2) {
             detail::merge_move(
                 lists.front().begin(), lists.front().end(),
                 lists.back().begin(), lists.back().end(),
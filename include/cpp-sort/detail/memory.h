@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2022 Morwenn
+ * Copyright (c) 2016-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 
@@ -23,6 +23,7 @@
 #include <new>
 #include <type_traits>
 #include <utility>
+#include "scope_exit.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -61,35 +62,232 @@ namespace detail
     }
 
     ////////////////////////////////////////////////////////////
-    // Deleter for ::operator new(std::size_t)
+    // Scratch memory
+    //
+    // The algorithms of the library get their temporary memory
+    // through allocate_scratch and deallocate_scratch: these call
+    // ::operator new and ::operator delete unless another memory
+    // source was installed for the current thread, in which case
+    // the memory comes from that source instead
+
+    class scratch_memory_source
+    {
+        public:
 
-    struct operator_deleter
+            virtual ~scratch_memory_source() = default;
+
+            // Returns a block of at least bytes bytes aligned for any
+            // fundamental type, or throws on failure
+            virtual auto allocate(std::size_t bytes)
+                -> void* = 0;
+
+            virtual auto deallocate(void* ptr, std::size_t bytes) noexcept
+                -> void = 0;
+    };
+
+    inline auto current_scratch_memory_source() noexcept
+        -> scratch_memory_source*&
     {
-        operator_deleter() = default;
+        static thread_local scratch_memory_source* source = nullptr;
+        return source;
+    }
+
+    // When non-null, the number of bytes successfully allocated
+    // with allocate_scratch is added to the pointed counter
+    inline auto current_scratch_memory_counter() noexcept
+        -> std::size_t*&
+    {
+        static thread_local std::size_t* counter = nullptr;
+        return counter;
+    }
+
+    template<typename Function>
+    auto with_scratch_memory_source(scratch_memory_source* source, Function&& func)
+        -> decltype(std::forward<Function>(func)())
+    {
+        auto& current_source = current_scratch_memory_source();
+        auto previous_source = std::exchange(current_source, source);
+        auto restore_source = make_scope_exit([&] {
+            current_source = previous_source;
+        });
+        return std::forward<Function>(func)();
+    }
+
+    inline auto allocate_scratch(std::size_t bytes, scratch_memory_source* source)
+        -> void*
+    {
+        void* ptr = source ? source->allocate(bytes) : ::operator new(bytes);
+        if (auto counter = current_scratch_memory_counter()) {
+            *counter += bytes;
+        }
+        return ptr;
+    }
+
+    inline auto allocate_scratch(std::size_t bytes)
+        -> void*
+    {
+        return allocate_scratch(bytes, current_scratch_memory_source());
+    }
+
+    inline auto allocate_scratch(std::size_t bytes, const std::nothrow_t&) noexcept
+        -> void*
+    {
+        void* ptr = nullptr;
+        if (auto source = current_scratch_memory_source()) {
+            try {
+                ptr = source->allocate(bytes);
+            } catch (...) {
+                return nullptr;
+            }
+        } else {
+            ptr = ::operator new(bytes, std::nothrow);
+        }
+        if (ptr) {
+            if (auto counter = current_scratch_memory_counter()) {
+                *counter += bytes;
+            }
+        }
+        return ptr;
+    }
 
+    // The source has to be the one that was current when the
+    // memory was allocated, which isn't necessarily still the
+    // case when it is released
+    inline auto deallocate_scratch(void* ptr, std::size_t bytes,
+                                   scratch_memory_source* source) noexcept
+        -> void
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (source) {
+            source->deallocate(ptr, bytes);
+            return;
+        }
 #ifdef __cpp_sized_deallocation
+        ::operator delete(ptr, bytes);
+#else
+        (void)bytes;
+        ::operator delete(ptr);
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Deleter for memory returned by allocate_scratch
+
+    struct operator_deleter
+    {
         std::size_t size = 0;
+        scratch_memory_source* source = nullptr;
+
+        operator_deleter() = default;
 
-        constexpr explicit operator_deleter(std::size_t size) noexcept:
-            size(size)
+        explicit operator_deleter(std::size_t size) noexcept:
+            size(size),
+            source(current_scratch_memory_source())
         {}
 
         inline auto operator()(void* pointer) const noexcept
             -> void
         {
-            ::operator delete(pointer, size);
+            deallocate_scratch(pointer, size, source);
         }
-#else
-        constexpr explicit operator_deleter(std::size_t) noexcept {}
+    };
 
-        inline auto operator()(void* pointer) const noexcept
+    ////////////////////////////////////////////////////////////
+    // Array of value-initialized objects in scratch memory
+
+    template<typename T>
+    struct scratch_array_deleter
+    {
+        std::size_t size = 0;
+        scratch_memory_source* source = nullptr;
+
+        scratch_array_deleter() = default;
+
+        explicit scratch_array_deleter(std::size_t size) noexcept:
+            size(size),
+            source(current_scratch_memory_source())
+        {}
+
+        auto operator()(T* pointer) const noexcept
             -> void
         {
-            ::operator delete(pointer);
+            detail::destroy_n(pointer, size);
+            deallocate_scratch(pointer, size * sizeof(T), source);
         }
-#endif
     };
 
+    template<typename T>
+    auto make_scratch_array(std::size_t size)
+        -> std::unique_ptr<T, scratch_array_deleter<T>>
+    {
+        std::unique_ptr<void, operator_deleter> memory(
+            allocate_scratch(size * sizeof(T)),
+            operator_deleter(size * sizeof(T))
+        );
+        T* ptr = static_cast<T*>(memory.get());
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < size; ++constructed) {
+                ::new(ptr + constructed) T();
+            }
+        } catch (...) {
+            detail::destroy_n(ptr, constructed);
+            throw;
+        }
+        memory.release();
+        return std::unique_ptr<T, scratch_array_deleter<T>>(
+            ptr, scratch_array_deleter<T>(size)
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Standard allocator drawing from the scratch memory source
+    // that was current when it was constructed, for the standard
+    // containers used by the algorithms
+
+    template<typename T>
+    struct scratch_allocator
+    {
+        using value_type = T;
+
+        scratch_memory_source* source = current_scratch_memory_source();
+
+        scratch_allocator() = default;
+
+        template<typename U>
+        scratch_allocator(const scratch_allocator<U>& other) noexcept:
+            source(other.source)
+        {}
+
+        auto allocate(std::size_t n)
+            -> T*
+        {
+            return static_cast<T*>(allocate_scratch(n * sizeof(T), source));
+        }
+
+        auto deallocate(T* ptr, std::size_t n) noexcept
+            -> void
+        {
+            deallocate_scratch(ptr, n * sizeof(T), source);
+        }
+    };
+
+    template<typename T, typename U>
+    auto operator==(const scratch_allocator<T>& lhs, const scratch_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.source == rhs.source;
+    }
+
+    template<typename T, typename U>
+    auto operator!=(const scratch_allocator<T>& lhs, const scratch_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return lhs.source != rhs.source;
+    }
+
     ////////////////////////////////////////////////////////////
     // Deleter for placement new-allocated memory
 
@@ -165,7 +363,7 @@ namespace detail
         // Try to gradually allocate less memory until we get a valid buffer
         // or until the amount of memory to allocate reaches 0
         while (count > min_count) {
-            res.first = static_cast<T*>(::operator new(count * sizeof(T), std::nothrow));
+            res.first = static_cast<T*>(allocate_scratch(count * sizeof(T), std::nothrow));
             if (res.first) {
                 res.second = count;
                 break;
@@ -176,15 +374,11 @@ namespace detail
     }
 
     template<typename T>
-    auto return_temporary_buffer(T* ptr, std::size_t count) noexcept
+    auto return_temporary_buffer(T* ptr, std::size_t count,
+                                 scratch_memory_source* source) noexcept
         -> void
     {
-#ifdef __cpp_sized_deallocation
-        ::operator delete(ptr, count * sizeof(T));
-#else
-        (void)count;
-        ::operator delete(ptr);
-#endif
+        deallocate_scratch(ptr, count * sizeof(T), source);
     }
 
     ////////////////////////////////////////////////////////////
@@ -209,7 +403,8 @@ namespace detail
 
             temporary_buffer(temporary_buffer&& other) noexcept:
                 buffer(other.buffer),
-                buffer_size(other.buffer_size)
+                buffer_size(other.buffer_size),
+                source(other.source)
             {
                 other.buffer = nullptr;
                 other.buffer_size = 0;
@@ -217,7 +412,8 @@ namespace detail
 
             constexpr temporary_buffer(std::nullptr_t) noexcept {}
 
-            explicit temporary_buffer(std::ptrdiff_t count) noexcept
+            explicit temporary_buffer(std::ptrdiff_t count) noexcept:
+                source(current_scratch_memory_source())
             {
                 auto tmp = get_temporary_buffer<T>(count, 0);
                 buffer = tmp.first;
@@ -226,7 +422,7 @@ namespace detail
 
             ~temporary_buffer() noexcept
             {
-                return_temporary_buffer<T>(buffer, buffer_size);
+                return_temporary_buffer<T>(buffer, buffer_size, source);
             }
 
             ////////////////////////////////////////////////////////////
@@ -240,6 +436,7 @@ namespace detail
                 using std::swap;
                 swap(buffer, other.buffer);
                 swap(buffer_size, other.buffer_size);
+                swap(source, other.source);
                 return *this;
             }
 
@@ -270,9 +467,10 @@ namespace detail
                     return false;
                 }
                 // If the allocated buffer is big enough, replace the previous one
-                return_temporary_buffer(buffer, buffer_size);
+                return_temporary_buffer(buffer, buffer_size, source);
                 buffer = tmp.first;
                 buffer_size = tmp.second;
+                source = current_scratch_memory_source();
                 return true;
             }
 
@@ -280,6 +478,7 @@ namespace detail
 
             T* buffer = nullptr;
             std::ptrdiff_t buffer_size = 0;
+            scratch_memory_source* source = nullptr;
     };
 }}
 
@@ -8,9 +8,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "branchless_merge.h"
 #include "config.h"
 #include "is_sorted_until.h"
 #include "move.h"
@@ -24,25 +26,15 @@ namespace detail
     auto merge_move(InputIterator1 first1, InputIterator1 last1,
                     InputIterator2 first2, InputIterator2 last2,
                     OutputIterator result, Compare compare,
-                    Projection1 projection1, Projection2 projection2)
+                    Projection1 projection1, Projection2 projection2,
+                    std::false_type /* branchless */)
         -> OutputIterator
     {
-        CPPSORT_AUDIT(detail::is_sorted(first1, last1, compare, projection1));
-        CPPSORT_AUDIT(detail::is_sorted(first2, last2, compare, projection2));
-
         using utility::iter_move;
         auto&& comp = utility::as_function(compare);
         auto&& proj1 = utility::as_function(projection1);
         auto&& proj2 = utility::as_function(projection2);
 
-        if (first1 == last1) {
-            return detail::move(first2, last2, result);
-        }
-
-        if (first2 == last2) {
-            return detail::move(first1, last1, result);
-        }
-
         while (true) {
             CPPSORT_ASSUME(first1 != last1);
             CPPSORT_ASSUME(first2 != last2);
@@ -63,6 +55,51 @@ namespace detail
             ++result;
         }
     }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_move(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                    RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                    OutputIterator result, Compare compare,
+                    Projection1 projection1, Projection2 projection2,
+                    std::true_type /* branchless */)
+        -> OutputIterator
+    {
+        return branchless_merge_move(std::move(first1), std::move(last1),
+                                     std::move(first2), std::move(last2),
+                                     std::move(result), std::move(compare),
+                                     std::move(projection1), std::move(projection2));
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_move(InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2, InputIterator2 last2,
+                    OutputIterator result, Compare compare,
+                    Projection1 projection1, Projection2 projection2)
+        -> OutputIterator
+    {
+        CPPSORT_AUDIT(detail::is_sorted(first1, last1, compare, projection1));
+        CPPSORT_AUDIT(detail::is_sorted(first2, last2, compare, projection2));
+
+        if (first1 == last1) {
+            return detail::move(first2, last2, result);
+        }
+
+        if (first2 == last2) {
+            return detail::move(first1, last1, result);
+        }
+
+        using is_branchless = is_branchless_merge<
+            InputIterator1, InputIterator2,
+            Compare, Projection1, Projection2
+        >;
+        return merge_move(std::move(first1), std::move(last1),
+                          std::move(first2), std::move(last2),
+                          std::move(result), std::move(compare),
+                          std::move(projection1), std::move(projection2),
+                          std::integral_constant<bool, is_branchless::value>{});
+    }
 }}
 
 #endif // CPPSORT_DETAIL_MERGE_MOVE_H_
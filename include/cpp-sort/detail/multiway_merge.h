@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_MULTIWAY_MERGE_H_
+#define CPPSORT_DETAIL_MULTIWAY_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/iter_move.h>
+#include "loser_tree.h"
+#include "move.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace multiway_merge_detail
+    {
+        template<typename InputIterator, typename OutputIterator>
+        auto transfer_one(std::false_type, InputIterator it, OutputIterator& out)
+            -> void
+        {
+            *out = *it;
+        }
+
+        template<typename InputIterator, typename OutputIterator>
+        auto transfer_one(std::true_type, InputIterator it, OutputIterator& out)
+            -> void
+        {
+            using utility::iter_move;
+            *out = iter_move(it);
+        }
+
+        template<typename InputIterator, typename OutputIterator>
+        auto transfer(std::false_type, InputIterator first, InputIterator last, OutputIterator out)
+            -> OutputIterator
+        {
+            return std::copy(std::move(first), std::move(last), std::move(out));
+        }
+
+        template<typename InputIterator, typename OutputIterator>
+        auto transfer(std::true_type, InputIterator first, InputIterator last, OutputIterator out)
+            -> OutputIterator
+        {
+            return detail::move(std::move(first), std::move(last), std::move(out));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merges k sorted runs [first, last) into out in a single
+    // pass with a loser tree, which takes log2(k) comparisons
+    // per element. Elements are moved out of the runs when Move
+    // is true and copied otherwise. The merge is stable: among
+    // equivalent elements, those of the earliest run come first.
+
+    template<
+        bool Move,
+        typename ForwardIterator,
+        typename OutputIterator,
+        typename Compare,
+        typename Projection
+    >
+    auto multiway_merge(const std::vector<std::pair<ForwardIterator, ForwardIterator>>& runs,
+                        OutputIterator out, Compare compare, Projection projection)
+        -> OutputIterator
+    {
+        using multiway_merge_detail::transfer;
+        using multiway_merge_detail::transfer_one;
+        using move_t = std::integral_constant<bool, Move>;
+
+        std::vector<ForwardIterator> ends;
+        ends.reserve(runs.size());
+        loser_tree<ForwardIterator, Compare, Projection> tree(
+            runs.size(), std::move(compare), std::move(projection)
+        );
+
+        std::size_t nb_live_runs = 0;
+        for (std::size_t idx = 0 ; idx < runs.size() ; ++idx) {
+            ends.push_back(runs[idx].second);
+            if (runs[idx].first != runs[idx].second) {
+                tree.set_head(idx, runs[idx].first);
+                ++nb_live_runs;
+            }
+        }
+        tree.build();
+
+        while (nb_live_runs > 1) {
+            auto run = tree.winner();
+            auto it = tree.top_iterator();
+            transfer_one(move_t{}, it, out);
+            ++out;
+            if (++it == ends[run]) {
+                tree.pop_top();
+                --nb_live_runs;
+            } else {
+                tree.replace_top(std::move(it));
+            }
+        }
+
+        // Exhausted runs always lose, only the last one is left
+        if (nb_live_runs == 1) {
+            out = transfer(move_t{}, tree.top_iterator(), ends[tree.winner()], std::move(out));
+        }
+        return out;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_MULTIWAY_MERGE_H_
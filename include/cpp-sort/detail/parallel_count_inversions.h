@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
+#define CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "count_inversions.h"
+#include "move.h"
+#include "parallel_merge_sort.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_count_inversions_detail
+    {
+        // Co-ranking: returns how many elements of [first1, first1 + len1)
+        // appear among the first diag elements of the stable merge of
+        // [first1, first1 + len1) and [first2, first2 + len2); elements
+        // of the first range come first when elements compare equivalent
+        template<typename RandomAccessIterator1, typename RandomAccessIterator2,
+                 typename Compare, typename Projection>
+        auto co_rank(RandomAccessIterator1 first1, std::ptrdiff_t len1,
+                     RandomAccessIterator2 first2, std::ptrdiff_t len2,
+                     std::ptrdiff_t diag, Compare compare, Projection projection)
+            -> std::ptrdiff_t
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto lo = (std::max)(std::ptrdiff_t(0), diag - len2);
+            auto hi = (std::min)(diag, len1);
+            while (lo < hi) {
+                auto mid = lo + (hi - lo) / 2;
+                // first1[mid] is not part of the prefix iff the element of the
+                // second range it competes with is strictly smaller
+                if (comp(proj(first2[diag - mid - 1]), proj(first1[mid]))) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        // Merges the slice [diag, diag_end) of the merge of two sorted
+        // runs and returns the number of inversions between elements of
+        // the second run written to the slice and elements of the first
+        // run: every element of the second run that is merged before
+        // the element i of the first run is inverted with the elements
+        // [i, len1) of the first run
+        template<
+            typename ResultType,
+            typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Compare,
+            typename Projection
+        >
+        auto count_inversions_slice(RandomAccessIterator1 first1, std::ptrdiff_t len1,
+                                    RandomAccessIterator1 first2, std::ptrdiff_t len2,
+                                    std::ptrdiff_t diag, std::ptrdiff_t diag_end,
+                                    RandomAccessIterator2 out,
+                                    Compare compare, Projection projection)
+            -> ResultType
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto i = co_rank(first1, len1, first2, len2, diag, compare, projection);
+            auto i_end = co_rank(first1, len1, first2, len2, diag_end, compare, projection);
+            auto j = diag - i;
+            auto j_end = diag_end - i_end;
+            out += diag;
+
+            ResultType inversions = 0;
+            while (i != i_end && j != j_end) {
+                if (comp(proj(first2[j]), proj(first1[i]))) {
+                    *out = iter_move(first2 + j);
+                    ++j;
+                    inversions += len1 - i;
+                } else {
+                    *out = iter_move(first1 + i);
+                    ++i;
+                }
+                ++out;
+            }
+            // Elements left in the second run come before first1[i_end]
+            inversions += (j_end - j) * (len1 - i);
+            out = detail::move(first1 + i, first1 + i_end, out);
+            detail::move(first2 + j, first2 + j_end, out);
+            return inversions;
+        }
+
+        // Merge every pair of adjacent sorted runs of size run_size from
+        // source into destination and count the inversions between them
+        template<
+            typename ResultType,
+            typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Compare,
+            typename Projection
+        >
+        auto count_inversions_round(RandomAccessIterator1 source, RandomAccessIterator2 destination,
+                                    std::ptrdiff_t size, std::ptrdiff_t run_size,
+                                    std::ptrdiff_t slice_size,
+                                    Compare compare, Projection projection,
+                                    work_stealing_pool& pool)
+            -> ResultType
+        {
+            std::atomic<ResultType> inversions(0);
+            for (std::ptrdiff_t start = 0 ; start < size ; start += 2 * run_size) {
+                auto len1 = (std::min)(run_size, size - start);
+                auto len2 = (std::min)(run_size, size - start - len1);
+                auto first1 = source + start;
+                auto first2 = first1 + len1;
+                auto out = destination + start;
+
+                for (std::ptrdiff_t diag = 0 ; diag < len1 + len2 ; diag += slice_size) {
+                    auto diag_end = (std::min)(diag + slice_size, len1 + len2);
+                    pool.submit([=, &inversions] {
+                        inversions += count_inversions_slice<ResultType>(
+                            first1, len1, first2, len2, diag, diag_end, out,
+                            compare, projection
+                        );
+                    });
+                }
+            }
+            pool.wait();
+            return inversions.load();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel version of count_inversions: chunks of the
+    // collection are sorted and their inversions counted
+    // independently, then the cross inversions are counted
+    // while merging the sorted chunks pairwise, every merge
+    // being split into slices with co-ranking. The collection
+    // and the cache, which needs to be as big as the collection,
+    // are left in an unspecified order.
+
+    template<
+        typename ResultType,
+        typename RandomAccessIterator1,
+        typename RandomAccessIterator2,
+        typename Compare,
+        typename Projection
+    >
+    auto parallel_count_inversions(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                   RandomAccessIterator2 cache,
+                                   Compare compare, Projection projection,
+                                   std::size_t nb_threads=default_thread_count())
+        -> ResultType
+    {
+        using namespace parallel_count_inversions_detail;
+        using parallel_merge_sort_detail::parallel_threshold;
+        using parallel_merge_sort_detail::min_merge_slice;
+
+        std::ptrdiff_t size = last - first;
+        if (nb_threads < 2 || size < parallel_threshold) {
+            return count_inversions<ResultType>(std::move(first), std::move(last),
+                                                std::move(cache),
+                                                std::move(compare), std::move(projection));
+        }
+
+        // Power of 2 of chunks, at least one per thread
+        std::ptrdiff_t nb_runs = 2;
+        int nb_rounds = 1;
+        while (nb_runs < static_cast<std::ptrdiff_t>(nb_threads) && nb_runs * 2 <= size) {
+            nb_runs *= 2;
+            ++nb_rounds;
+        }
+        std::ptrdiff_t run_size = (size + nb_runs - 1) / nb_runs;
+
+        auto nb_slices = 4 * static_cast<std::ptrdiff_t>(nb_threads);
+        auto slice_size = (std::max)(min_merge_slice, (size + nb_slices - 1) / nb_slices);
+
+        work_stealing_pool pool(nb_threads);
+
+        // Count the inversions in every chunk, which also sorts it
+        std::atomic<ResultType> inversions(0);
+        for (std::ptrdiff_t idx = 0 ; idx < nb_runs ; ++idx) {
+            auto begin = (std::min)(idx * run_size, size);
+            auto end = (std::min)(begin + run_size, size);
+            if (begin == end) break;
+            pool.submit([=, &inversions] {
+                inversions += count_inversions<ResultType>(first + begin, first + end,
+                                                           cache + begin,
+                                                           compare, projection);
+            });
+        }
+        pool.wait();
+        ResultType res = inversions.load();
+
+        // Count the cross inversions while merging the chunks,
+        // alternating between the collection and the cache
+        for (int round = 0 ; round < nb_rounds ; ++round) {
+            if (round % 2 == 0) {
+                res += count_inversions_round<ResultType>(first, cache, size, run_size, slice_size,
+                                                          compare, projection, pool);
+            } else {
+                res += count_inversions_round<ResultType>(cache, first, size, run_size, slice_size,
+                                                          compare, projection, pool);
+            }
+            run_size *= 2;
+        }
+        return res;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_LONGEST_NON_DESCENDING_SUBSEQUENCE_H_
+#define CPPSORT_DETAIL_PARALLEL_LONGEST_NON_DESCENDING_SUBSEQUENCE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/comparators/flip.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "longest_non_descending_subsequence.h"
+#include "parallel_merge_sort.h"
+#include "upper_bound.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_lnds_detail
+    {
+        // Top elements of the patience sorting stacks: the i-th
+        // element is the smallest element ending a non-decreasing
+        // subsequence of size i + 1 of [first, last)
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto patience_stack_tops(RandomAccessIterator first, RandomAccessIterator last,
+                                 Compare compare, Projection projection)
+            -> std::vector<RandomAccessIterator>
+        {
+            auto&& proj = utility::as_function(projection);
+
+            std::vector<RandomAccessIterator> stack_tops;
+            for (; first != last ; ++first) {
+                auto it = detail::upper_bound(
+                    stack_tops.begin(), stack_tops.end(),
+                    proj(*first), compare, utility::indirect{} | projection);
+                if (it == stack_tops.end()) {
+                    stack_tops.emplace_back(first);
+                } else {
+                    *it = first;
+                }
+            }
+            return stack_tops;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel version of longest_non_descending_subsequence:
+    // patience sorting is inherently sequential, so the first
+    // half of the collection is processed forward while the
+    // second half is concurrently processed backward, looking
+    // for the biggest elements starting non-decreasing
+    // subsequences of every size. Both sets of stacks are then
+    // reconciled: for every stack top a of the first half, the
+    // longest non-decreasing subsequence of the second half that
+    // can extend the subsequence ending with a is the number of
+    // backward stack tops not smaller than a, which is found with
+    // a linear walk since both sets of stack tops are sorted.
+    //
+    // Returns a pair containing the size of the LNDS and the size
+    // of the collection, like the sequential algorithm.
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_longest_non_descending_subsequence(RandomAccessIterator first,
+                                                     RandomAccessIterator last,
+                                                     Compare compare, Projection projection,
+                                                     std::size_t nb_threads=default_thread_count())
+        -> std::pair<difference_type_t<RandomAccessIterator>,
+                     difference_type_t<RandomAccessIterator>>
+    {
+        using namespace parallel_lnds_detail;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        auto size = last - first;
+        if (nb_threads < 2 || size < parallel_merge_sort_detail::parallel_threshold) {
+            return longest_non_descending_subsequence<true>(
+                std::move(first), std::move(last), 0,
+                std::move(compare), std::move(projection)
+            );
+        }
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+        auto middle = first + size / 2;
+
+        // Only two threads are ever needed
+        work_stealing_pool pool(2);
+        std::vector<RandomAccessIterator> forward_tops;
+        pool.submit([&] {
+            forward_tops = patience_stack_tops(first, middle, compare, projection);
+        });
+        // The biggest elements starting non-decreasing subsequences
+        // of the second half, sorted in descending order
+        auto backward_tops = patience_stack_tops(
+            std::make_reverse_iterator(last), std::make_reverse_iterator(middle),
+            cppsort::flip(compare), projection
+        );
+        pool.wait();
+
+        // Reconcile the two halves, taking nothing from the first
+        // half and everything from the second one as a start
+        auto backward_size = static_cast<difference_type>(backward_tops.size());
+        auto res = backward_size;
+        auto nb_extensions = backward_size;
+        for (difference_type idx = 0 ; idx < static_cast<difference_type>(forward_tops.size()) ; ++idx) {
+            auto&& value = proj(*forward_tops[idx]);
+            while (nb_extensions > 0 && comp(proj(*backward_tops[nb_extensions - 1]), value)) {
+                --nb_extensions;
+            }
+            if (idx + 1 + nb_extensions > res) {
+                res = idx + 1 + nb_extensions;
+            }
+        }
+        return { res, size };
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_LONGEST_NON_DESCENDING_SUBSEQUENCE_H_
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+#include "lower_bound.h"
+#include "memory.h"
+#include "merge_sort.h"
+#include "move.h"
+#include "multiway_merge.h"
+#include "scope_exit.h"
+#include "upper_bound.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_merge_sort_detail
+    {
+        // Collections smaller than this size are sorted sequentially
+        constexpr std::ptrdiff_t parallel_threshold = 1 << 15;
+
+        // Minimal number of elements written by a merge task
+        constexpr std::ptrdiff_t min_merge_slice = 1 << 13;
+
+        // Co-ranking generalized to several sorted runs: returns, for
+        // every run, the end of its elements that appear among the
+        // first rank elements of the stable merge of the runs, where
+        // elements of earlier runs come first when they compare
+        // equivalent. The rank in the merge of the elements of a run
+        // grows with their position in it, so each end is found with
+        // a binary search, every probe computing the rank of an element
+        // with a binary search in each of the other runs
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto co_rank(const std::vector<std::pair<RandomAccessIterator, RandomAccessIterator>>& runs,
+                     std::ptrdiff_t rank, Compare compare, Projection projection)
+            -> std::vector<RandomAccessIterator>
+        {
+            auto&& proj = utility::as_function(projection);
+
+            auto merge_rank = [&](std::size_t run_idx, RandomAccessIterator it) {
+                std::ptrdiff_t res = it - runs[run_idx].first;
+                for (std::size_t idx = 0 ; idx < runs.size() ; ++idx) {
+                    if (idx < run_idx) {
+                        res += detail::upper_bound(runs[idx].first, runs[idx].second, proj(*it),
+                                                   compare, projection) - runs[idx].first;
+                    } else if (idx > run_idx) {
+                        res += detail::lower_bound(runs[idx].first, runs[idx].second, proj(*it),
+                                                   compare, projection) - runs[idx].first;
+                    }
+                }
+                return res;
+            };
+
+            std::vector<RandomAccessIterator> res;
+            res.reserve(runs.size());
+            for (std::size_t idx = 0 ; idx < runs.size() ; ++idx) {
+                auto lo = std::ptrdiff_t(0);
+                auto hi = (std::min)(runs[idx].second - runs[idx].first, rank);
+                while (lo < hi) {
+                    auto mid = lo + (hi - lo) / 2;
+                    if (merge_rank(idx, runs[idx].first + mid) < rank) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                res.push_back(runs[idx].first + lo);
+            }
+            return res;
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection,
+                             std::size_t nb_threads=default_thread_count())
+        -> void
+    {
+        using namespace parallel_merge_sort_detail;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+
+        std::ptrdiff_t size = last - first;
+        if (nb_threads < 2 || size < parallel_threshold) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Merging out-of-place requires a buffer as big as the collection,
+        // merge_sort is memory-adaptive and a better fit otherwise
+        temporary_buffer<rvalue_type> buffer(size);
+        if (buffer.size() < size) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Sort one run per thread in the buffer, then merge all
+        // of them back into the collection in a single pass
+        auto nb_runs = (std::min)(static_cast<std::ptrdiff_t>(nb_threads), size);
+        std::ptrdiff_t run_size = (size + nb_runs - 1) / nb_runs;
+
+        // Split the merge into a few slices per thread so that
+        // threads which are done early can steal some of the work
+        auto nb_slices = (std::min)(4 * static_cast<std::ptrdiff_t>(nb_threads),
+                                    (size + min_merge_slice - 1) / min_merge_slice);
+
+        // Keep track of the elements constructed in the buffer, one
+        // destroyer per run since runs are moved concurrently
+        std::vector<destruct_n<rvalue_type>> destroyers(nb_runs, destruct_n<rvalue_type>(0));
+        auto destroy_buffer = make_scope_exit([&] {
+            for (std::ptrdiff_t idx = 0 ; idx < nb_runs ; ++idx) {
+                auto offset = (std::min)(idx * run_size, size);
+                destroyers[idx](buffer.data() + offset);
+            }
+        });
+
+        work_stealing_pool pool(nb_threads);
+
+        // Move the runs to the buffer and sort them there
+        std::vector<std::pair<rvalue_type*, rvalue_type*>> runs;
+        for (std::ptrdiff_t idx = 0 ; idx < nb_runs ; ++idx) {
+            auto begin = (std::min)(idx * run_size, size);
+            auto end = (std::min)(begin + run_size, size);
+            if (begin == end) break;
+            runs.emplace_back(buffer.data() + begin, buffer.data() + end);
+            pool.submit([=, &buffer, &destroyers] {
+                auto buff_first = buffer.data() + begin;
+                auto buff_last = uninitialized_move(first + begin, first + end,
+                                                    buff_first, destroyers[idx]);
+                merge_sort(buff_first, buff_last, end - begin, compare, projection);
+            });
+        }
+        pool.wait();
+
+        // Merge every slice of the output with a loser tree, the bounds
+        // of the slice in every run are found by co-ranking, so that
+        // every task writes the same number of elements
+        for (std::ptrdiff_t slice = 0 ; slice < nb_slices ; ++slice) {
+            auto begin_rank = slice * size / nb_slices;
+            auto end_rank = (slice + 1) * size / nb_slices;
+            pool.submit([=, &runs] {
+                auto begins = co_rank(runs, begin_rank, compare, projection);
+                auto ends = co_rank(runs, end_rank, compare, projection);
+                std::vector<std::pair<rvalue_type*, rvalue_type*>> slice_runs;
+                slice_runs.reserve(runs.size());
+                for (std::size_t idx = 0 ; idx < runs.size() ; ++idx) {
+                    slice_runs.emplace_back(begins[idx], ends[idx]);
+                }
+                multiway_merge<true>(slice_runs, first + begin_rank, compare, projection);
+            });
+        }
+        pool.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
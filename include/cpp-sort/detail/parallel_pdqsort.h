@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "heapsort.h"
+#include "iterator_traits.h"
+#include "iter_sort3.h"
+#include "pdqsort.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace pdqsort_detail
+    {
+        // Partitions smaller than this size are sorted sequentially,
+        // forking them onto the pool costs more than it brings
+        constexpr std::ptrdiff_t parallel_threshold = 1 << 15;
+
+        // Same algorithm as pdqsort_loop, except that the left
+        // partitions are forked onto the work-stealing pool as
+        // long as they are big enough; partitions that are too
+        // small for it are handed over to the sequential loop
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto parallel_pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end,
+                                   Compare compare, Projection projection,
+                                   int bad_allowed, bool leftmost,
+                                   work_stealing_pool& pool)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            using value_type = value_type_t<RandomAccessIterator>;
+            using projected_type = projected_t<RandomAccessIterator, Projection>;
+
+            constexpr bool is_branchless =
+                utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+                utility::is_probably_branchless_projection_v<Projection, value_type>;
+            (void)is_branchless; // Silence a -Wunused-but-set-variable false positive
+
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            while (true) {
+                difference_type size = end - begin;
+
+                if (size < parallel_threshold) {
+                    pdqsort_loop(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection),
+                                 bad_allowed, leftmost);
+                    return;
+                }
+
+                // Choose pivot as pseudomedian of 9, the partition is
+                // always big enough for it at this point
+                difference_type s2 = size / 2;
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+
+                // Elements equal to *(begin - 1) are already sorted, see pdqsort_loop
+                if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    begin = partition_left(begin, end, compare, projection) + 1;
+                    continue;
+                }
+
+                std::pair<RandomAccessIterator, bool> part_result = is_branchless ?
+                    partition_right_vectorized(begin, end, compare, projection,
+                                               is_simd_compatible<RandomAccessIterator, Compare, Projection>{}) :
+                    partition_right(begin, end, compare, projection);
+                RandomAccessIterator pivot_pos = part_result.first;
+                bool already_partitioned = part_result.second;
+
+                difference_type l_size = pivot_pos - begin;
+                difference_type r_size = end - (pivot_pos + 1);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                if (highly_unbalanced) {
+                    // Too many bad partitions, switch to heapsort to guarantee O(n log n)
+                    if (--bad_allowed == 0) {
+                        heapsort(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    // Shuffle elements to break patterns, see pdqsort_loop
+                    if (l_size >= insertion_sort_threshold) {
+                        iter_swap(begin,             begin + l_size / 4);
+                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                        if (l_size > ninther_threshold) {
+                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+
+                    if (r_size >= insertion_sort_threshold) {
+                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        iter_swap(end - 1,                   end - r_size / 4);
+
+                        if (r_size > ninther_threshold) {
+                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            iter_swap(end - 2,             end - (1 + r_size / 4));
+                            iter_swap(end - 3,             end - (2 + r_size / 4));
+                        }
+                    }
+                } else {
+                    if (already_partitioned &&
+                        partial_insertion_sort(begin, pivot_pos, compare, projection) &&
+                        partial_insertion_sort(pivot_pos + 1, end, compare, projection)) {
+                        return;
+                    }
+                }
+
+                // Fork the left partition and keep working on the right
+                // one: the only element read outside of a partition is
+                // the pivot that precedes it, which is never modified
+                // again once it is in its final position
+                pool.submit([=, &pool] {
+                    parallel_pdqsort_loop(begin, pivot_pos, compare, projection,
+                                          bad_allowed, leftmost, pool);
+                });
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_pdqsort(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection,
+                          std::size_t nb_threads=default_thread_count())
+        -> void
+    {
+        auto size = end - begin;
+        if (size < 2) return;
+
+        if (nb_threads < 2 || size < pdqsort_detail::parallel_threshold) {
+            pdqsort_detail::pdqsort_loop(std::move(begin), std::move(end),
+                                         std::move(compare), std::move(projection),
+                                         detail::log2(size));
+            return;
+        }
+
+        work_stealing_pool pool(nb_threads);
+        pdqsort_detail::parallel_pdqsort_loop(std::move(begin), std::move(end),
+                                              std::move(compare), std::move(projection),
+                                              detail::log2(size), true, pool);
+        pool.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_QUICKSELECT_H_
+#define CPPSORT_DETAIL_PARALLEL_QUICKSELECT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "iterator_traits.h"
+#include "iter_sort3.h"
+#include "partition.h"
+#include "quickselect.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_quickselect_detail
+    {
+        // Partitions smaller than this size are handled sequentially,
+        // forking them onto the pool costs more than it brings
+        constexpr std::ptrdiff_t parallel_threshold = 1 << 16;
+
+        // Subrange [first, last) of a collection
+        template<typename Iterator>
+        struct block
+        {
+            Iterator first;
+            Iterator last;
+        };
+
+        // Finds the element at position pos in the concatenation
+        // of the given blocks
+        template<typename Iterator>
+        auto block_position(const std::vector<block<Iterator>>& blocks,
+                            difference_type_t<Iterator> pos)
+            -> std::pair<std::size_t, Iterator>
+        {
+            std::size_t idx = 0;
+            while (pos >= blocks[idx].last - blocks[idx].first) {
+                pos -= blocks[idx].last - blocks[idx].first;
+                ++idx;
+            }
+            return { idx, blocks[idx].first + pos };
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Parallel partition: every thread partitions its own chunk
+        // of the collection, which gives the final partition point.
+        // The elements of the right parts of the chunks that are
+        // left of that point are then swapped in parallel with the
+        // elements of the left parts of the chunks that are right
+        // of it: there are as many of each, and both sets are seen
+        // as the concatenation of at most one non-empty block per
+        // chunk.
+
+        template<typename RandomAccessIterator, typename Predicate>
+        auto parallel_partition(RandomAccessIterator first, RandomAccessIterator last,
+                                Predicate pred, work_stealing_pool& pool)
+            -> RandomAccessIterator
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+
+            auto size = last - first;
+            auto nb_chunks = static_cast<difference_type>(pool.thread_count());
+            std::vector<block<RandomAccessIterator>> chunks(nb_chunks);
+            std::vector<RandomAccessIterator> middles(nb_chunks);
+            for (difference_type idx = 0 ; idx < nb_chunks ; ++idx) {
+                chunks[idx].first = first + size * idx / nb_chunks;
+                chunks[idx].last = first + size * (idx + 1) / nb_chunks;
+                pool.submit([&, idx] {
+                    middles[idx] = detail::partition(chunks[idx].first, chunks[idx].last, pred);
+                });
+            }
+            pool.wait();
+
+            difference_type left_size = 0;
+            for (difference_type idx = 0 ; idx < nb_chunks ; ++idx) {
+                left_size += middles[idx] - chunks[idx].first;
+            }
+            auto middle = first + left_size;
+
+            // Elements that are on the wrong side of the partition point,
+            // empty blocks are never stored so that moving past the end
+            // of a block always lands on an element to swap
+            std::vector<block<RandomAccessIterator>> misplaced_right;
+            std::vector<block<RandomAccessIterator>> misplaced_left;
+            difference_type nb_misplaced = 0;
+            for (difference_type idx = 0 ; idx < nb_chunks ; ++idx) {
+                auto end = (std::min)(chunks[idx].last, middle);
+                if (middles[idx] < end) {
+                    misplaced_right.push_back({ middles[idx], end });
+                    nb_misplaced += end - middles[idx];
+                }
+                auto begin = (std::max)(chunks[idx].first, middle);
+                if (begin < middles[idx]) {
+                    misplaced_left.push_back({ begin, middles[idx] });
+                }
+            }
+            if (nb_misplaced == 0) {
+                return middle;
+            }
+
+            for (difference_type idx = 0 ; idx < nb_chunks ; ++idx) {
+                auto begin = nb_misplaced * idx / nb_chunks;
+                auto end = nb_misplaced * (idx + 1) / nb_chunks;
+                if (begin == end) continue;
+                pool.submit([&, begin, end] {
+                    auto pos1 = block_position(misplaced_right, begin);
+                    auto pos2 = block_position(misplaced_left, begin);
+                    for (auto count = end - begin ; count != 0 ; --count) {
+                        if (pos1.second == misplaced_right[pos1.first].last) {
+                            ++pos1.first;
+                            pos1.second = misplaced_right[pos1.first].first;
+                        }
+                        if (pos2.second == misplaced_left[pos2.first].last) {
+                            ++pos2.first;
+                            pos2.second = misplaced_left[pos2.first].first;
+                        }
+                        iter_swap(pos1.second, pos2.second);
+                        ++pos1.second;
+                        ++pos2.second;
+                    }
+                });
+            }
+            pool.wait();
+            return middle;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel selection: quickselect where the partitions big
+    // enough are partitioned in parallel, the smaller ones are
+    // handed over to the sequential algorithm
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_quickselect(RandomAccessIterator begin, RandomAccessIterator end,
+                              RandomAccessIterator nth,
+                              Compare compare, Projection projection,
+                              std::size_t nb_threads=default_thread_count())
+        -> void
+    {
+        using namespace parallel_quickselect_detail;
+        using utility::iter_swap;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        if (nb_threads < 2 || end - begin < parallel_threshold || nth == end) {
+            quickselect(std::move(begin), std::move(end), std::move(nth),
+                        std::move(compare), std::move(projection));
+            return;
+        }
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        work_stealing_pool pool(nb_threads);
+        int bad_allowed = detail::log2(end - begin);
+        bool leftmost = true;
+        while (true) {
+            difference_type size = end - begin;
+            if (size < parallel_threshold) {
+                quickselect_loop(std::move(begin), std::move(end), std::move(nth),
+                                 std::move(compare), std::move(projection),
+                                 bad_allowed, leftmost);
+                return;
+            }
+
+            // Choose pivot as pseudomedian of 9
+            difference_type s2 = size / 2;
+            iter_sort3(begin, begin + s2, end - 1, compare, projection);
+            iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+            iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+            iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+            iter_swap(begin, begin + s2);
+
+            // The pivot is not part of the partitioned range, so it
+            // can be read concurrently without being modified
+            RandomAccessIterator pivot_pos;
+            if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                // Elements equal to the previous pivot, see quickselect_loop
+                auto pivot = begin - 1;
+                pivot_pos = parallel_partition(begin, end, [&](auto&& value) {
+                    return not comp(proj(*pivot), proj(value));
+                }, pool) - 1;
+                if (nth <= pivot_pos) {
+                    return;
+                }
+                begin = pivot_pos + 1;
+                continue;
+            }
+
+            pivot_pos = parallel_partition(begin + 1, end, [&](auto&& value) {
+                return comp(proj(value), proj(*begin));
+            }, pool) - 1;
+            if (pivot_pos != begin) {
+                iter_swap(begin, pivot_pos);
+            }
+            if (pivot_pos == nth) {
+                return;
+            }
+
+            difference_type l_size = pivot_pos - begin;
+            difference_type r_size = end - (pivot_pos + 1);
+            if ((l_size < size / 8 || r_size < size / 8) && --bad_allowed == 0) {
+                median_of_ninthers_select(std::move(begin), std::move(nth), std::move(end),
+                                          std::move(compare), std::move(projection));
+                return;
+            }
+
+            if (nth < pivot_pos) {
+                end = pivot_pos;
+            } else {
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_QUICKSELECT_H_
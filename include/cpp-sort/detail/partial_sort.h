@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARTIAL_SORT_H_
+#define CPPSORT_DETAIL_PARTIAL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "heapsort.h"
+#include "iterator_traits.h"
+#include "move.h"
+#include "nth_element.h"
+#include "parallel_pdqsort.h"
+#include "parallel_quickselect.h"
+#include "pdqsort.h"
+#include "quick_merge_sort.h"
+#include "quickselect.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // nth_element: the random-access version relies on the
+    // pdqsort-like quickselect instead of the algorithms used
+    // by detail::nth_element, which are tuned to find pivots
+    // for other algorithms
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto select_nth(std::forward_iterator_tag,
+                    ForwardIterator first, ForwardIterator last,
+                    difference_type_t<ForwardIterator> nth_pos,
+                    difference_type_t<ForwardIterator> size,
+                    Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        return detail::nth_element(std::move(first), std::move(last), nth_pos, size,
+                                   std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto select_nth(std::random_access_iterator_tag,
+                    RandomAccessIterator first, RandomAccessIterator last,
+                    difference_type_t<RandomAccessIterator> nth_pos,
+                    difference_type_t<RandomAccessIterator>, // unused
+                    Compare compare, Projection projection)
+        -> RandomAccessIterator
+    {
+        auto nth = first + nth_pos;
+        quickselect(std::move(first), std::move(last), nth,
+                    std::move(compare), std::move(projection));
+        return nth;
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto select_nth(ForwardIterator first, ForwardIterator last,
+                    difference_type_t<ForwardIterator> nth_pos,
+                    difference_type_t<ForwardIterator> size,
+                    Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        if (nth_pos < 0 || nth_pos >= size) {
+            return last;
+        }
+        using category = iterator_category_t<ForwardIterator>;
+        return select_nth(category{}, std::move(first), std::move(last), nth_pos, size,
+                          std::move(compare), std::move(projection));
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto parallel_select_nth(std::forward_iterator_tag,
+                             ForwardIterator first, ForwardIterator last,
+                             difference_type_t<ForwardIterator> nth_pos,
+                             difference_type_t<ForwardIterator> size,
+                             Compare compare, Projection projection,
+                             std::size_t /* nb_threads */)
+        -> ForwardIterator
+    {
+        return detail::nth_element(std::move(first), std::move(last), nth_pos, size,
+                                   std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_select_nth(std::random_access_iterator_tag,
+                             RandomAccessIterator first, RandomAccessIterator last,
+                             difference_type_t<RandomAccessIterator> nth_pos,
+                             difference_type_t<RandomAccessIterator>, // unused
+                             Compare compare, Projection projection,
+                             std::size_t nb_threads)
+        -> RandomAccessIterator
+    {
+        auto nth = first + nth_pos;
+        parallel_quickselect(std::move(first), std::move(last), nth,
+                             std::move(compare), std::move(projection),
+                             nb_threads);
+        return nth;
+    }
+
+    // Only random-access iterators are partitioned in parallel,
+    // other ones fall back to the sequential algorithm
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto parallel_select_nth(ForwardIterator first, ForwardIterator last,
+                             difference_type_t<ForwardIterator> nth_pos,
+                             difference_type_t<ForwardIterator> size,
+                             Compare compare, Projection projection,
+                             std::size_t nb_threads=default_thread_count())
+        -> ForwardIterator
+    {
+        if (nth_pos < 0 || nth_pos >= size) {
+            return last;
+        }
+        using category = iterator_category_t<ForwardIterator>;
+        return parallel_select_nth(category{}, std::move(first), std::move(last),
+                                   nth_pos, size,
+                                   std::move(compare), std::move(projection),
+                                   nb_threads);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // partial_sort: the k smallest elements are gathered at
+    // the beginning of the collection by a selection algorithm,
+    // then sorted; the order of the other elements is left
+    // unspecified. Returns an iterator past the sorted part.
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto partial_sort(std::forward_iterator_tag,
+                      ForwardIterator first, ForwardIterator last,
+                      difference_type_t<ForwardIterator> k,
+                      difference_type_t<ForwardIterator> size,
+                      Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        if (k >= size) {
+            quick_merge_sort(first, last, size, std::move(compare), std::move(projection));
+            return last;
+        }
+        // The element before the k-th one is the biggest of the
+        // sorted part, there is no need to sort it again
+        auto nth = detail::nth_element(first, last, k - 1, size, compare, projection);
+        quick_merge_sort(first, nth, k - 1, std::move(compare), std::move(projection));
+        return std::next(nth);
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto partial_sort(std::random_access_iterator_tag,
+                      RandomAccessIterator first, RandomAccessIterator last,
+                      difference_type_t<RandomAccessIterator> k,
+                      difference_type_t<RandomAccessIterator> size,
+                      Compare compare, Projection projection)
+        -> RandomAccessIterator
+    {
+        if (k >= size) {
+            pdqsort(first, last, std::move(compare), std::move(projection));
+            return last;
+        }
+        auto nth = first + (k - 1);
+        quickselect(first, last, nth, compare, projection);
+        pdqsort(first, nth, std::move(compare), std::move(projection));
+        return nth + 1;
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto partial_sort(ForwardIterator first, ForwardIterator last,
+                      difference_type_t<ForwardIterator> k,
+                      difference_type_t<ForwardIterator> size,
+                      Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        if (k <= 0) {
+            return first;
+        }
+        using category = iterator_category_t<ForwardIterator>;
+        return partial_sort(category{}, std::move(first), std::move(last), k, size,
+                            std::move(compare), std::move(projection));
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto parallel_partial_sort(std::forward_iterator_tag,
+                               ForwardIterator first, ForwardIterator last,
+                               difference_type_t<ForwardIterator> k,
+                               difference_type_t<ForwardIterator> size,
+                               Compare compare, Projection projection,
+                               std::size_t /* nb_threads */)
+        -> ForwardIterator
+    {
+        return partial_sort(std::forward_iterator_tag{},
+                            std::move(first), std::move(last), k, size,
+                            std::move(compare), std::move(projection));
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_partial_sort(std::random_access_iterator_tag,
+                               RandomAccessIterator first, RandomAccessIterator last,
+                               difference_type_t<RandomAccessIterator> k,
+                               difference_type_t<RandomAccessIterator> size,
+                               Compare compare, Projection projection,
+                               std::size_t nb_threads)
+        -> RandomAccessIterator
+    {
+        if (k >= size) {
+            parallel_pdqsort(first, last, std::move(compare), std::move(projection),
+                             nb_threads);
+            return last;
+        }
+        auto nth = first + (k - 1);
+        parallel_quickselect(first, last, nth, compare, projection, nb_threads);
+        parallel_pdqsort(first, nth, std::move(compare), std::move(projection),
+                         nb_threads);
+        return nth + 1;
+    }
+
+    template<typename ForwardIterator, typename Compare, typename Projection>
+    auto parallel_partial_sort(ForwardIterator first, ForwardIterator last,
+                               difference_type_t<ForwardIterator> k,
+                               difference_type_t<ForwardIterator> size,
+                               Compare compare, Projection projection,
+                               std::size_t nb_threads=default_thread_count())
+        -> ForwardIterator
+    {
+        if (k <= 0) {
+            return first;
+        }
+        using category = iterator_category_t<ForwardIterator>;
+        return parallel_partial_sort(category{}, std::move(first), std::move(last), k, size,
+                                     std::move(compare), std::move(projection),
+                                     nb_threads);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // top_k: heap-select, the k smallest elements seen so far
+    // are kept in a max-heap at the beginning of the collection,
+    // and every new element only needs to be compared to the top
+    // of the heap to know whether it has to replace it. The
+    // collection is read once, which makes it faster than a
+    // selection when k is small compared to the size of the
+    // collection.
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto top_k(RandomAccessIterator first, RandomAccessIterator last,
+               difference_type_t<RandomAccessIterator> k,
+               Compare compare, Projection projection)
+        -> RandomAccessIterator
+    {
+        using utility::iter_swap;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (k <= 0) {
+            return first;
+        }
+        if (k >= last - first) {
+            pdqsort(first, last, std::move(compare), std::move(projection));
+            return last;
+        }
+
+        auto middle = first + k;
+        detail::make_heap(first, middle, compare, projection);
+        for (auto it = middle ; it != last ; ++it) {
+            if (comp(proj(*it), proj(*first))) {
+                iter_swap(it, first);
+                detail::sift_down(first, middle, compare, projection, k, first);
+            }
+        }
+        detail::sort_heap(first, middle, std::move(compare), std::move(projection));
+        return middle;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // top_k_copy: streaming version of top_k, the elements are
+    // read once from a single-pass range, the k smallest ones
+    // are kept in a separate max-heap of at most k elements,
+    // and are written to the output in sorted order at the end
+
+    template<typename InputIterator, typename OutputIterator,
+             typename Compare, typename Projection>
+    auto top_k_copy(InputIterator first, InputIterator last, std::ptrdiff_t k,
+                    OutputIterator out, Compare compare, Projection projection)
+        -> OutputIterator
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (k <= 0) {
+            return out;
+        }
+
+        std::vector<value_type_t<InputIterator>> heap;
+        for (; first != last ; ++first) {
+            if (static_cast<std::ptrdiff_t>(heap.size()) < k) {
+                heap.push_back(*first);
+                if (static_cast<std::ptrdiff_t>(heap.size()) == k) {
+                    detail::make_heap(heap.begin(), heap.end(), compare, projection);
+                }
+            } else {
+                decltype(auto) value = *first;
+                if (comp(proj(value), proj(heap.front()))) {
+                    heap.front() = std::forward<decltype(value)>(value);
+                    detail::sift_down(heap.begin(), heap.end(), compare, projection,
+                                      static_cast<std::ptrdiff_t>(heap.size()), heap.begin());
+                }
+            }
+        }
+
+        if (static_cast<std::ptrdiff_t>(heap.size()) < k) {
+            pdqsort(heap.begin(), heap.end(), std::move(compare), std::move(projection));
+        } else {
+            detail::sort_heap(heap.begin(), heap.end(), std::move(compare), std::move(projection));
+        }
+        return detail::move(heap.begin(), heap.end(), std::move(out));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARTIAL_SORT_H_
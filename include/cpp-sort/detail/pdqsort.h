@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/branchless_traits.h>
@@ -41,6 +42,8 @@
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "iter_sort3.h"
+#include "simd.h"
+#include "simd_partition.h"
 
 #ifdef __MINGW32__
 #   include <cstdint> // std::uintptr_t
@@ -334,6 +337,54 @@ namespace detail
             return std::make_pair(pivot_pos, already_partitioned);
         }
 
+        // Same as partition_right_branchless, but uses a vectorized partitioning algorithm when the
+        // elements are arithmetic types compared with std::less<> and the processor supports it.
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_vectorized(RandomAccessIterator begin, RandomAccessIterator end,
+                                        Compare compare, Projection projection, std::false_type)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            return partition_right_branchless(std::move(begin), std::move(end),
+                                              std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_vectorized(RandomAccessIterator begin, RandomAccessIterator end,
+                                        Compare compare, Projection projection, std::true_type)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            if (runtime_simd_isa() == simd_isa::none) {
+                return partition_right_branchless(std::move(begin), std::move(end),
+                                                  std::move(compare), std::move(projection));
+            }
+
+            auto pivot = *begin;
+            RandomAccessIterator first = begin;
+            RandomAccessIterator last = end;
+
+            // Same searches as the other partitioning functions, which tell whether the sequence
+            // already was correctly partitioned.
+            while (*++first < pivot);
+            if (first - 1 == begin) while (first < last && !(*--last < pivot));
+            else                    while (                !(*--last < pivot));
+
+            bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                // [first, last] is the only part of the sequence that still has to be partitioned.
+                auto data = simd_address(begin);
+                auto middle = simd_partition(data + (first - begin), data + (last - begin) + 1,
+                                             pivot, simd_less_than{});
+                first = begin + (middle - data);
+            }
+
+            // Put the pivot in the right place.
+            auto pivot_pos = first - 1;
+            *begin = *pivot_pos;
+            *pivot_pos = pivot;
+
+            return std::make_pair(pivot_pos, already_partitioned);
+        }
+
         // Partitions [begin, end) around pivot *begin using comparison function compare. Elements equal
         // to the pivot are put in the right-hand partition. Returns the position of the pivot after
         // partitioning and whether the passed sequence already was correctly partitioned. Assumes the
@@ -479,7 +530,8 @@ namespace detail
 
                 // Partition and get results.
                 std::pair<RandomAccessIterator, bool> part_result = is_branchless ?
-                    partition_right_branchless(begin, end, compare, projection) :
+                    partition_right_vectorized(begin, end, compare, projection,
+                                               is_simd_compatible<RandomAccessIterator, Compare, Projection>{}) :
                     partition_right(begin, end, compare, projection);
                 RandomAccessIterator pivot_pos = part_result.first;
                 bool already_partitioned = part_result.second;
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_POSITION_BITSET_H_
+#define CPPSORT_DETAIL_POSITION_BITSET_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bitops.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Fixed-size set of positions in [0, size), used to track the
+    // visited positions when following the cycles of a permutation:
+    // it uses one bit per position and allows to skip over runs of
+    // visited positions one word at a time
+
+    class position_bitset
+    {
+        public:
+
+            explicit position_bitset(std::size_t size):
+                size_(size),
+                words_((size + word_bits - 1) / word_bits, 0)
+            {}
+
+            auto test(std::size_t pos) const noexcept
+                -> bool
+            {
+                return (words_[pos / word_bits] >> (pos % word_bits)) & 1u;
+            }
+
+            auto set(std::size_t pos) noexcept
+                -> void
+            {
+                words_[pos / word_bits] |= std::uint64_t(1) << (pos % word_bits);
+            }
+
+            // Returns the first position >= pos which isn't in the
+            // set, or size() if there is no such position
+            auto next_unset(std::size_t pos) const noexcept
+                -> std::size_t
+            {
+                if (pos >= size_) {
+                    return size_;
+                }
+                auto word_idx = pos / word_bits;
+                auto word = ~words_[word_idx] & (~std::uint64_t(0) << (pos % word_bits));
+                while (word == 0) {
+                    if (++word_idx == words_.size()) {
+                        return size_;
+                    }
+                    word = ~words_[word_idx];
+                }
+                auto res = word_idx * word_bits + static_cast<std::size_t>(countr_zero(word));
+                return res < size_ ? res : size_;
+            }
+
+            auto size() const noexcept
+                -> std::size_t
+            {
+                return size_;
+            }
+
+        private:
+
+            static constexpr std::size_t word_bits = 64;
+
+            std::size_t size_;
+            std::vector<std::uint64_t> words_;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_POSITION_BITSET_H_
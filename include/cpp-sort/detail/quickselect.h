@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_QUICKSELECT_H_
+#define CPPSORT_DETAIL_QUICKSELECT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "adaptive_quickselect.h"
+#include "bitops.h"
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "iter_sort3.h"
+#include "pdqsort.h"
+#include "simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Selection algorithm following the structure of pdqsort:
+    // the partitions are the same as the ones of pdqsort, the
+    // vectorized one included, but only the partition that
+    // contains the nth element is processed further. Elements
+    // equal to the previous pivot are handled the same way as
+    // in pdqsort, and too many unbalanced partitions make it
+    // fall back to Alexandrescu's adaptive quickselect, which
+    // runs in linear time in the worst case.
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto quickselect_loop(RandomAccessIterator begin, RandomAccessIterator end,
+                          RandomAccessIterator nth,
+                          Compare compare, Projection projection,
+                          int bad_allowed, bool leftmost=true)
+        -> void
+    {
+        using namespace pdqsort_detail;
+        using utility::iter_swap;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using value_type = value_type_t<RandomAccessIterator>;
+        using projected_type = projected_t<RandomAccessIterator, Projection>;
+
+        constexpr bool is_branchless =
+            utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+            utility::is_probably_branchless_projection_v<Projection, value_type>;
+        (void)is_branchless; // Silence a -Wunused-but-set-variable false positive
+
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        while (true) {
+            difference_type size = end - begin;
+
+            if (size < insertion_sort_threshold) {
+                if (leftmost) {
+                    insertion_sort(begin, end, std::move(compare), std::move(projection));
+                } else {
+                    unguarded_insertion_sort(begin, end, std::move(compare), std::move(projection));
+                }
+                return;
+            }
+
+            // Choose pivot as median of 3 or pseudomedian of 9
+            difference_type s2 = size / 2;
+            if (size > ninther_threshold) {
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+            } else {
+                iter_sort3(begin + s2, begin, end - 1, compare, projection);
+            }
+
+            // Elements equal to *(begin - 1) are already in their final
+            // position once they are gathered on the left, see pdqsort_loop
+            if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                RandomAccessIterator pivot_pos = partition_left(begin, end, compare, projection);
+                if (nth <= pivot_pos) {
+                    return;
+                }
+                begin = pivot_pos + 1;
+                continue;
+            }
+
+            std::pair<RandomAccessIterator, bool> part_result = is_branchless ?
+                partition_right_vectorized(begin, end, compare, projection,
+                                           is_simd_compatible<RandomAccessIterator, Compare, Projection>{}) :
+                partition_right(begin, end, compare, projection);
+            RandomAccessIterator pivot_pos = part_result.first;
+            if (pivot_pos == nth) {
+                return;
+            }
+
+            difference_type l_size = pivot_pos - begin;
+            difference_type r_size = end - (pivot_pos + 1);
+            if (l_size < size / 8 || r_size < size / 8) {
+                // Too many bad partitions, switch to a selection
+                // algorithm with a linear worst case
+                if (--bad_allowed == 0) {
+                    median_of_ninthers_select(std::move(begin), std::move(nth), std::move(end),
+                                              std::move(compare), std::move(projection));
+                    return;
+                }
+
+                // Shuffle elements to break patterns, see pdqsort_loop
+                if (l_size >= insertion_sort_threshold) {
+                    iter_swap(begin,             begin + l_size / 4);
+                    iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                    if (l_size > ninther_threshold) {
+                        iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                        iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                        iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+
+                if (r_size >= insertion_sort_threshold) {
+                    iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    iter_swap(end - 1,                   end - r_size / 4);
+
+                    if (r_size > ninther_threshold) {
+                        iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        iter_swap(end - 2,             end - (1 + r_size / 4));
+                        iter_swap(end - 3,             end - (2 + r_size / 4));
+                    }
+                }
+            }
+
+            if (nth < pivot_pos) {
+                end = pivot_pos;
+            } else {
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto quickselect(RandomAccessIterator begin, RandomAccessIterator end,
+                     RandomAccessIterator nth,
+                     Compare compare, Projection projection)
+        -> void
+    {
+        auto size = end - begin;
+        if (size < 2 || nth == end) return;
+
+        quickselect_loop(std::move(begin), std::move(end), std::move(nth),
+                         std::move(compare), std::move(projection),
+                         detail::log2(size));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_QUICKSELECT_H_
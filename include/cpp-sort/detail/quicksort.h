@@ -9,6 +9,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
@@ -18,6 +19,8 @@
 #include "introselect.h"
 #include "iterator_traits.h"
 #include "partition.h"
+#include "simd.h"
+#include "simd_partition.h"
 
 namespace cppsort
 {
@@ -56,6 +59,26 @@ namespace detail
         return false;
     }
 
+    // Partitioning function, which uses a vectorized algorithm when
+    // the elements are arithmetic types compared with std::less<>
+    template<typename ForwardIterator, typename T, typename SimdPredicate, typename Predicate>
+    auto quicksort_partition(ForwardIterator first, ForwardIterator last,
+                             const T&, SimdPredicate, Predicate pred, std::false_type)
+        -> ForwardIterator
+    {
+        return detail::partition(std::move(first), std::move(last), std::move(pred));
+    }
+
+    template<typename ForwardIterator, typename T, typename SimdPredicate, typename Predicate>
+    auto quicksort_partition(ForwardIterator first, ForwardIterator last,
+                             const T& pivot, SimdPredicate simd_pred, Predicate, std::true_type)
+        -> ForwardIterator
+    {
+        auto data = simd_address(first);
+        auto middle = simd_partition(data, data + (last - first), T(pivot), simd_pred);
+        return first + (middle - data);
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto quicksort(ForwardIterator first, ForwardIterator last,
                    difference_type_t<ForwardIterator> size, int bad_allowed,
@@ -79,20 +102,24 @@ namespace detail
         auto median_it = temp.first;
         auto last_1 = temp.second;
 
+        using use_simd = is_simd_compatible<ForwardIterator, Compare, Projection>;
+
         // Put the pivot at position std::prev(last) and partition
         iter_swap(median_it, last_1);
         auto&& pivot1 = proj(*last_1);
-        auto middle1 = detail::partition(
-            first, last_1,
-            [&](auto&& elem) { return comp(proj(elem), pivot1); }
+        auto middle1 = quicksort_partition(
+            first, last_1, pivot1, simd_less_than{},
+            [&](auto&& elem) { return comp(proj(elem), pivot1); },
+            use_simd{}
         );
 
         // Put the pivot in its final position and partition
         iter_swap(middle1, last_1);
         auto&& pivot2 = proj(*middle1);
-        auto middle2 = detail::partition(
-            std::next(middle1), last,
-            [&](auto&& elem) { return not comp(pivot2, proj(elem)); }
+        auto middle2 = quicksort_partition(
+            std::next(middle1), last, pivot2, simd_not_greater{},
+            [&](auto&& elem) { return not comp(pivot2, proj(elem)); },
+            use_simd{}
         );
 
         // Recursive call: heuristic trick here: in real world cases,
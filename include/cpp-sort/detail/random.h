@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_RANDOM_H_
+#define CPPSORT_DETAIL_RANDOM_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // SplitMix64 by Sebastiano Vigna: a tiny pseudo-random number
+    // generator with a 64-bit state, good enough to pick random
+    // positions when sampling a collection
+
+    class splitmix64
+    {
+        public:
+
+            using result_type = std::uint64_t;
+
+            constexpr explicit splitmix64(std::uint64_t seed) noexcept:
+                state_(seed)
+            {}
+
+            auto operator()() noexcept
+                -> std::uint64_t
+            {
+                auto z = (state_ += 0x9e3779b97f4a7c15u);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+                return z ^ (z >> 31);
+            }
+
+        private:
+
+            std::uint64_t state_;
+    };
+
+    // Returns a pseudo-random integer in [0, bound), the bias of
+    // the modulo is negligible for the bounds used in the library
+    template<typename URBG>
+    auto random_below(URBG& engine, std::uint64_t bound)
+        -> std::uint64_t
+    {
+        return engine() % bound;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_RANDOM_H_
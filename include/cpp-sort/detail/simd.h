@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_H_
+#define CPPSORT_DETAIL_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <cpp-sort/utility/functional.h>
+#include "config.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+#if CPPSORT_SIMD_X86
+#   include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////
+// Function-level target attributes
+
+// Vectorized kernels are compiled for a specific instruction
+// set regardless of the flags used to compile the rest of the
+// program, and are only called after a runtime check
+
+// The _INLINE variants are meant for the small functions that
+// kernels are made of, and that have to be inlined into them
+// for the intrinsics to operate on registers
+
+#if CPPSORT_SIMD_X86
+#   define CPPSORT_TARGET_AVX2 __attribute__((target("avx2")))
+#   define CPPSORT_TARGET_AVX512 __attribute__((target("avx512f")))
+#   define CPPSORT_TARGET_AVX2_INLINE __attribute__((target("avx2"), always_inline)) inline
+#   define CPPSORT_TARGET_AVX512_INLINE __attribute__((target("avx512f"), always_inline)) inline
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Instruction sets available at runtime
+
+    enum class simd_isa
+    {
+        none,
+        avx2,
+        avx512
+    };
+
+    inline auto runtime_simd_isa() noexcept
+        -> simd_isa
+    {
+#if CPPSORT_SIMD_X86
+        static const simd_isa isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return simd_isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return simd_isa::avx2;
+            }
+            return simd_isa::none;
+        }();
+        return isa;
+#else
+        return simd_isa::none;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Types that vectorized kernels know how to handle: 32-bit
+    // and 64-bit integers and IEEE 754 floating point numbers
+
+    template<typename T>
+    struct is_simd_value:
+        std::integral_constant<
+            bool,
+            (std::is_integral<T>::value && not std::is_same<T, bool>::value &&
+             (sizeof(T) == 4 || sizeof(T) == 8)) ||
+            ((std::is_same<T, float>::value || std::is_same<T, double>::value) &&
+             std::numeric_limits<T>::is_iec559)
+        >
+    {};
+
+    // Kind of element, to pick the right instructions
+
+    enum class simd_kind
+    {
+        int32, uint32, int64, uint64, float32, float64
+    };
+
+    template<typename T>
+    struct simd_kind_of:
+        std::integral_constant<
+            simd_kind,
+            std::is_same<T, float>::value ? simd_kind::float32 :
+            std::is_same<T, double>::value ? simd_kind::float64 :
+            sizeof(T) == 4 ? (std::is_signed<T>::value ? simd_kind::int32 : simd_kind::uint32) :
+                             (std::is_signed<T>::value ? simd_kind::int64 : simd_kind::uint64)
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Comparison and projection functions that are known to
+    // perform a natural ascending comparison on such values
+
+    template<typename Compare, typename T>
+    struct is_simd_less:
+        disjunction<
+            std::is_same<Compare, std::less<>>,
+            std::is_same<Compare, std::less<T>>
+#ifdef __cpp_lib_ranges
+            , std::is_same<Compare, std::ranges::less>
+#endif
+        >
+    {};
+
+    template<typename Projection>
+    struct is_simd_identity:
+        disjunction<
+            std::is_same<Projection, utility::identity>
+#if CPPSORT_STD_IDENTITY_AVAILABLE
+            , std::is_same<Projection, std::identity>
+#endif
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Iterators over contiguous memory
+
+    template<typename Iterator>
+    struct is_contiguous_iterator:
+#ifdef __cpp_lib_concepts
+        std::integral_constant<bool, std::contiguous_iterator<Iterator>>
+#else
+        disjunction<
+            std::is_pointer<Iterator>,
+            std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::iterator>,
+            std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::const_iterator>
+        >
+#endif
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Whether a vectorized kernel can be used in place of the
+    // generic algorithm: the conditions are checked in order so
+    // that the contiguity is only checked for suitable types
+
+    template<typename Iterator, typename Compare, typename Projection>
+    struct is_simd_compatible:
+        conjunction<
+            is_simd_value<value_type_t<Iterator>>,
+            is_simd_less<Compare, value_type_t<Iterator>>,
+            is_simd_identity<Projection>,
+            is_contiguous_iterator<Iterator>
+        >
+    {};
+
+    template<typename Iterator>
+    auto simd_address(Iterator it)
+        -> decltype(std::addressof(*it))
+    {
+        return std::addressof(*it);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Comparisons performed by the kernels: both predicates
+    // match the ones used by pdqsort and quicksort, including
+    // for floating point numbers comparing unordered
+
+    // value < pivot
+    struct simd_less_than {};
+    // not (pivot < value)
+    struct simd_not_greater {};
+
+    template<typename T>
+    auto simd_scalar_predicate(T value, T pivot, simd_less_than) noexcept
+        -> bool
+    {
+        return value < pivot;
+    }
+
+    template<typename T>
+    auto simd_scalar_predicate(T value, T pivot, simd_not_greater) noexcept
+        -> bool
+    {
+        return not (pivot < value);
+    }
+
+#if CPPSORT_SIMD_X86
+
+    // Some versions of GCC 12 wrongly warn about uninitialized
+    // variables in their own implementation of AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+    // Element-wise comparisons of two registers, returning
+    // one bit per element
+
+    template<simd_kind Kind>
+    struct avx512_compare_ops;
+
+    template<>
+    struct avx512_compare_ops<simd_kind::int32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epi32_mask(values, pivots);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmple_epi32_mask(values, pivots);
+        }
+    };
+
+    template<>
+    struct avx512_compare_ops<simd_kind::uint32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epu32_mask(values, pivots);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmple_epu32_mask(values, pivots);
+        }
+    };
+
+    template<>
+    struct avx512_compare_ops<simd_kind::int64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epi64_mask(values, pivots);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmple_epi64_mask(values, pivots);
+        }
+    };
+
+    template<>
+    struct avx512_compare_ops<simd_kind::uint64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epu64_mask(values, pivots);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmple_epu64_mask(values, pivots);
+        }
+    };
+
+    template<>
+    struct avx512_compare_ops<simd_kind::float32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_ps_mask(_mm512_castsi512_ps(values), _mm512_castsi512_ps(pivots), _CMP_LT_OQ);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_ps_mask(_mm512_castsi512_ps(pivots), _mm512_castsi512_ps(values), _CMP_NLT_UQ);
+        }
+    };
+
+    template<>
+    struct avx512_compare_ops<simd_kind::float64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_pd_mask(_mm512_castsi512_pd(values), _mm512_castsi512_pd(pivots), _CMP_LT_OQ);
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto mask(__m512i values, __m512i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_pd_mask(_mm512_castsi512_pd(pivots), _mm512_castsi512_pd(values), _CMP_NLT_UQ);
+        }
+    };
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+    template<simd_kind Kind>
+    struct avx2_compare_ops;
+
+    template<>
+    struct avx2_compare_ops<simd_kind::int32>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivots, values)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(values, pivots))) & 0xFFu;
+        }
+    };
+
+    template<>
+    struct avx2_compare_ops<simd_kind::uint32>
+    {
+        // AVX2 only has signed comparisons, flipping the sign bit of
+        // both operands gives the unsigned comparison
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto flip(__m256i values) noexcept
+            -> __m256i
+        {
+            return _mm256_xor_si256(values, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return avx2_compare_ops<simd_kind::int32>::mask(flip(values), flip(pivots), simd_less_than{});
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return avx2_compare_ops<simd_kind::int32>::mask(flip(values), flip(pivots), simd_not_greater{});
+        }
+    };
+
+    template<>
+    struct avx2_compare_ops<simd_kind::int64>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(pivots, values)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(values, pivots))) & 0xFu;
+        }
+    };
+
+    template<>
+    struct avx2_compare_ops<simd_kind::uint64>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto flip(__m256i values) noexcept
+            -> __m256i
+        {
+            return _mm256_xor_si256(values, _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return avx2_compare_ops<simd_kind::int64>::mask(flip(values), flip(pivots), simd_less_than{});
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return avx2_compare_ops<simd_kind::int64>::mask(flip(values), flip(pivots), simd_not_greater{});
+        }
+    };
+
+    template<>
+    struct avx2_compare_ops<simd_kind::float32>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_ps(
+                _mm256_cmp_ps(_mm256_castsi256_ps(values), _mm256_castsi256_ps(pivots), _CMP_LT_OQ)
+            );
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_ps(
+                _mm256_cmp_ps(_mm256_castsi256_ps(pivots), _mm256_castsi256_ps(values), _CMP_NLT_UQ)
+            );
+        }
+    };
+
+    template<>
+    struct avx2_compare_ops<simd_kind::float64>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_less_than) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_pd(
+                _mm256_cmp_pd(_mm256_castsi256_pd(values), _mm256_castsi256_pd(pivots), _CMP_LT_OQ)
+            );
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto mask(__m256i values, __m256i pivots, simd_not_greater) noexcept
+            -> unsigned
+        {
+            return _mm256_movemask_pd(
+                _mm256_cmp_pd(_mm256_castsi256_pd(pivots), _mm256_castsi256_pd(values), _CMP_NLT_UQ)
+            );
+        }
+    };
+
+#endif // CPPSORT_SIMD_X86
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_H_
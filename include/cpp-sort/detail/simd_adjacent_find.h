@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_ADJACENT_FIND_H_
+#define CPPSORT_DETAIL_SIMD_ADJACENT_FIND_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <cpp-sort/utility/as_function.h>
+#include "config.h"
+#include "iterator_traits.h"
+#include "simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Relations between two adjacent elements a and b: finding
+    // the first pair satisfying one of them gives the end of a
+    // run, and counting them gives the number of step-downs
+
+    // b < a
+    struct adjacent_descent {};
+    // a < b
+    struct adjacent_ascent {};
+    // not (b < a)
+    struct adjacent_non_descent {};
+
+    template<typename Compare, typename Projection, typename T>
+    auto adjacent_pair_matches(Compare& comp, Projection& proj, T&& lhs, T&& rhs,
+                               adjacent_descent)
+        -> bool
+    {
+        return comp(proj(rhs), proj(lhs));
+    }
+
+    template<typename Compare, typename Projection, typename T>
+    auto adjacent_pair_matches(Compare& comp, Projection& proj, T&& lhs, T&& rhs,
+                               adjacent_ascent)
+        -> bool
+    {
+        return comp(proj(lhs), proj(rhs));
+    }
+
+    template<typename Compare, typename Projection, typename T>
+    auto adjacent_pair_matches(Compare& comp, Projection& proj, T&& lhs, T&& rhs,
+                               adjacent_non_descent)
+        -> bool
+    {
+        return not comp(proj(rhs), proj(lhs));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Scalar algorithms
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto scalar_find_adjacent_pair(ForwardIterator first, ForwardIterator last, Relation relation,
+                                   Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (first == last) {
+            return last;
+        }
+        for (auto next = std::next(first) ; next != last ; ++first, ++next) {
+            if (adjacent_pair_matches(comp, proj, *first, *next, relation)) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    template<typename BidirectionalIterator, typename Relation, typename Compare, typename Projection>
+    auto scalar_find_last_adjacent_pair(BidirectionalIterator first, BidirectionalIterator last,
+                                        Relation relation, Compare compare, Projection projection)
+        -> BidirectionalIterator
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (first == last) {
+            return last;
+        }
+        auto next = std::prev(last);
+        while (next != first) {
+            auto current = std::prev(next);
+            if (adjacent_pair_matches(comp, proj, *current, *next, relation)) {
+                return current;
+            }
+            next = current;
+        }
+        return last;
+    }
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto scalar_count_adjacent_pairs(ForwardIterator first, ForwardIterator last, Relation relation,
+                                     Compare compare, Projection projection)
+        -> difference_type_t<ForwardIterator>
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        difference_type_t<ForwardIterator> count = 0;
+        if (first == last) {
+            return count;
+        }
+        for (auto next = std::next(first) ; next != last ; ++first, ++next) {
+            count += adjacent_pair_matches(comp, proj, *first, *next, relation);
+        }
+        return count;
+    }
+
+#if CPPSORT_SIMD_X86
+
+    ////////////////////////////////////////////////////////////
+    // Vectorized kernels: a register of elements is compared
+    // to the same register shifted by one element, which gives
+    // the relation between width adjacent pairs at once as a
+    // bitmask; the remaining pairs are handled by scalar code
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_adjacent_mask(Register lhs, Register rhs, adjacent_descent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(rhs, lhs, simd_less_than{});
+    }
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_adjacent_mask(Register lhs, Register rhs, adjacent_ascent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(lhs, rhs, simd_less_than{});
+    }
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_adjacent_mask(Register lhs, Register rhs, adjacent_non_descent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(lhs, rhs, simd_not_greater{});
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX512
+    auto avx512_find_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+        using ops = avx512_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 64 / sizeof(T);
+
+        while (last - first > width) {
+            __m512i lhs = _mm512_loadu_si512(first);
+            __m512i rhs = _mm512_loadu_si512(first + 1);
+            unsigned mask = avx512_adjacent_mask<ops>(lhs, rhs, relation);
+            if (mask != 0) {
+                return first + __builtin_ctz(mask);
+            }
+            first += width;
+        }
+        return scalar_find_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX512
+    auto avx512_find_last_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+        using ops = avx512_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 64 / sizeof(T);
+
+        const T* end = last;
+        while (last - first > width) {
+            const T* base = last - 1 - width;
+            __m512i lhs = _mm512_loadu_si512(base);
+            __m512i rhs = _mm512_loadu_si512(base + 1);
+            unsigned mask = avx512_adjacent_mask<ops>(lhs, rhs, relation);
+            if (mask != 0) {
+                return base + (31 - __builtin_clz(mask));
+            }
+            last -= width;
+        }
+        auto res = scalar_find_last_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+        return res == last ? end : res;
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX512
+    auto avx512_count_adjacent_pairs(const T* first, const T* last, Relation relation) noexcept
+        -> std::ptrdiff_t
+    {
+        using ops = avx512_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 64 / sizeof(T);
+
+        std::ptrdiff_t count = 0;
+        while (last - first > width) {
+            __m512i lhs = _mm512_loadu_si512(first);
+            __m512i rhs = _mm512_loadu_si512(first + 1);
+            count += __builtin_popcount(avx512_adjacent_mask<ops>(lhs, rhs, relation));
+            first += width;
+        }
+        return count + scalar_count_adjacent_pairs(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_adjacent_mask(Register lhs, Register rhs, adjacent_descent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(rhs, lhs, simd_less_than{});
+    }
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_adjacent_mask(Register lhs, Register rhs, adjacent_ascent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(lhs, rhs, simd_less_than{});
+    }
+
+    template<typename Ops, typename Register>
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_adjacent_mask(Register lhs, Register rhs, adjacent_non_descent) noexcept
+        -> unsigned
+    {
+        return Ops::mask(lhs, rhs, simd_not_greater{});
+    }
+
+    template<typename T>
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_load(const T* ptr) noexcept
+        -> __m256i
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX2
+    auto avx2_find_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+        using ops = avx2_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 32 / sizeof(T);
+
+        while (last - first > width) {
+            unsigned mask = avx2_adjacent_mask<ops>(avx2_load(first), avx2_load(first + 1), relation);
+            if (mask != 0) {
+                return first + __builtin_ctz(mask);
+            }
+            first += width;
+        }
+        return scalar_find_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX2
+    auto avx2_find_last_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+        using ops = avx2_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 32 / sizeof(T);
+
+        const T* end = last;
+        while (last - first > width) {
+            const T* base = last - 1 - width;
+            unsigned mask = avx2_adjacent_mask<ops>(avx2_load(base), avx2_load(base + 1), relation);
+            if (mask != 0) {
+                return base + (31 - __builtin_clz(mask));
+            }
+            last -= width;
+        }
+        auto res = scalar_find_last_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+        return res == last ? end : res;
+    }
+
+    template<typename T, typename Relation>
+    CPPSORT_TARGET_AVX2
+    auto avx2_count_adjacent_pairs(const T* first, const T* last, Relation relation) noexcept
+        -> std::ptrdiff_t
+    {
+        using ops = avx2_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 32 / sizeof(T);
+
+        std::ptrdiff_t count = 0;
+        while (last - first > width) {
+            unsigned mask = avx2_adjacent_mask<ops>(avx2_load(first), avx2_load(first + 1), relation);
+            count += __builtin_popcount(mask);
+            first += width;
+        }
+        return count + scalar_count_adjacent_pairs(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+#endif // CPPSORT_SIMD_X86
+
+    ////////////////////////////////////////////////////////////
+    // Runtime dispatch over contiguous arrays
+
+    template<typename T, typename Relation>
+    auto simd_find_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+#if CPPSORT_SIMD_X86
+        switch (runtime_simd_isa()) {
+            case simd_isa::avx512:
+                return avx512_find_adjacent_pair(first, last, relation);
+            case simd_isa::avx2:
+                return avx2_find_adjacent_pair(first, last, relation);
+            default:
+                break;
+        }
+#endif
+        return scalar_find_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+    template<typename T, typename Relation>
+    auto simd_find_last_adjacent_pair(const T* first, const T* last, Relation relation) noexcept
+        -> const T*
+    {
+#if CPPSORT_SIMD_X86
+        switch (runtime_simd_isa()) {
+            case simd_isa::avx512:
+                return avx512_find_last_adjacent_pair(first, last, relation);
+            case simd_isa::avx2:
+                return avx2_find_last_adjacent_pair(first, last, relation);
+            default:
+                break;
+        }
+#endif
+        return scalar_find_last_adjacent_pair(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+    template<typename T, typename Relation>
+    auto simd_count_adjacent_pairs(const T* first, const T* last, Relation relation) noexcept
+        -> std::ptrdiff_t
+    {
+#if CPPSORT_SIMD_X86
+        switch (runtime_simd_isa()) {
+            case simd_isa::avx512:
+                return avx512_count_adjacent_pairs(first, last, relation);
+            case simd_isa::avx2:
+                return avx2_count_adjacent_pairs(first, last, relation);
+            default:
+                break;
+        }
+#endif
+        return scalar_count_adjacent_pairs(first, last, relation, std::less<>{}, utility::identity{});
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Generic algorithms, using the vectorized kernels when the
+    // elements, comparison and projection allow it:
+    // - find_adjacent_pair returns the first iterator it such
+    //   that *it and *std::next(it) satisfy the relation
+    // - find_last_adjacent_pair returns the last such iterator
+    // - count_adjacent_pairs returns the number of such pairs
+    // The first two return last when there is no such pair
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto find_adjacent_pair(ForwardIterator first, ForwardIterator last, Relation relation,
+                            Compare compare, Projection projection, std::false_type)
+        -> ForwardIterator
+    {
+        return scalar_find_adjacent_pair(std::move(first), std::move(last), relation,
+                                         std::move(compare), std::move(projection));
+    }
+
+    template<typename ContiguousIterator, typename Relation, typename Compare, typename Projection>
+    auto find_adjacent_pair(ContiguousIterator first, ContiguousIterator last, Relation relation,
+                            Compare, Projection, std::true_type)
+        -> ContiguousIterator
+    {
+        if (first == last) {
+            return last;
+        }
+        auto data = simd_address(first);
+        return first + (simd_find_adjacent_pair(data, data + (last - first), relation) - data);
+    }
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto find_adjacent_pair(ForwardIterator first, ForwardIterator last, Relation relation,
+                            Compare compare, Projection projection)
+        -> ForwardIterator
+    {
+        return find_adjacent_pair(std::move(first), std::move(last), relation,
+                                  std::move(compare), std::move(projection),
+                                  is_simd_compatible<ForwardIterator, Compare, Projection>{});
+    }
+
+    template<typename BidirectionalIterator, typename Relation, typename Compare, typename Projection>
+    auto find_last_adjacent_pair(BidirectionalIterator first, BidirectionalIterator last,
+                                 Relation relation, Compare compare, Projection projection,
+                                 std::false_type)
+        -> BidirectionalIterator
+    {
+        return scalar_find_last_adjacent_pair(std::move(first), std::move(last), relation,
+                                              std::move(compare), std::move(projection));
+    }
+
+    template<typename ContiguousIterator, typename Relation, typename Compare, typename Projection>
+    auto find_last_adjacent_pair(ContiguousIterator first, ContiguousIterator last,
+                                 Relation relation, Compare, Projection, std::true_type)
+        -> ContiguousIterator
+    {
+        if (first == last) {
+            return last;
+        }
+        auto data = simd_address(first);
+        return first + (simd_find_last_adjacent_pair(data, data + (last - first), relation) - data);
+    }
+
+    template<typename BidirectionalIterator, typename Relation, typename Compare, typename Projection>
+    auto find_last_adjacent_pair(BidirectionalIterator first, BidirectionalIterator last,
+                                 Relation relation, Compare compare, Projection projection)
+        -> BidirectionalIterator
+    {
+        return find_last_adjacent_pair(std::move(first), std::move(last), relation,
+                                       std::move(compare), std::move(projection),
+                                       is_simd_compatible<BidirectionalIterator, Compare, Projection>{});
+    }
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto count_adjacent_pairs(ForwardIterator first, ForwardIterator last, Relation relation,
+                              Compare compare, Projection projection, std::false_type)
+        -> difference_type_t<ForwardIterator>
+    {
+        return scalar_count_adjacent_pairs(std::move(first), std::move(last), relation,
+                                           std::move(compare), std::move(projection));
+    }
+
+    template<typename ContiguousIterator, typename Relation, typename Compare, typename Projection>
+    auto count_adjacent_pairs(ContiguousIterator first, ContiguousIterator last, Relation relation,
+                              Compare, Projection, std::true_type)
+        -> difference_type_t<ContiguousIterator>
+    {
+        if (first == last) {
+            return 0;
+        }
+        auto data = simd_address(first);
+        return simd_count_adjacent_pairs(data, data + (last - first), relation);
+    }
+
+    template<typename ForwardIterator, typename Relation, typename Compare, typename Projection>
+    auto count_adjacent_pairs(ForwardIterator first, ForwardIterator last, Relation relation,
+                              Compare compare, Projection projection)
+        -> difference_type_t<ForwardIterator>
+    {
+        return count_adjacent_pairs(std::move(first), std::move(last), relation,
+                                    std::move(compare), std::move(projection),
+                                    is_simd_compatible<ForwardIterator, Compare, Projection>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_ADJACENT_FIND_H_
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_PARTITION_H_
+#define CPPSORT_DETAIL_SIMD_PARTITION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <cpp-sort/utility/static_const.h>
+#include "config.h"
+#include "memcpy_cast.h"
+#include "partition.h"
+#include "simd.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Vectorized partition
+    //
+    // In-place partitioning algorithm described by Bérenger
+    // Bramas in "A Novel Hybrid Quicksort Algorithm Vectorized
+    // using AVX-512 on Intel Skylake": one vector is set aside
+    // at both ends of the collection to make room, then vectors
+    // are read from the side with the least room left and their
+    // elements are written at the left or at the right of the
+    // room depending on how they compare to the pivot. AVX-512
+    // writes them with compress-store instructions, while AVX2
+    // first gathers them at both ends of the register with a
+    // permutation read from a table, then writes the whole
+    // register on both sides.
+    //
+    // The elements that don't fill a whole vector are handled
+    // last with scalar code, once every element has been read
+    // and the room is exactly as big as what remains to write.
+
+    // Signed integer type with the same size as the elements
+    template<typename T>
+    using simd_bits_t = conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+
+    template<typename T, typename Predicate>
+    auto simd_scalar_partition(T* first, T* last, T pivot, Predicate pred) noexcept
+        -> T*
+    {
+        return detail::partition(first, last, [&](T value) {
+            return simd_scalar_predicate(value, pivot, pred);
+        });
+    }
+
+    // Writes the elements of a buffer to both ends of the room
+    template<typename T, typename Predicate>
+    auto simd_partition_buffer(const T* buffer, std::ptrdiff_t size,
+                               T*& write_left, T*& write_right,
+                               T pivot, Predicate pred) noexcept
+        -> void
+    {
+        for (std::ptrdiff_t idx = 0 ; idx < size ; ++idx) {
+            if (simd_scalar_predicate(buffer[idx], pivot, pred)) {
+                *write_left++ = buffer[idx];
+            } else {
+                *--write_right = buffer[idx];
+            }
+        }
+    }
+
+#if CPPSORT_SIMD_X86
+
+    // Some versions of GCC 12 wrongly warn about uninitialized
+    // variables in their own implementation of AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // AVX-512 kernel
+
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_broadcast(std::int32_t bits) noexcept
+        -> __m512i
+    {
+        return _mm512_set1_epi32(bits);
+    }
+
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_broadcast(std::int64_t bits) noexcept
+        -> __m512i
+    {
+        return _mm512_set1_epi64(bits);
+    }
+
+    template<typename T>
+    CPPSORT_TARGET_AVX512_INLINE
+    auto avx512_partition_store(__m512i values, unsigned mask,
+                                T*& write_left, T*& write_right) noexcept
+        -> void
+    {
+        constexpr int width = 64 / sizeof(T);
+        int nb_left = __builtin_popcount(mask);
+        write_right -= width - nb_left;
+        if (sizeof(T) == 4) {
+            _mm512_mask_compressstoreu_epi32(write_left, static_cast<__mmask16>(mask), values);
+            _mm512_mask_compressstoreu_epi32(write_right, static_cast<__mmask16>(~mask), values);
+        } else {
+            _mm512_mask_compressstoreu_epi64(write_left, static_cast<__mmask8>(mask), values);
+            _mm512_mask_compressstoreu_epi64(write_right, static_cast<__mmask8>(~mask), values);
+        }
+        write_left += nb_left;
+    }
+
+    template<typename T, typename Predicate>
+    CPPSORT_TARGET_AVX512
+    auto avx512_partition(T* first, T* last, T pivot, Predicate pred) noexcept
+        -> T*
+    {
+        using ops = avx512_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 64 / sizeof(T);
+        if (last - first < 2 * width) {
+            return simd_scalar_partition(first, last, pivot, pred);
+        }
+
+        const __m512i pivots = avx512_broadcast(memcpy_cast<simd_bits_t<T>>(pivot));
+        const __m512i left = _mm512_loadu_si512(first);
+        const __m512i right = _mm512_loadu_si512(last - width);
+        T* read_left = first + width;
+        T* read_right = last - width;
+        T* write_left = first;
+        T* write_right = last;
+
+        while (read_right - read_left >= width) {
+            __m512i values;
+            if (read_left - write_left <= write_right - read_right) {
+                values = _mm512_loadu_si512(read_left);
+                read_left += width;
+            } else {
+                read_right -= width;
+                values = _mm512_loadu_si512(read_right);
+            }
+            avx512_partition_store(values, ops::mask(values, pivots, pred), write_left, write_right);
+        }
+
+        T buffer[width];
+        std::ptrdiff_t nb_remaining = read_right - read_left;
+        std::memcpy(buffer, read_left, nb_remaining * sizeof(T));
+        avx512_partition_store(left, ops::mask(left, pivots, pred), write_left, write_right);
+        avx512_partition_store(right, ops::mask(right, pivots, pred), write_left, write_right);
+        simd_partition_buffer(buffer, nb_remaining, write_left, write_right, pivot, pred);
+        return write_left;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // AVX2 kernel
+
+    // Permutations that move the elements selected by a mask to
+    // the beginning of a register and the other ones to its end,
+    // expressed in 32-bit lanes
+    template<std::size_t ElementSize>
+    struct avx2_partition_table
+    {
+        static constexpr std::size_t lanes_per_element = ElementSize / 4;
+        static constexpr std::size_t width = 8 / lanes_per_element;
+
+        alignas(32) std::int32_t indices[1u << width][8] = {};
+
+        constexpr avx2_partition_table()
+        {
+            for (std::size_t mask = 0 ; mask < (1u << width) ; ++mask) {
+                std::size_t pos = 0;
+                for (int selected = 1 ; selected >= 0 ; --selected) {
+                    for (std::size_t elem = 0 ; elem < width ; ++elem) {
+                        if (((mask >> elem) & 1u) != static_cast<std::size_t>(selected)) continue;
+                        for (std::size_t sub = 0 ; sub < lanes_per_element ; ++sub) {
+                            indices[mask][pos * lanes_per_element + sub] =
+                                static_cast<std::int32_t>(elem * lanes_per_element + sub);
+                        }
+                        ++pos;
+                    }
+                }
+            }
+        }
+    };
+
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_broadcast(std::int32_t bits) noexcept
+        -> __m256i
+    {
+        return _mm256_set1_epi32(bits);
+    }
+
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_broadcast(std::int64_t bits) noexcept
+        -> __m256i
+    {
+        return _mm256_set1_epi64x(bits);
+    }
+
+    template<typename T>
+    CPPSORT_TARGET_AVX2_INLINE
+    auto avx2_partition_store(__m256i values, unsigned mask,
+                              T*& write_left, T*& write_right) noexcept
+        -> void
+    {
+        constexpr int width = 32 / sizeof(T);
+        const auto& table = utility::static_const<avx2_partition_table<sizeof(T)>>::value;
+        __m256i permuted = _mm256_permutevar8x32_epi32(
+            values,
+            _mm256_load_si256(reinterpret_cast<const __m256i*>(table.indices[mask]))
+        );
+        int nb_left = __builtin_popcount(mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_left), permuted);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_right - width), permuted);
+        write_left += nb_left;
+        write_right -= width - nb_left;
+    }
+
+    template<typename T, typename Predicate>
+    CPPSORT_TARGET_AVX2
+    auto avx2_partition(T* first, T* last, T pivot, Predicate pred) noexcept
+        -> T*
+    {
+        using ops = avx2_compare_ops<simd_kind_of<T>::value>;
+        constexpr std::ptrdiff_t width = 32 / sizeof(T);
+        if (last - first < 2 * width) {
+            return simd_scalar_partition(first, last, pivot, pred);
+        }
+
+        // Whole registers are written on both sides, which is
+        // safe because there is always at least one vector of
+        // room on both sides once a vector has been read
+        const __m256i pivots = avx2_broadcast(memcpy_cast<simd_bits_t<T>>(pivot));
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last - width));
+        T* read_left = first + width;
+        T* read_right = last - width;
+        T* write_left = first;
+        T* write_right = last;
+
+        while (read_right - read_left >= width) {
+            __m256i values;
+            if (read_left - write_left <= write_right - read_right) {
+                values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(read_left));
+                read_left += width;
+            } else {
+                read_right -= width;
+                values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(read_right));
+            }
+            avx2_partition_store(values, ops::mask(values, pivots, pred), write_left, write_right);
+        }
+
+        // The room isn't big enough for whole registers anymore
+        T buffer[3 * width];
+        std::ptrdiff_t nb_remaining = read_right - read_left;
+        std::memcpy(buffer, read_left, nb_remaining * sizeof(T));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer + nb_remaining), left);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer + nb_remaining + width), right);
+        simd_partition_buffer(buffer, nb_remaining + 2 * width, write_left, write_right, pivot, pred);
+        return write_left;
+    }
+
+#endif // CPPSORT_SIMD_X86
+
+    ////////////////////////////////////////////////////////////
+    // Runtime dispatch, partitions [first, last) and returns an
+    // iterator to the first element of the right partition
+
+    template<typename T, typename Predicate>
+    auto simd_partition(T* first, T* last, T pivot, Predicate pred) noexcept
+        -> T*
+    {
+#if CPPSORT_SIMD_X86
+        switch (runtime_simd_isa()) {
+            case simd_isa::avx512:
+                return avx512_partition(first, last, pivot, pred);
+            case simd_isa::avx2:
+                return avx2_partition(first, last, pivot, pred);
+            default:
+                break;
+        }
+#endif
+        return simd_scalar_partition(first, last, pivot, pred);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_PARTITION_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022 Morwenn
+ * Copyright (c) 2017-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 
@@ -13,6 +13,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
@@ -21,6 +22,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
 #include "attributes.h"
@@ -28,7 +30,9 @@
 #include "memcpy_cast.h"
 #include "partition.h"
 #include "pdqsort.h"
+#include "scope_exit.h"
 #include "type_traits.h"
+#include "work_stealing_pool.h"
 
 namespace cppsort
 {
@@ -271,20 +275,43 @@ namespace detail
         SubKey<T>
     {};
 
-    template<typename T, typename Enable=void>
-    struct FallbackSubKey:
-        SubKey<decltype(to_radix_sort_key(std::declval<T>()))>
-    {
-        using base = SubKey<decltype(to_radix_sort_key(std::declval<T>()))>;
+    ////////////////////////////////////////////////////////////
+    // Customization point: a type that isn't handled natively
+    // can be radix sorted if a to_radix_sort_key function found
+    // by ADL maps it to a key that is, generally a std::tuple of
+    // references to its fields created with std::tie
 
+    template<typename T>
+    using radix_sort_key_t = remove_cvref_t<
+        decltype(to_radix_sort_key(std::declval<const T&>()))
+    >;
+
+    template<typename T>
+    using has_radix_sort_key = is_detected<radix_sort_key_t, T>;
+
+    template<typename T, typename Current>
+    struct RadixSortKeySubKey:
+        Current
+    {
         template<typename U>
-        static auto sub_key(U&& value, void* data)
+        static auto sub_key(U&& value, void* sort_data)
             -> decltype(auto)
         {
-            return base::sub_key(to_radix_sort_key(value), data);
+            return Current::sub_key(to_radix_sort_key(value), sort_data);
         }
+
+        using next = conditional_t<
+            std::is_same<SubKey<void>, typename Current::next>::value,
+            SubKey<void>,
+            RadixSortKeySubKey<T, typename Current::next>
+        >;
     };
 
+    template<typename T, typename Enable=void>
+    struct FallbackSubKey:
+        RadixSortKeySubKey<T, SubKey<radix_sort_key_t<T>>>
+    {};
+
     template<typename T>
     struct FallbackSubKey<T, detail::enable_if_t<not std::is_same<void, decltype(to_unsigned_or_bool(std::declval<T>()))>::value>>:
         SubKey<decltype(to_unsigned_or_bool(std::declval<T>()))>
@@ -475,11 +502,119 @@ namespace detail
         ListSubKey<T>
     {};
 
+    ////////////////////////////////////////////////////////////
+    // Small partitions are sorted with a comparison sort, which
+    // has to order the elements like the radix sort does: types
+    // with a to_radix_sort_key function are compared through
+    // their keys, including when they are part of a pair or of
+    // a tuple
+
+    template<typename T>
+    struct needs_radix_compare_key:
+        has_radix_sort_key<T>
+    {};
+
+    template<typename T, typename U>
+    struct needs_radix_compare_key<std::pair<T, U>>:
+        disjunction<
+            needs_radix_compare_key<remove_cvref_t<T>>,
+            needs_radix_compare_key<remove_cvref_t<U>>
+        >
+    {};
+
+    template<typename... Args>
+    struct needs_radix_compare_key<std::tuple<Args...>>:
+        disjunction<
+            needs_radix_compare_key<remove_cvref_t<Args>>...
+        >
+    {};
+
+    template<typename T, typename=void>
+    struct radix_compare_key
+    {
+        using type = const T&;
+
+        static auto get(const T& value)
+            -> type
+        {
+            return value;
+        }
+    };
+
+    template<typename T>
+    struct radix_compare_key<T, detail::enable_if_t<has_radix_sort_key<T>::value>>
+    {
+        using key_type = radix_sort_key_t<T>;
+        using type = remove_cvref_t<typename radix_compare_key<key_type>::type>;
+
+        static auto get(const T& value)
+            -> type
+        {
+            return radix_compare_key<key_type>::get(to_radix_sort_key(value));
+        }
+    };
+
+    template<typename... Args>
+    struct radix_compare_key<
+        std::tuple<Args...>,
+        detail::enable_if_t<needs_radix_compare_key<std::tuple<Args...>>::value>
+    >
+    {
+        using type = std::tuple<typename radix_compare_key<remove_cvref_t<Args>>::type...>;
+
+        static auto get(const std::tuple<Args...>& value)
+            -> type
+        {
+            return get(value, std::index_sequence_for<Args...>{});
+        }
+
+        template<std::size_t... Indices>
+        static auto get(const std::tuple<Args...>& value, std::index_sequence<Indices...>)
+            -> type
+        {
+            return type(radix_compare_key<remove_cvref_t<Args>>::get(std::get<Indices>(value))...);
+        }
+    };
+
+    template<typename T, typename U>
+    struct radix_compare_key<
+        std::pair<T, U>,
+        detail::enable_if_t<needs_radix_compare_key<std::pair<T, U>>::value>
+    >
+    {
+        using type = std::tuple<
+            typename radix_compare_key<remove_cvref_t<T>>::type,
+            typename radix_compare_key<remove_cvref_t<U>>::type
+        >;
+
+        static auto get(const std::pair<T, U>& value)
+            -> type
+        {
+            return type(radix_compare_key<remove_cvref_t<T>>::get(value.first),
+                        radix_compare_key<remove_cvref_t<U>>::get(value.second));
+        }
+    };
+
+    struct radix_key_less
+    {
+        template<typename T>
+        auto operator()(const T& lhs, const T& rhs) const
+            -> bool
+        {
+            return radix_compare_key<T>::get(lhs) < radix_compare_key<T>::get(rhs);
+        }
+    };
+
     template<typename RandomAccessIterator, typename Projection>
     auto StdSortFallback(RandomAccessIterator begin, RandomAccessIterator end, Projection projection)
         -> void
     {
-        pdqsort(std::move(begin), std::move(end), std::less<>{}, std::move(projection));
+        using compare_type = conditional_t<
+            needs_radix_compare_key<projected_t<RandomAccessIterator, Projection>>::value,
+            radix_key_less,
+            std::less<>
+        >;
+        pdqsort(std::move(begin), std::move(end), compare_type{}, std::move(projection));
     }
 
     template<std::ptrdiff_t StdSortThreshold, typename RandomAccessIterator, typename Projection>
@@ -497,6 +632,40 @@ namespace detail
         return true;
     }
 
+    ////////////////////////////////////////////////////////////
+    // Parallel mode
+    //
+    // When a work-stealing pool is registered for the current
+    // thread, the byte distribution of big partitions is split
+    // among the threads of the pool, and the partitions that
+    // result from it are sorted as independent tasks
+
+    // Partitions smaller than this size are distributed sequentially
+    constexpr std::ptrdiff_t ska_sort_parallel_threshold = 1 << 16;
+
+    // Minimal number of elements handled by a thread when
+    // distributing the elements of a partition in parallel
+    constexpr std::ptrdiff_t ska_sort_min_stripe_size = 1 << 14;
+
+    inline auto ska_sort_pool() noexcept
+        -> work_stealing_pool*&
+    {
+        static thread_local work_stealing_pool* pool = nullptr;
+        return pool;
+    }
+
+    template<typename Function>
+    auto with_ska_sort_pool(work_stealing_pool* pool, Function&& func)
+        -> void
+    {
+        auto& current_pool = ska_sort_pool();
+        auto previous_pool = std::exchange(current_pool, pool);
+        auto restore_pool = make_scope_exit([&] {
+            current_pool = previous_pool;
+        });
+        std::forward<Function>(func)();
+    }
+
     template<std::ptrdiff_t StdSortThreshold, std::ptrdiff_t AmericanFlagSortThreshold,
              typename CurrentSubKey, typename SubKeyType=typename CurrentSubKey::sub_key_type>
     struct InplaceSorter;
@@ -519,6 +688,15 @@ namespace detail
                          void* sort_data)
             -> void
         {
+            if (num_elements >= ska_sort_parallel_threshold) {
+                work_stealing_pool* pool = ska_sort_pool();
+                if (pool != nullptr && pool->thread_count() > 1) {
+                    parallel_byte_sort(std::move(begin), num_elements, std::move(projection),
+                                       next_sort, sort_data, *pool);
+                    return;
+                }
+            }
+
             if (num_elements < AmericanFlagSortThreshold) {
                 american_flag_sort(std::move(begin), std::move(end), std::move(projection),
                                    next_sort, sort_data);
@@ -674,6 +852,170 @@ namespace detail
                 }
             }
         }
+
+        // In-place parallel distribution in the spirit of PARADIS: every
+        // thread counts the bytes of a stripe of the partition, then the
+        // remaining part of every bucket is split among the threads, which
+        // speculatively move the elements of their stripes to the slots
+        // they own; a repair step then gathers the elements that could not
+        // be placed at the end of their current bucket. The process starts
+        // again until every element is in its bucket, falling back to a
+        // single stripe - which places every remaining element - when the
+        // remaining elements are too few or when a round did not progress
+        template<typename RandomAccessIterator, typename Projection>
+        static auto parallel_byte_sort(RandomAccessIterator begin, std::ptrdiff_t num_elements, Projection projection,
+                                       void (*next_sort)(RandomAccessIterator, RandomAccessIterator, std::ptrdiff_t, Projection, void*),
+                                       void* sort_data, work_stealing_pool& pool)
+            -> void
+        {
+            using utility::iter_swap;
+            auto&& proj = utility::as_function(projection);
+            auto byte_at = [&proj, begin, sort_data](std::ptrdiff_t pos) -> int {
+                return current_byte(proj(begin[pos]), sort_data);
+            };
+
+            std::ptrdiff_t max_stripes = (std::min)(static_cast<std::ptrdiff_t>(pool.thread_count()),
+                                                    num_elements / ska_sort_min_stripe_size);
+            work_stealing_pool::task_group group;
+
+            // Per-stripe histograms
+            std::vector<std::ptrdiff_t> counts(max_stripes * 256, 0);
+            for (std::ptrdiff_t stripe = 0 ; stripe < max_stripes ; ++stripe) {
+                pool.submit(group, [&, stripe] {
+                    auto first = stripe * num_elements / max_stripes;
+                    auto last = (stripe + 1) * num_elements / max_stripes;
+                    std::ptrdiff_t* stripe_counts = counts.data() + stripe * 256;
+                    for (auto pos = first ; pos != last ; ++pos) {
+                        ++stripe_counts[byte_at(pos)];
+                    }
+                });
+            }
+            pool.wait(group);
+
+            // heads[i] is the first element of bucket i that is not known to
+            // be in place yet, bucket i ends at tails[i]
+            std::ptrdiff_t bucket_starts[256];
+            std::ptrdiff_t heads[256];
+            std::ptrdiff_t tails[256];
+            std::ptrdiff_t total = 0;
+            for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                bucket_starts[bucket] = heads[bucket] = total;
+                for (std::ptrdiff_t stripe = 0 ; stripe < max_stripes ; ++stripe) {
+                    total += counts[stripe * 256 + bucket];
+                }
+                tails[bucket] = total;
+            }
+
+            // Slots owned by every stripe in every bucket: elements in
+            // [starts, heads) have been placed during the current round
+            std::vector<std::ptrdiff_t> stripe_starts(max_stripes * 256);
+            std::vector<std::ptrdiff_t> stripe_heads(max_stripes * 256);
+            std::vector<std::ptrdiff_t> stripe_tails(max_stripes * 256);
+
+            auto permute = [&](std::ptrdiff_t stripe) {
+                std::ptrdiff_t* ph = stripe_heads.data() + stripe * 256;
+                const std::ptrdiff_t* pt = stripe_tails.data() + stripe * 256;
+                for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                    for (auto pos = ph[bucket] ; pos < pt[bucket] ; ++pos) {
+                        int value = byte_at(pos);
+                        while (value != bucket && ph[value] < pt[value]) {
+                            iter_swap(begin + pos, begin + ph[value]++);
+                            value = byte_at(pos);
+                        }
+                        if (value == bucket) {
+                            // Elements in [ph[bucket], pos) could not be placed
+                            if (pos != ph[bucket]) {
+                                iter_swap(begin + pos, begin + ph[bucket]);
+                            }
+                            ++ph[bucket];
+                        }
+                    }
+                }
+            };
+
+            auto repair = [&](int bucket, std::ptrdiff_t nb_stripes) {
+                // The elements that could not be placed are the only ones of
+                // the bucket that do not belong to it, move them to its end
+                std::ptrdiff_t new_head = heads[bucket];
+                for (std::ptrdiff_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                    auto idx = stripe * 256 + bucket;
+                    new_head += stripe_heads[idx] - stripe_starts[idx];
+                }
+                std::ptrdiff_t placed = new_head;
+                for (std::ptrdiff_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                    auto idx = stripe * 256 + bucket;
+                    auto last = (std::min)(stripe_tails[idx], new_head);
+                    for (auto pos = stripe_heads[idx] ; pos < last ; ++pos) {
+                        while (byte_at(placed) != bucket) {
+                            ++placed;
+                        }
+                        iter_swap(begin + pos, begin + placed);
+                        ++placed;
+                    }
+                }
+                heads[bucket] = new_head;
+            };
+
+            std::ptrdiff_t remaining = num_elements;
+            bool progressed = true;
+            while (remaining > 0) {
+                std::ptrdiff_t nb_stripes = 1;
+                if (progressed) {
+                    nb_stripes = (std::min)(max_stripes, remaining / ska_sort_min_stripe_size);
+                    nb_stripes = (std::max)(nb_stripes, std::ptrdiff_t(1));
+                }
+
+                for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                    auto size = tails[bucket] - heads[bucket];
+                    for (std::ptrdiff_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                        auto idx = stripe * 256 + bucket;
+                        stripe_starts[idx] = stripe_heads[idx] = heads[bucket] + stripe * size / nb_stripes;
+                        stripe_tails[idx] = heads[bucket] + (stripe + 1) * size / nb_stripes;
+                    }
+                }
+
+                if (nb_stripes == 1) {
+                    permute(0);
+                    for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                        repair(bucket, 1);
+                    }
+                } else {
+                    for (std::ptrdiff_t stripe = 0 ; stripe < nb_stripes ; ++stripe) {
+                        pool.submit(group, [&, stripe] { permute(stripe); });
+                    }
+                    pool.wait(group);
+                    for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                        if (heads[bucket] != tails[bucket]) {
+                            pool.submit(group, [&, bucket, nb_stripes] { repair(bucket, nb_stripes); });
+                        }
+                    }
+                    pool.wait(group);
+                }
+
+                std::ptrdiff_t new_remaining = 0;
+                for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                    new_remaining += tails[bucket] - heads[bucket];
+                }
+                progressed = new_remaining < remaining;
+                remaining = new_remaining;
+            }
+
+            // Sort the buckets independently
+            if (Offset + 1 != NumBytes || next_sort) {
+                for (int bucket = 0 ; bucket < 256 ; ++bucket) {
+                    std::ptrdiff_t size = tails[bucket] - bucket_starts[bucket];
+                    if (size < 2) continue;
+                    auto partition_begin = begin + bucket_starts[bucket];
+                    pool.submit(group, [=, &pool] {
+                        with_ska_sort_pool(&pool, [&] {
+                            sort_partition(partition_begin, partition_begin + size, size,
+                                           projection, next_sort, sort_data);
+                        });
+                    });
+                }
+                pool.wait(group);
+            }
+        }
     };
 
     template<std::ptrdiff_t StdSortThreshold, std::ptrdiff_t AmericanFlagSortThreshold,
@@ -741,7 +1083,15 @@ namespace detail
 
             std::size_t current_index = sort_data->current_index;
             void* next_sort_data = sort_data->next_sort_data;
-            auto current_key = [&](auto&& elem) -> decltype(auto) {
+            // When the projection returns a temporary, the list has
+            // to be copied to outlive the call to current_key
+            using key_type = decltype(CurrentSubKey::sub_key(proj(*begin), next_sort_data));
+            using safe_key_type = conditional_t<
+                std::is_reference<decltype(proj(*begin))>::value,
+                key_type,
+                remove_cvref_t<key_type>
+            >;
+            auto current_key = [&](auto&& elem) -> safe_key_type {
                 return CurrentSubKey::sub_key(proj(elem), next_sort_data);
             };
             auto element_key = [&](auto&& elem) -> decltype(auto) {
@@ -925,6 +1275,23 @@ namespace detail
                                               std::move(projection));
     }
 
+    template<typename RandomAccessIterator, typename Projection>
+    auto parallel_ska_sort(RandomAccessIterator begin, RandomAccessIterator end,
+                           Projection projection,
+                           std::size_t nb_threads=default_thread_count())
+        -> void
+    {
+        if (nb_threads < 2 || end - begin < ska_sort_parallel_threshold) {
+            ska_sort(std::move(begin), std::move(end), std::move(projection));
+            return;
+        }
+
+        work_stealing_pool pool(nb_threads);
+        with_ska_sort_pool(&pool, [&] {
+            ska_sort(std::move(begin), std::move(end), std::move(projection));
+        });
+    }
+
     ////////////////////////////////////////////////////////////
     // Whether a type is sortable with ska_sort
 
@@ -948,7 +1315,8 @@ namespace detail
     struct is_ska_sortable:
         disjunction<
             is_integral<T>,
-            is_index_ska_sortable<has_indexing_operator_t, T>
+            is_index_ska_sortable<has_indexing_operator_t, T>,
+            is_index_ska_sortable<radix_sort_key_t, T>
         >
     {};
 
@@ -976,15 +1344,15 @@ namespace detail
     template<typename T, typename U>
     struct is_ska_sortable<std::pair<T, U>>:
         conjunction<
-            is_ska_sortable<T>,
-            is_ska_sortable<U>
+            is_ska_sortable<remove_cvref_t<T>>,
+            is_ska_sortable<remove_cvref_t<U>>
         >
     {};
 
     template<typename... Args>
     struct is_ska_sortable<std::tuple<Args...>>:
         conjunction<
-            is_ska_sortable<Args>...
+            is_ska_sortable<remove_cvref_t<Args>>...
         >
     {};
 
@@ -0,0 +1,744 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+#define CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/static_const.h>
+#include "../simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Vectorized sorting networks
+    //
+    // The elements to sort are loaded in a few SIMD registers
+    // and the comparators of the sorting network are scheduled
+    // in layers of independent comparators. Every layer is then
+    // executed as a handful of permutations that gather, for
+    // every element, the element it is compared to, followed
+    // by a min/max of every register and a blend that keeps
+    // the min or the max depending on the side of the element
+    // in its comparator. The network is the same as the scalar
+    // one, and the min/max operations match iter_swap_if, even
+    // for floating point numbers.
+    //
+    // The permutations to perform for every layer are computed
+    // once per size of network, element size and register size
+    // from the index pairs of the scalar network.
+
+    // Depth of the network, where every comparator is scheduled
+    // right after the last comparator that touched its elements
+
+    template<std::size_t N>
+    constexpr auto simd_network_pair_layers(int* layers)
+        -> int
+    {
+        constexpr auto pairs = sorting_network_sorter_impl<N>::template index_pairs<int>();
+        int depths[N] = {};
+        int depth = 0;
+        for (std::size_t idx = 0 ; idx < pairs.size() ; ++idx) {
+            auto first = pairs[idx].first;
+            auto second = pairs[idx].second;
+            int layer = depths[first] > depths[second] ? depths[first] : depths[second];
+            depths[first] = depths[second] = layer + 1;
+            layers[idx] = layer;
+            if (layer + 1 > depth) {
+                depth = layer + 1;
+            }
+        }
+        return depth;
+    }
+
+    template<std::size_t N>
+    constexpr auto simd_network_depth()
+        -> std::size_t
+    {
+        int layers[sorting_network_sorter_impl<N>::template index_pairs<int>().size()] = {};
+        return static_cast<std::size_t>(simd_network_pair_layers<N>(layers));
+    }
+
+    // Number of (destination, source) register pairs that require
+    // a permutation over the whole network
+
+    template<std::size_t N, std::size_t ElementsPerRegister>
+    constexpr auto simd_network_moves()
+        -> std::size_t
+    {
+        constexpr auto pairs = sorting_network_sorter_impl<N>::template index_pairs<int>();
+        constexpr std::size_t nb_registers = (N + ElementsPerRegister - 1) / ElementsPerRegister;
+        int layers[pairs.size()] = {};
+        int depth = simd_network_pair_layers<N>(layers);
+
+        std::size_t nb_moves = 0;
+        for (int layer = 0 ; layer < depth ; ++layer) {
+            bool needed[nb_registers][nb_registers] = {};
+            for (std::size_t idx = 0 ; idx < pairs.size() ; ++idx) {
+                if (layers[idx] != layer) continue;
+                std::size_t first = pairs[idx].first / ElementsPerRegister;
+                std::size_t second = pairs[idx].second / ElementsPerRegister;
+                needed[first][second] = true;
+                needed[second][first] = true;
+            }
+            for (std::size_t dest = 0 ; dest < nb_registers ; ++dest) {
+                for (std::size_t src = 0 ; src < nb_registers ; ++src) {
+                    nb_moves += needed[dest][src];
+                }
+            }
+        }
+        return nb_moves;
+    }
+
+    // Program of a vectorized network: every layer is made of
+    // moves, each of which gathers into the lanes selected by
+    // its mask of a destination register the lanes of a source
+    // register holding the partners of its elements, followed
+    // by an exchange that keeps the min or the max of every
+    // pair of partners. Lanes are 32-bit lanes, and a 64-bit
+    // element spans two consecutive lanes.
+
+    struct simd_network_step
+    {
+        // Exchange step when true, move otherwise
+        bool exchange = false;
+        std::size_t layer = 0;
+        std::size_t destination = 0;
+        std::size_t source = 0;
+        // First move into the destination during the layer:
+        // lanes outside of the mask come from the destination
+        // register itself instead of the previous moves
+        bool first = false;
+        // Whether the mask covers every lane of the destination
+        bool full = false;
+        std::int32_t indices[16] = {};
+        std::uint32_t mask = 0;
+    };
+
+    template<std::size_t N, std::size_t ElementSize, std::size_t RegisterSize>
+    struct simd_network_program
+    {
+        static constexpr std::size_t size = N;
+        static constexpr std::size_t lanes = RegisterSize / 4;
+        static constexpr std::size_t lanes_per_element = ElementSize / 4;
+        static constexpr std::size_t elements_per_register = RegisterSize / ElementSize;
+        static constexpr std::size_t nb_registers = (N + elements_per_register - 1) / elements_per_register;
+        static constexpr std::size_t nb_layers = simd_network_depth<N>();
+        static constexpr std::size_t nb_steps = simd_network_moves<N, elements_per_register>() + nb_layers;
+
+        simd_network_step steps[nb_steps] = {};
+        // Lanes that keep the min and the max of their comparator
+        std::uint32_t min_mask[nb_layers][nb_registers] = {};
+        std::uint32_t max_mask[nb_layers][nb_registers] = {};
+
+        constexpr simd_network_program()
+        {
+            constexpr auto pairs = sorting_network_sorter_impl<N>::template index_pairs<int>();
+            int pair_layers[pairs.size()] = {};
+            simd_network_pair_layers<N>(pair_layers);
+
+            std::size_t step_idx = 0;
+            for (std::size_t layer = 0 ; layer < nb_layers ; ++layer) {
+                // Element every element is compared to during this layer
+                std::size_t partners[N] = {};
+                bool takes_max[N] = {};
+                for (std::size_t idx = 0 ; idx < N ; ++idx) {
+                    partners[idx] = idx;
+                }
+                for (std::size_t idx = 0 ; idx < pairs.size() ; ++idx) {
+                    if (pair_layers[idx] != static_cast<int>(layer)) continue;
+                    auto first = static_cast<std::size_t>(pairs[idx].first);
+                    auto second = static_cast<std::size_t>(pairs[idx].second);
+                    partners[first] = second;
+                    partners[second] = first;
+                    takes_max[second] = true;
+                }
+
+                for (std::size_t dest = 0 ; dest < nb_registers ; ++dest) {
+                    // Lanes of the last register past the end of the
+                    // collection don't matter
+                    std::uint32_t valid_lanes = 0;
+                    for (std::size_t elem = 0 ; elem < elements_per_register ; ++elem) {
+                        std::size_t idx = dest * elements_per_register + elem;
+                        if (idx >= N) break;
+                        for (std::size_t sub = 0 ; sub < lanes_per_element ; ++sub) {
+                            auto lane = elem * lanes_per_element + sub;
+                            valid_lanes |= std::uint32_t(1) << lane;
+                            if (partners[idx] == idx) continue;
+                            if (takes_max[idx]) {
+                                max_mask[layer][dest] |= std::uint32_t(1) << lane;
+                            } else {
+                                min_mask[layer][dest] |= std::uint32_t(1) << lane;
+                            }
+                        }
+                    }
+
+                    bool first = true;
+                    for (std::size_t src = 0 ; src < nb_registers ; ++src) {
+                        simd_network_step move;
+                        move.layer = layer;
+                        move.destination = dest;
+                        move.source = src;
+                        for (std::size_t elem = 0 ; elem < elements_per_register ; ++elem) {
+                            std::size_t idx = dest * elements_per_register + elem;
+                            if (idx >= N) break;
+                            auto partner = partners[idx];
+                            if (partner == idx || partner / elements_per_register != src) continue;
+                            for (std::size_t sub = 0 ; sub < lanes_per_element ; ++sub) {
+                                auto lane = elem * lanes_per_element + sub;
+                                auto src_lane = (partner % elements_per_register) * lanes_per_element + sub;
+                                move.indices[lane] = static_cast<std::int32_t>(src_lane);
+                                move.mask |= std::uint32_t(1) << lane;
+                            }
+                        }
+                        if (move.mask != 0) {
+                            move.first = first;
+                            move.full = first && (move.mask == valid_lanes);
+                            first = false;
+                            steps[step_idx] = move;
+                            ++step_idx;
+                        }
+                    }
+                }
+
+                simd_network_step exchange;
+                exchange.exchange = true;
+                exchange.layer = layer;
+                steps[step_idx] = exchange;
+                ++step_idx;
+            }
+        }
+    };
+
+#if CPPSORT_SIMD_X86
+
+    ////////////////////////////////////////////////////////////
+    // Min/max operations for every type of element: both are
+    // called with (partner, element) so that an element is only
+    // replaced by its partner when they compare strictly, which
+    // matches iter_swap_if when floating point numbers compare
+    // equal or unordered
+
+    template<simd_kind Kind>
+    struct avx2_minmax;
+
+    template<>
+    struct avx2_minmax<simd_kind::int32>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept -> __m256i { return _mm256_min_epi32(lhs, rhs); }
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept -> __m256i { return _mm256_max_epi32(lhs, rhs); }
+    };
+
+    template<>
+    struct avx2_minmax<simd_kind::uint32>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept -> __m256i { return _mm256_min_epu32(lhs, rhs); }
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept -> __m256i { return _mm256_max_epu32(lhs, rhs); }
+    };
+
+    template<>
+    struct avx2_minmax<simd_kind::int64>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_blendv_epi8(rhs, lhs, _mm256_cmpgt_epi64(lhs, rhs));
+        }
+    };
+
+    template<>
+    struct avx2_minmax<simd_kind::uint64>
+    {
+        // AVX2 only has a signed 64-bit comparison, flipping the sign
+        // bit of both operands gives the unsigned comparison
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto greater(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(lhs, sign_bit), _mm256_xor_si256(rhs, sign_bit));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_blendv_epi8(lhs, rhs, greater(lhs, rhs));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_blendv_epi8(rhs, lhs, greater(lhs, rhs));
+        }
+    };
+
+    template<>
+    struct avx2_minmax<simd_kind::float32>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs)));
+        }
+    };
+
+    template<>
+    struct avx2_minmax<simd_kind::float64>
+    {
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto min(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs)));
+        }
+
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto max(__m256i lhs, __m256i rhs) noexcept
+            -> __m256i
+        {
+            return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs)));
+        }
+    };
+
+    // Some versions of GCC 12 wrongly warn about uninitialized
+    // variables in their own implementation of AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+    template<simd_kind Kind>
+    struct avx512_minmax;
+
+    template<>
+    struct avx512_minmax<simd_kind::int32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_min_epi32(lhs, rhs); }
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_max_epi32(lhs, rhs); }
+    };
+
+    template<>
+    struct avx512_minmax<simd_kind::uint32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_min_epu32(lhs, rhs); }
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_max_epu32(lhs, rhs); }
+    };
+
+    template<>
+    struct avx512_minmax<simd_kind::int64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_min_epi64(lhs, rhs); }
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_max_epi64(lhs, rhs); }
+    };
+
+    template<>
+    struct avx512_minmax<simd_kind::uint64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_min_epu64(lhs, rhs); }
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept -> __m512i { return _mm512_max_epu64(lhs, rhs); }
+    };
+
+    template<>
+    struct avx512_minmax<simd_kind::float32>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept
+            -> __m512i
+        {
+            return _mm512_castps_si512(_mm512_min_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept
+            -> __m512i
+        {
+            return _mm512_castps_si512(_mm512_max_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+        }
+    };
+
+    template<>
+    struct avx512_minmax<simd_kind::float64>
+    {
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto min(__m512i lhs, __m512i rhs) noexcept
+            -> __m512i
+        {
+            return _mm512_castpd_si512(_mm512_min_pd(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs)));
+        }
+
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto max(__m512i lhs, __m512i rhs) noexcept
+            -> __m512i
+        {
+            return _mm512_castpd_si512(_mm512_max_pd(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs)));
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Kernels
+    //
+    // Every step of the program is expanded at compile time so
+    // that register indices, permutation indices and masks are
+    // all constants, which allows the compiler to keep the whole
+    // collection in registers and to use immediate blends
+
+    template<typename Program>
+    constexpr auto simd_network_step_at(std::size_t idx)
+        -> const simd_network_step&
+    {
+        return utility::static_const<Program>::value.steps[idx];
+    }
+
+    template<typename Program, typename T>
+    struct avx2_network
+    {
+        using minmax = avx2_minmax<simd_kind_of<T>::value>;
+        static constexpr std::size_t nb_registers = Program::nb_registers;
+        static constexpr std::size_t elements_per_register = Program::elements_per_register;
+        static constexpr std::size_t tail_lanes = (Program::size - (nb_registers - 1) * elements_per_register)
+                                                * Program::lanes_per_element;
+
+        template<std::size_t Step>
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto move(__m256i* registers, __m256i* partners) noexcept
+            -> void
+        {
+            constexpr const simd_network_step& step = simd_network_step_at<Program>(Step);
+            constexpr auto dest = step.destination;
+            __m256i gathered = _mm256_permutevar8x32_epi32(
+                registers[step.source],
+                _mm256_setr_epi32(step.indices[0], step.indices[1], step.indices[2], step.indices[3],
+                                  step.indices[4], step.indices[5], step.indices[6], step.indices[7])
+            );
+            if (step.full) {
+                partners[dest] = gathered;
+            } else {
+                constexpr int mask = static_cast<int>(step.mask);
+                partners[dest] = _mm256_blend_epi32(step.first ? registers[dest] : partners[dest],
+                                                    gathered, mask);
+            }
+        }
+
+        template<std::size_t Layer, std::size_t Idx>
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto exchange(__m256i* registers, const __m256i* partners) noexcept
+            -> void
+        {
+            constexpr auto min_mask = utility::static_const<Program>::value.min_mask[Layer][Idx];
+            constexpr auto max_mask = utility::static_const<Program>::value.max_mask[Layer][Idx];
+            if (max_mask == 0) {
+                if (min_mask != 0) {
+                    registers[Idx] = minmax::min(partners[Idx], registers[Idx]);
+                }
+            } else if (min_mask == 0) {
+                registers[Idx] = minmax::max(partners[Idx], registers[Idx]);
+            } else {
+                registers[Idx] = _mm256_blend_epi32(minmax::min(partners[Idx], registers[Idx]),
+                                                    minmax::max(partners[Idx], registers[Idx]),
+                                                    static_cast<int>(max_mask));
+            }
+        }
+
+        template<std::size_t Layer, std::size_t... Indices>
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto exchange(__m256i* registers, const __m256i* partners,
+                             std::index_sequence<Indices...>) noexcept
+            -> void
+        {
+            using expander = int[];
+            (void) expander{ 0, (exchange<Layer, Indices>(registers, partners), 0)... };
+        }
+
+        template<std::size_t Step>
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto run_step(__m256i* registers, __m256i* partners) noexcept
+            -> void
+        {
+            constexpr const simd_network_step& step = simd_network_step_at<Program>(Step);
+            if (step.exchange) {
+                exchange<step.layer>(registers, partners, std::make_index_sequence<nb_registers>{});
+            } else {
+                move<Step>(registers, partners);
+            }
+        }
+
+        template<std::size_t... Steps>
+        CPPSORT_TARGET_AVX2_INLINE
+        static auto run(T* data, std::index_sequence<Steps...>) noexcept
+            -> void
+        {
+            const __m256i tail_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(tail_lanes),
+                                                         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i registers[nb_registers];
+            __m256i partners[nb_registers];
+            for (std::size_t idx = 0 ; idx < nb_registers - 1 ; ++idx) {
+                registers[idx] = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(data + idx * elements_per_register)
+                );
+            }
+            registers[nb_registers - 1] = _mm256_maskload_epi32(
+                reinterpret_cast<const int*>(data + (nb_registers - 1) * elements_per_register),
+                tail_mask
+            );
+
+            using expander = int[];
+            (void) expander{ 0, (run_step<Steps>(registers, partners), 0)... };
+
+            for (std::size_t idx = 0 ; idx < nb_registers - 1 ; ++idx) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + idx * elements_per_register),
+                                    registers[idx]);
+            }
+            _mm256_maskstore_epi32(
+                reinterpret_cast<int*>(data + (nb_registers - 1) * elements_per_register),
+                tail_mask, registers[nb_registers - 1]
+            );
+        }
+    };
+
+    template<std::size_t N, typename T>
+    CPPSORT_TARGET_AVX2
+    auto avx2_network_sort(T* data) noexcept
+        -> void
+    {
+        using program_type = simd_network_program<N, sizeof(T), 32>;
+        avx2_network<program_type, T>::run(data, std::make_index_sequence<program_type::nb_steps>{});
+    }
+
+    template<typename Program, typename T>
+    struct avx512_network
+    {
+        using minmax = avx512_minmax<simd_kind_of<T>::value>;
+        static constexpr std::size_t nb_registers = Program::nb_registers;
+        static constexpr std::size_t elements_per_register = Program::elements_per_register;
+        static constexpr std::size_t tail_lanes = (Program::size - (nb_registers - 1) * elements_per_register)
+                                                * Program::lanes_per_element;
+
+        template<std::size_t Step>
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto move(__m512i* registers, __m512i* partners) noexcept
+            -> void
+        {
+            constexpr const simd_network_step& step = simd_network_step_at<Program>(Step);
+            constexpr auto dest = step.destination;
+            const __m512i indices = _mm512_setr_epi32(
+                step.indices[0], step.indices[1], step.indices[2], step.indices[3],
+                step.indices[4], step.indices[5], step.indices[6], step.indices[7],
+                step.indices[8], step.indices[9], step.indices[10], step.indices[11],
+                step.indices[12], step.indices[13], step.indices[14], step.indices[15]
+            );
+            if (step.full) {
+                partners[dest] = _mm512_permutexvar_epi32(indices, registers[step.source]);
+            } else {
+                constexpr auto mask = static_cast<__mmask16>(step.mask);
+                partners[dest] = _mm512_mask_permutexvar_epi32(
+                    step.first ? registers[dest] : partners[dest],
+                    mask, indices, registers[step.source]
+                );
+            }
+        }
+
+        template<std::size_t Layer, std::size_t Idx>
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto exchange(__m512i* registers, const __m512i* partners) noexcept
+            -> void
+        {
+            constexpr auto min_mask = utility::static_const<Program>::value.min_mask[Layer][Idx];
+            constexpr auto max_mask = utility::static_const<Program>::value.max_mask[Layer][Idx];
+            if (max_mask == 0) {
+                if (min_mask != 0) {
+                    registers[Idx] = minmax::min(partners[Idx], registers[Idx]);
+                }
+            } else if (min_mask == 0) {
+                registers[Idx] = minmax::max(partners[Idx], registers[Idx]);
+            } else {
+                registers[Idx] = _mm512_mask_blend_epi32(static_cast<__mmask16>(max_mask),
+                                                         minmax::min(partners[Idx], registers[Idx]),
+                                                         minmax::max(partners[Idx], registers[Idx]));
+            }
+        }
+
+        template<std::size_t Layer, std::size_t... Indices>
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto exchange(__m512i* registers, const __m512i* partners,
+                             std::index_sequence<Indices...>) noexcept
+            -> void
+        {
+            using expander = int[];
+            (void) expander{ 0, (exchange<Layer, Indices>(registers, partners), 0)... };
+        }
+
+        template<std::size_t Step>
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto run_step(__m512i* registers, __m512i* partners) noexcept
+            -> void
+        {
+            constexpr const simd_network_step& step = simd_network_step_at<Program>(Step);
+            if (step.exchange) {
+                exchange<step.layer>(registers, partners, std::make_index_sequence<nb_registers>{});
+            } else {
+                move<Step>(registers, partners);
+            }
+        }
+
+        template<std::size_t... Steps>
+        CPPSORT_TARGET_AVX512_INLINE
+        static auto run(T* data, std::index_sequence<Steps...>) noexcept
+            -> void
+        {
+            constexpr auto tail_mask = static_cast<__mmask16>((std::uint32_t(1) << tail_lanes) - 1);
+            __m512i registers[nb_registers];
+            __m512i partners[nb_registers];
+            for (std::size_t idx = 0 ; idx < nb_registers - 1 ; ++idx) {
+                registers[idx] = _mm512_loadu_si512(data + idx * elements_per_register);
+            }
+            registers[nb_registers - 1] = _mm512_maskz_loadu_epi32(
+                tail_mask, data + (nb_registers - 1) * elements_per_register
+            );
+
+            using expander = int[];
+            (void) expander{ 0, (run_step<Steps>(registers, partners), 0)... };
+
+            for (std::size_t idx = 0 ; idx < nb_registers - 1 ; ++idx) {
+                _mm512_storeu_si512(data + idx * elements_per_register, registers[idx]);
+            }
+            _mm512_mask_storeu_epi32(data + (nb_registers - 1) * elements_per_register,
+                                     tail_mask, registers[nb_registers - 1]);
+        }
+    };
+
+    template<std::size_t N, typename T>
+    CPPSORT_TARGET_AVX512
+    auto avx512_network_sort(T* data) noexcept
+        -> void
+    {
+        using program_type = simd_network_program<N, sizeof(T), 64>;
+        avx512_network<program_type, T>::run(data, std::make_index_sequence<program_type::nb_steps>{});
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+#endif // CPPSORT_SIMD_X86
+
+    ////////////////////////////////////////////////////////////
+    // Runtime dispatch, returns whether the elements were sorted
+
+    template<std::size_t N, typename T>
+    auto simd_network_sort(T* data) noexcept
+        -> bool
+    {
+#if CPPSORT_SIMD_X86
+        switch (runtime_simd_isa()) {
+            case simd_isa::avx512:
+                avx512_network_sort<N>(data);
+                return true;
+            case simd_isa::avx2:
+                avx2_network_sort<N>(data);
+                return true;
+            default:
+                return false;
+        }
+#else
+        (void)data;
+        return false;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sorter implementation that uses the vectorized network
+    // when possible and the scalar one otherwise
+
+    template<std::size_t N, typename>
+    struct simd_sorting_network_sorter_impl:
+        sorting_network_sorter_impl<N>
+    {};
+
+    template<std::size_t N>
+    struct simd_sorting_network_sorter_impl<N, enable_if_t<(N >= 8)>>:
+        sorting_network_sorter_impl<N>
+    {
+        template<
+            typename RandomAccessIterator,
+            typename Compare = std::less<>,
+            typename Projection = utility::identity,
+            typename = detail::enable_if_t<is_projection_iterator_v<
+                Projection, RandomAccessIterator, Compare
+            >>
+        >
+        auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                        Compare compare={}, Projection projection={}) const
+            -> void
+        {
+            sort(std::move(first), std::move(last), std::move(compare), std::move(projection),
+                 is_simd_compatible<RandomAccessIterator, Compare, Projection>{});
+        }
+
+        private:
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection, std::true_type) const
+                -> void
+            {
+                if (not simd_network_sort<N>(simd_address(first))) {
+                    sorting_network_sorter_impl<N>::operator()(
+                        std::move(first), std::move(last),
+                        std::move(compare), std::move(projection)
+                    );
+                }
+            }
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection, std::false_type) const
+                -> void
+            {
+                sorting_network_sorter_impl<N>::operator()(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection)
+                );
+            }
+    };
+}}
+
+#endif // CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
@@ -330,7 +330,7 @@ namespace detail
                     // Buffer used by the merge operations
                     auto buffer_size = nelem_1;
                     std::unique_ptr<rvalue_type, operator_deleter> buffer(
-                        static_cast<rvalue_type*>(::operator new(buffer_size * sizeof(rvalue_type))),
+                        static_cast<rvalue_type*>(allocate_scratch(buffer_size * sizeof(rvalue_type))),
                         operator_deleter(buffer_size * sizeof(rvalue_type))
                     );
                     range_buf range_aux(buffer.get(), (buffer.get() + buffer_size));
@@ -43,6 +43,7 @@
 #include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "branchless_merge.h"
 #include "config.h"
 #include "iterator_traits.h"
 #include "lower_bound.h"
@@ -55,6 +56,21 @@
 
 namespace cppsort
 {
+    // Counters incremented by configurable_tim_sorter, defined here
+    // so that the algorithm can update them directly
+    struct tim_sorter_stats
+    {
+        // Natural runs found, before they are extended to minrun
+        std::ptrdiff_t runs = 0;
+        std::ptrdiff_t merges = 0;
+        // Number of times the galloping mode was entered
+        std::ptrdiff_t gallop_entries = 0;
+        // Elements moved in bulk after a galloping search instead
+        // of being compared one by one, including the ones skipped
+        // before the start of a merge
+        std::ptrdiff_t galloped_elements = 0;
+    };
+
 namespace detail
 {
     template<typename Iterator>
@@ -64,6 +80,9 @@ namespace detail
 
         Iterator base;
         difference_type len;
+        // Only used by powersort: depth in the merge tree of the
+        // boundary between this run and the next one
+        int power = 0;
 
         run(Iterator base, difference_type len):
             base(std::move(base)),
@@ -71,6 +90,20 @@ namespace detail
         {}
     };
 
+    // Parameters of the algorithm, the defaults are those of
+    // the original timsort
+    struct timsort_tuning
+    {
+        // Runs shorter than the computed minrun are extended with
+        // an insertion sort, minrun is chosen in [min_run, max_run]
+        // so that the number of runs is close to a power of 2
+        std::ptrdiff_t min_run = 32;
+        std::ptrdiff_t max_run = 64;
+        // Number of consecutive wins of a run needed to enter the
+        // galloping mode, adapted during the sort
+        std::ptrdiff_t min_gallop = 7;
+    };
+
     template<
         typename ChildClass,
         typename RandomAccessIterator,
@@ -83,10 +116,14 @@ namespace detail
         using rvalue_type = rvalue_type_t<iterator>;
         using difference_type = difference_type_t<iterator>;
 
-        static constexpr int min_merge = 32;
-        static constexpr int min_gallop = 7;
+        timsort_tuning tuning_;
+        tim_sorter_stats* stats_ = nullptr;
+
+        // Bounds of the whole collection
+        iterator first_;
+        difference_type size_ = 0;
 
-        difference_type minGallop_ = min_gallop;
+        difference_type minGallop_ = 0;
 
         // Buffer used for merges
         std::unique_ptr<rvalue_type, operator_deleter> buffer;
@@ -95,29 +132,47 @@ namespace detail
         // Silence GCC -Winline warning
         ~TimSortBase() noexcept {}
 
-        std::vector<run<iterator>> pending_;
+        // Stack of pending runs
+        std::vector<run<iterator>, scratch_allocator<run<iterator>>> pending_;
 
-        static auto sort(iterator const lo, iterator const hi, Compare compare, Projection projection)
+        static auto sort(iterator const lo, iterator const hi, Compare compare, Projection projection,
+                         timsort_tuning const& tuning, tim_sorter_stats* stats)
             -> void
         {
             CPPSORT_ASSERT(lo <= hi);
+            CPPSORT_ASSERT(tuning.min_run > 0);
+            CPPSORT_ASSERT(tuning.min_run <= tuning.max_run);
+            CPPSORT_ASSERT(tuning.min_gallop > 0);
+
+            // Counters are always updated, ignored ones end up here
+            tim_sorter_stats ignored_stats;
+            if (stats == nullptr) {
+                stats = &ignored_stats;
+            }
 
             difference_type nRemaining = hi - lo;
             if (nRemaining < 2) {
                 return; // nothing to do
             }
 
-            if (nRemaining < min_merge) {
+            if (nRemaining < tuning.min_run) {
                 difference_type const initRunLen = countRunAndMakeAscending(lo, hi, compare, projection);
                 binarySort(lo, hi, lo + initRunLen, std::move(compare), std::move(projection));
+                ++stats->runs;
                 return;
             }
 
             ChildClass ts{};
-            difference_type const minRun = minRunLength(nRemaining);
+            ts.first_ = lo;
+            ts.size_ = nRemaining;
+            ts.tuning_ = tuning;
+            ts.stats_ = stats;
+            ts.minGallop_ = static_cast<difference_type>(tuning.min_gallop);
+            difference_type const minRun = minRunLength(nRemaining, tuning);
             iterator cur = lo;
             do {
                 difference_type runLen = countRunAndMakeAscending(cur, hi, compare, projection);
+                ++ts.stats_->runs;
 
                 if (runLen < minRun) {
                     difference_type const force = (std::min)(nRemaining, minRun);
@@ -189,17 +244,18 @@ namespace detail
             return runHi - lo;
         }
 
-        static auto minRunLength(difference_type n)
+        static auto minRunLength(difference_type n, timsort_tuning const& tuning)
             -> difference_type
         {
             CPPSORT_ASSERT(n >= 0);
 
             difference_type r = 0;
-            while (n >= 2 * min_merge) {
+            while (n >= tuning.max_run) {
                 r |= (n & 1);
                 n >>= 1;
             }
-            return n + r;
+            difference_type const minRun = n + r;
+            return (std::max)(minRun, static_cast<difference_type>(tuning.min_run));
         }
 
         auto pushRun(iterator const runBase, difference_type const runLen)
@@ -264,6 +320,7 @@ namespace detail
 
             pending_.pop_back();
 
+            ++stats_->merges;
             mergeConsecutiveRuns(base1, len1, base2, len2, std::move(compare), std::move(projection));
         }
 
@@ -280,13 +337,17 @@ namespace detail
 
             base1 += k;
             len1 -= k;
+            stats_->galloped_elements += k;
 
             if (len1 == 0) {
                 return;
             }
 
-            len2 = gallopLeft(proj(base1[len1 - 1]), base2, len2, len2 - 1, compare, projection);
-            CPPSORT_ASSERT(len2 >= 0);
+            difference_type const len2_end = gallopLeft(proj(base1[len1 - 1]), base2, len2, len2 - 1,
+                                                        compare, projection);
+            CPPSORT_ASSERT(len2_end >= 0);
+            stats_->galloped_elements += len2 - len2_end;
+            len2 = len2_end;
             if (len2 == 0) {
                 return;
             }
@@ -422,12 +483,166 @@ namespace detail
                 buffer.reset(nullptr);
                 buffer.get_deleter() = operator_deleter(new_size * sizeof(rvalue_type));
                 buffer.reset(static_cast<rvalue_type*>(
-                    ::operator new(new_size * sizeof(rvalue_type))
+                    allocate_scratch(new_size * sizeof(rvalue_type))
                 ));
                 buffer_size = new_size;
             }
         }
 
+        // Whether the elements can be merged one by one without branching
+        // on the result of the comparisons, see branchless_merge.h
+        using is_branchless = std::integral_constant<
+            bool,
+            is_branchless_merge<rvalue_type*, iterator, Compare, Projection>::value
+        >;
+
+        // The one-by-one phases of mergeLo and mergeHi, merging elements
+        // until either run gets too small or one of the runs wins often
+        // enough in a row to switch to galloping mode; they return
+        // whether the merge is over
+
+        static auto mergeLoOneByOne(rvalue_type*& cursor1, iterator& cursor2, iterator& dest,
+                                    difference_type& len1, difference_type& len2,
+                                    difference_type& count1, difference_type& count2,
+                                    difference_type minGallop,
+                                    Compare compare, Projection projection, std::false_type)
+            -> bool
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            do {
+                CPPSORT_ASSERT(len1 > 1);
+                CPPSORT_ASSERT(len2 > 0);
+
+                if (comp(proj(*cursor2), proj(*cursor1))) {
+                    *dest = iter_move(cursor2);
+                    ++dest;
+                    ++cursor2;
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) {
+                        return true;
+                    }
+                }
+                else {
+                    *dest = iter_move(cursor1);
+                    ++dest;
+                    ++cursor1;
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) {
+                        return true;
+                    }
+                }
+            } while ((count1 | count2) < minGallop);
+            return false;
+        }
+
+        static auto mergeLoOneByOne(rvalue_type*& cursor1, iterator& cursor2, iterator& dest,
+                                    difference_type& len1, difference_type& len2,
+                                    difference_type& count1, difference_type& count2,
+                                    difference_type minGallop,
+                                    Compare compare, Projection projection, std::true_type)
+            -> bool
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            do {
+                CPPSORT_ASSERT(len1 > 1);
+                CPPSORT_ASSERT(len2 > 0);
+
+                bool take2 = comp(proj(*cursor2), proj(*cursor1));
+                *dest = take2 ? iter_move(cursor2) : iter_move(cursor1);
+                ++dest;
+                cursor2 += take2;
+                cursor1 += not take2;
+                len2 -= take2;
+                len1 -= not take2;
+                count2 = (count2 + 1) * take2;
+                count1 = (count1 + 1) * not take2;
+            } while (len2 != 0 && len1 != 1 && (count1 | count2) < minGallop);
+            return len2 == 0 || len1 == 1;
+        }
+
+        static auto mergeHiOneByOne(iterator& cursor1, rvalue_type*& cursor2, iterator& dest,
+                                    difference_type& len1, difference_type& len2,
+                                    difference_type& count1, difference_type& count2,
+                                    difference_type minGallop,
+                                    Compare compare, Projection projection, std::false_type)
+            -> bool
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            // The next loop is a hot path of the algorithm, so we decrement
+            // eagerly the cursor so that it always points directly to the value
+            // to compare, but we have to implement some trickier logic to make
+            // sure that it points to the next value again by the end of said loop
+            --cursor1;
+
+            do {
+                CPPSORT_ASSERT(len1 > 0);
+                CPPSORT_ASSERT(len2 > 1);
+
+                if (comp(proj(*cursor2), proj(*cursor1))) {
+                    *dest = iter_move(cursor1);
+                    --dest;
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) {
+                        return true;
+                    }
+                    --cursor1;
+                } else {
+                    *dest = iter_move(cursor2);
+                    --dest;
+                    --cursor2;
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) {
+                        ++cursor1;
+                        return true;
+                    }
+                }
+            } while ((count1 | count2) < minGallop);
+            ++cursor1; // See comment before the loop
+            return false;
+        }
+
+        static auto mergeHiOneByOne(iterator& cursor1, rvalue_type*& cursor2, iterator& dest,
+                                    difference_type& len1, difference_type& len2,
+                                    difference_type& count1, difference_type& count2,
+                                    difference_type minGallop,
+                                    Compare compare, Projection projection, std::true_type)
+            -> bool
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            do {
+                CPPSORT_ASSERT(len1 > 0);
+                CPPSORT_ASSERT(len2 > 1);
+
+                auto prev1 = cursor1 - 1;
+                bool take1 = comp(proj(*cursor2), proj(*prev1));
+                *dest = take1 ? iter_move(prev1) : iter_move(cursor2);
+                --dest;
+                cursor1 -= take1;
+                cursor2 -= not take1;
+                len1 -= take1;
+                len2 -= not take1;
+                count1 = (count1 + 1) * take1;
+                count2 = (count2 + 1) * not take1;
+            } while (len1 != 0 && len2 != 1 && (count1 | count2) < minGallop);
+            return len1 == 0 || len2 == 1;
+        }
+
         auto mergeLo(iterator const base1, difference_type len1, iterator const base2, difference_type len2,
                      Compare compare, Projection projection)
             -> void
@@ -437,7 +652,6 @@ namespace detail
             CPPSORT_ASSERT(base1 + len1 == base2);
 
             using utility::iter_move;
-            auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
             if (len1 == 1) {
@@ -470,43 +684,19 @@ namespace detail
                 difference_type count1 = 0;
                 difference_type count2 = 0;
 
-                bool break_outer = false;
-                do {
-                    CPPSORT_ASSERT(len1 > 1);
-                    CPPSORT_ASSERT(len2 > 0);
-
-                    if (comp(proj(*cursor2), proj(*cursor1))) {
-                        *dest = iter_move(cursor2);
-                        ++dest;
-                        ++cursor2;
-                        ++count2;
-                        count1 = 0;
-                        if (--len2 == 0) {
-                            break_outer = true;
-                            break;
-                        }
-                    }
-                    else {
-                        *dest = iter_move(cursor1);
-                        ++dest;
-                        ++cursor1;
-                        ++count1;
-                        count2 = 0;
-                        if (--len1 == 1) {
-                            break_outer = true;
-                            break;
-                        }
-                    }
-                } while ((count1 | count2) < minGallop);
-                if (break_outer) {
+                if (mergeLoOneByOne(cursor1, cursor2, dest, len1, len2, count1, count2,
+                                    minGallop, compare, projection, is_branchless{})) {
                     break;
                 }
 
+                ++stats_->gallop_entries;
+                bool break_outer = false;
                 do {
                     CPPSORT_ASSERT(len1 > 1);
                     CPPSORT_ASSERT(len2 > 0);
 
                     count1 = gallopRight(proj(*cursor2), cursor1, len1, 0, compare, projection);
+                    stats_->galloped_elements += count1;
                     if (count1 != 0) {
                         detail::move_backward(cursor1, cursor1 + count1, dest + count1);
                         dest += count1;
@@ -527,6 +717,7 @@ namespace detail
                     }
 
                     count2 = gallopLeft(proj(*cursor1), cursor2, len2, 0, compare, projection);
+                    stats_->galloped_elements += count2;
                     if (count2 != 0) {
                         detail::move(cursor2, cursor2 + count2, dest);
                         dest += count2;
@@ -546,7 +737,7 @@ namespace detail
                     }
 
                     --minGallop;
-                } while ((count1 >= min_gallop) | (count2 >= min_gallop));
+                } while ((count1 >= tuning_.min_gallop) | (count2 >= tuning_.min_gallop));
                 if (break_outer) {
                     break;
                 }
@@ -557,7 +748,7 @@ namespace detail
                 minGallop += 2;
             } // end of "outer" loop
 
-            minGallop_ = std::min<difference_type>(minGallop, 1);
+            minGallop_ = (std::max)(minGallop, difference_type(1));
 
             if (len1 == 1) {
                 CPPSORT_ASSERT(len2 > 0);
@@ -581,7 +772,6 @@ namespace detail
             CPPSORT_ASSERT(base1 + len1 == base2);
 
             using utility::iter_move;
-            auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
             if (len1 == 1) {
@@ -613,51 +803,19 @@ namespace detail
                 difference_type count1 = 0;
                 difference_type count2 = 0;
 
-                // The next loop is a hot path of the algorithm, so we decrement
-                // eagerly the cursor so that it always points directly to the value
-                // to compare, but we have to implement some trickier logic to make
-                // sure that it points to the next value again by the end of said loop
-                --cursor1;
-
-                bool break_outer = false;
-                do {
-                    CPPSORT_ASSERT(len1 > 0);
-                    CPPSORT_ASSERT(len2 > 1);
-
-                    if (comp(proj(*cursor2), proj(*cursor1))) {
-                        *dest = iter_move(cursor1);
-                        --dest;
-                        ++count1;
-                        count2 = 0;
-                        if (--len1 == 0) {
-                            break_outer = true;
-                            break;
-                        }
-                        --cursor1;
-                    } else {
-                        *dest = iter_move(cursor2);
-                        --dest;
-                        --cursor2;
-                        ++count2;
-                        count1 = 0;
-                        if (--len2 == 1) {
-                            ++cursor1;
-                            break_outer = true;
-                            break;
-                        }
-                    }
-                } while ((count1 | count2) < minGallop);
-                if (break_outer) {
+                if (mergeHiOneByOne(cursor1, cursor2, dest, len1, len2, count1, count2,
+                                    minGallop, compare, projection, is_branchless{})) {
                     break;
-                } else {
-                    ++cursor1; // See comment before the loop
                 }
 
+                ++stats_->gallop_entries;
+                bool break_outer = false;
                 do {
                     CPPSORT_ASSERT(len1 > 0);
                     CPPSORT_ASSERT(len2 > 1);
 
                     count1 = len1 - gallopRight(proj(*cursor2), base1, len1, len1 - 1, compare, projection);
+                    stats_->galloped_elements += count1;
                     if (count1 != 0) {
                         dest -= count1;
                         cursor1 -= count1;
@@ -678,6 +836,7 @@ namespace detail
                     }
 
                     count2 = len2 - gallopLeft(proj(*std::prev(cursor1)), buffer.get(), len2, len2 - 1, compare, projection);
+                    stats_->galloped_elements += count2;
                     if (count2 != 0) {
                         dest -= count2;
                         cursor2 -= count2;
@@ -696,7 +855,7 @@ namespace detail
                     }
 
                     minGallop--;
-                } while ((count1 >= min_gallop) | (count2 >= min_gallop));
+                } while ((count1 >= tuning_.min_gallop) | (count2 >= tuning_.min_gallop));
                 if (break_outer) {
                     break;
                 }
@@ -707,7 +866,7 @@ namespace detail
                 minGallop += 2;
             } // end of "outer" loop
 
-            minGallop_ = std::min<difference_type>(minGallop, 1);
+            minGallop_ = (std::max)(minGallop, difference_type(1));
 
             if (len2 == 1) {
                 CPPSORT_ASSERT(len1 > 0);
@@ -766,24 +925,115 @@ namespace detail
         }
     };
 
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    struct PowerSort:
+        TimSortBase<
+            PowerSort<RandomAccessIterator, Compare, Projection>,
+            RandomAccessIterator,
+            Compare,
+            Projection
+        >
+    {
+        using base = TimSortBase<
+            PowerSort<RandomAccessIterator, Compare, Projection>,
+            RandomAccessIterator,
+            Compare,
+            Projection
+        >;
+        using difference_type = typename base::difference_type;
+
+        PowerSort() = default;
+
+        // Depth in the nearly-optimal merge tree of the boundary between
+        // the runs [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) of a collection
+        // of size n: the number of leading bits shared by the binary
+        // expansions of the normalized midpoints of both runs, plus one
+        static auto nodePower(std::ptrdiff_t s1, std::ptrdiff_t n1,
+                              std::ptrdiff_t n2, std::ptrdiff_t n)
+            -> int
+        {
+            CPPSORT_ASSERT(s1 >= 0);
+            CPPSORT_ASSERT(n1 > 0);
+            CPPSORT_ASSERT(n2 > 0);
+            CPPSORT_ASSERT(s1 + n1 + n2 <= n);
+
+            // Twice the midpoints, to avoid fractions
+            std::ptrdiff_t a = 2 * s1 + n1;
+            std::ptrdiff_t b = a + n1 + n2;
+            int result = 0;
+            while (true) {
+                ++result;
+                if (a >= n) {
+                    // Both bits are 1
+                    a -= n;
+                    b -= n;
+                } else if (b >= n) {
+                    // The bits differ
+                    break;
+                }
+                a <<= 1;
+                b <<= 1;
+            }
+            return result;
+        }
+
+        auto mergeCollapse(Compare compare, Projection projection)
+            -> void
+        {
+            auto& pending = this->pending_;
+            if (pending.size() < 2) {
+                return;
+            }
+
+            // The run that was just pushed stays on top of the stack while
+            // the runs below it whose boundary is deeper in the merge tree
+            // than the new boundary are merged
+            auto&& prev = pending[pending.size() - 2];
+            int power = nodePower(
+                prev.base - this->first_, prev.len,
+                pending.back().len, this->size_
+            );
+            while (pending.size() > 2 && pending[pending.size() - 3].power > power) {
+                base::mergeAt(pending.size() - 3, compare, projection);
+            }
+            pending[pending.size() - 2].power = power;
+        }
+    };
+
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto timsort(RandomAccessIterator first, RandomAccessIterator last,
-                 Compare compare, Projection projection)
+                 Compare compare, Projection projection,
+                 timsort_tuning const& tuning={}, tim_sorter_stats* stats=nullptr)
         -> void
     {
         TimSort<RandomAccessIterator, Compare, Projection>::sort(
             std::move(first), std::move(last),
-            std::move(compare), std::move(projection));
+            std::move(compare), std::move(projection),
+            tuning, stats);
     }
 
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto adaptive_shivers_sort(RandomAccessIterator first, RandomAccessIterator last,
-                               Compare compare, Projection projection)
+                               Compare compare, Projection projection,
+                               timsort_tuning const& tuning={}, tim_sorter_stats* stats=nullptr)
         -> void
     {
         AdaptiveShiversSort<RandomAccessIterator, Compare, Projection>::sort(
             std::move(first), std::move(last),
-            std::move(compare), std::move(projection));
+            std::move(compare), std::move(projection),
+            tuning, stats);
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto powersort(RandomAccessIterator first, RandomAccessIterator last,
+                   Compare compare, Projection projection,
+                   timsort_tuning const& tuning={}, tim_sorter_stats* stats=nullptr)
+        -> void
+    {
+        PowerSort<RandomAccessIterator, Compare, Projection>::sort(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection),
+            tuning, stats);
     }
 }}
 
@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////
 #include <iterator>
 #include <list>
+#include <tuple>
 #include <utility>
 #include <cpp-sort/adapters/stable_adapter.h>
 #include <cpp-sort/utility/as_function.h>
@@ -21,6 +22,7 @@
 #include "merge_sort.h"
 #include "reverse.h"
 #include "rotate.h"
+#include "simd_adjacent_find.h"
 #include "sized_range.h"
 #include "upper_bound.h"
 
@@ -41,6 +43,31 @@ namespace verge
         difference_type_t<Iterator> size;
     };
 
+    ////////////////////////////////////////////////////////////
+    // Find the limits of the run containing the pair of elements
+    // ending at next: its beginning is searched backward in
+    // [begin_range, next) and its end forward in [next, last),
+    // a run being broken by any pair satisfying the relation.
+    // Arithmetic types are scanned with vectorized comparisons
+    // when possible.
+
+    template<typename RandomAccessIterator, typename Relation, typename Compare, typename Projection>
+    auto run_limits(RandomAccessIterator begin_range, RandomAccessIterator next,
+                    RandomAccessIterator last, Relation relation,
+                    Compare compare, Projection projection)
+        -> std::pair<RandomAccessIterator, RandomAccessIterator>
+    {
+        auto begin_run = detail::find_last_adjacent_pair(begin_range, next, relation,
+                                                         compare, projection);
+        begin_run = (begin_run == next) ? begin_range : std::next(begin_run);
+        auto end_run = detail::find_adjacent_pair(next, last, relation,
+                                                  std::move(compare), std::move(projection));
+        if (end_run != last) {
+            ++end_run;
+        }
+        return { begin_run, end_run };
+    }
+
     ////////////////////////////////////////////////////////////
     // Merge a list of runs with a k-way merge
 
@@ -377,8 +404,7 @@ namespace verge
             current += minrun_limit;
             next += minrun_limit;
 
-            // Set forward iterators
-            auto current2 = current;
+            // End of the run, set once its limits are found
             auto next2 = next;
 
             if (comp(proj(*next), proj(*current))) {
@@ -387,40 +413,14 @@ namespace verge
                 if (Stable) {
                     // Find a strictly descending run to avoid breaking
                     // the stability of the algorithm with reverse()
-                    do {
-                        --current;
-                        --next;
-                        if (not comp(proj(*next), proj(*current))) break;
-                    } while (current != begin_range);
-                    if (not comp(proj(*next), proj(*current))) {
-                        ++current;
-                    }
-
-                    ++current2;
-                    ++next2;
-                    while (next2 != last) {
-                        if (not comp(proj(*next2), proj(*current2))) break;
-                        ++current2;
-                        ++next2;
-                    }
+                    std::tie(current, next2) = run_limits(begin_range, next, last,
+                                                          adjacent_non_descent{},
+                                                          compare, projection);
                 } else {
                     // Find a non-ascending sequence
-                    do {
-                        --current;
-                        --next;
-                        if (comp(proj(*current), proj(*next))) break;
-                    } while (current != begin_range);
-                    if (comp(proj(*current), proj(*next))) {
-                        ++current;
-                    }
-
-                    ++current2;
-                    ++next2;
-                    while (next2 != last) {
-                        if (comp(proj(*current2), proj(*next2))) break;
-                        ++current2;
-                        ++next2;
-                    }
+                    std::tie(current, next2) = run_limits(begin_range, next, last,
+                                                          adjacent_ascent{},
+                                                          compare, projection);
                 }
 
                 // Check whether we found a big enough sorted sequence
@@ -444,20 +444,9 @@ namespace verge
             } else {
                 // Found an non-descending run, scan to the left and to
                 // the right until the limits of the run are reached
-                do {
-                    --current;
-                    --next;
-                    if (comp(proj(*next), proj(*current))) break;
-                } while (current != begin_range);
-                if (comp(proj(*next), proj(*current))) ++current;
-
-                ++current2;
-                ++next2;
-                while (next2 != last) {
-                    if (comp(proj(*next2), proj(*current2))) break;
-                    ++current2;
-                    ++next2;
-                }
+                std::tie(current, next2) = run_limits(begin_range, next, last,
+                                                      adjacent_descent{},
+                                                      compare, projection);
 
                 // Check whether we found a big enough sorted sequence
                 if (next2 - current >= minrun_limit) {
@@ -480,7 +469,7 @@ namespace verge
 
             if (next2 == last) break;
 
-            current = std::next(current2);
+            current = next2;
             next = std::next(next2);
         }
 
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_WORK_STEALING_POOL_H_
+#define CPPSORT_DETAIL_WORK_STEALING_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "config.h"
+#include "execution_policy.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Number of threads to use by default
+
+    inline auto default_thread_count() noexcept
+        -> std::size_t
+    {
+        // hardware_concurrency() is allowed to return 0 when
+        // the information is not available
+        auto nb_threads = std::thread::hardware_concurrency();
+        return nb_threads == 0 ? 1 : nb_threads;
+    }
+
+    // Number of threads to use for a given execution policy
+    template<typename ExecutionPolicy>
+    auto policy_thread_count() noexcept
+        -> std::size_t
+    {
+        return is_parallel_policy<ExecutionPolicy>::value ? default_thread_count() : 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Work-stealing pool
+    //
+    // Small fork-join scheduler meant to be created for the
+    // duration of a single parallel algorithm: every thread
+    // owns a double-ended queue of tasks, pushes the tasks it
+    // forks to the back of its own queue and pops them back in
+    // LIFO order, which keeps recently partitioned data hot in
+    // its cache. Idle threads steal the oldest tasks - which
+    // are generally the biggest ones in divide-and-conquer
+    // algorithms - from the front of the other queues.
+    //
+    // The thread that creates the pool counts as one of its
+    // workers: it participates to the work when it calls
+    // wait(), which returns once every task submitted without
+    // an explicit group - and every such task they submitted
+    // in turn - has been executed. The first exception thrown
+    // by a task is rethrown by wait(), the tasks that are
+    // still pending at that point are discarded.
+    //
+    // Tasks can also be submitted to a task_group, which can
+    // be waited for independently from the other tasks: this
+    // allows a task to fork subtasks and to wait for them in
+    // a nested fashion. A thread waiting for a group executes
+    // other tasks in the meantime, so that a waiting task does
+    // not block the thread running it.
+
+    class work_stealing_pool
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Group of tasks that can be waited for
+
+            class task_group
+            {
+                public:
+
+                    task_group() = default;
+                    task_group(const task_group&) = delete;
+                    task_group& operator=(const task_group&) = delete;
+
+                private:
+
+                    friend class work_stealing_pool;
+                    std::atomic<std::size_t> pending_{0};
+            };
+
+            // Make the pool immovable
+            work_stealing_pool(const work_stealing_pool&) = delete;
+            work_stealing_pool(work_stealing_pool&&) = delete;
+            work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+            work_stealing_pool& operator=(work_stealing_pool&&) = delete;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            explicit work_stealing_pool(std::size_t nb_threads=default_thread_count()):
+                nb_queues_(nb_threads == 0 ? 1 : nb_threads),
+                queues_(new task_queue[nb_queues_])
+            {
+                threads_.reserve(nb_queues_ - 1);
+                try {
+                    for (std::size_t idx = 1 ; idx < nb_queues_ ; ++idx) {
+                        threads_.emplace_back([this, idx] { worker_loop(idx); });
+                    }
+                } catch (...) {
+                    shutdown();
+                    throw;
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Destruction
+
+            ~work_stealing_pool()
+            {
+                // Make sure that no task outlives the data it refers
+                // to when the pool is destroyed without calling wait()
+                cancelled_.store(true);
+                while (pending_.load() != 0) {
+                    run_one_task(0);
+                }
+                shutdown();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            auto thread_count() const noexcept
+                -> std::size_t
+            {
+                return nb_queues_;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Task submission
+
+            template<typename Function>
+            auto submit(Function&& func)
+                -> void
+            {
+                submit(default_group_, std::forward<Function>(func));
+            }
+
+            template<typename Function>
+            auto submit(task_group& group, Function&& func)
+                -> void
+            {
+                auto& queue = queues_[current_index()];
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back({ std::forward<Function>(func), &group });
+                    // Counters are updated under the lock so that no
+                    // thread can pop and finish the task beforehand
+                    group.pending_.fetch_add(1);
+                    pending_.fetch_add(1);
+                    queued_.fetch_add(1);
+                }
+                // Taking the lock before notifying avoids a lost wakeup
+                // between the check of the predicate and the actual wait
+                { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+                sleep_cv_.notify_one();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Synchronization
+
+            auto wait()
+                -> void
+            {
+                help_until_done(default_group_);
+
+                if (exception_) {
+                    std::exception_ptr exc = std::exchange(exception_, nullptr);
+                    cancelled_.store(false);
+                    std::rethrow_exception(exc);
+                }
+            }
+
+            auto wait(task_group& group)
+                -> void
+            {
+                help_until_done(group);
+
+                // The exception is only cleared by the outermost wait(),
+                // a nested one merely propagates it to its enclosing task
+                if (cancelled_.load()) {
+                    std::unique_lock<std::mutex> lock(exception_mutex_);
+                    std::exception_ptr exc = exception_;
+                    lock.unlock();
+                    if (exc) {
+                        std::rethrow_exception(exc);
+                    }
+                }
+            }
+
+        private:
+
+            struct task
+            {
+                std::function<void()> func;
+                task_group* group;
+            };
+
+            struct task_queue
+            {
+                std::mutex mutex;
+                std::deque<task> tasks;
+            };
+
+            ////////////////////////////////////////////////////////////
+            // Worker identification
+
+            struct worker_identity
+            {
+                const work_stealing_pool* pool;
+                std::size_t index;
+            };
+
+            static auto this_worker() noexcept
+                -> worker_identity&
+            {
+                static thread_local worker_identity identity = { nullptr, 0 };
+                return identity;
+            }
+
+            auto current_index() const noexcept
+                -> std::size_t
+            {
+                // Threads that are not workers of this pool - including
+                // the thread that created it - use the first queue
+                const auto& identity = this_worker();
+                return identity.pool == this ? identity.index : 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Task retrieval and execution
+
+            auto pop_task(std::size_t idx, task& result)
+                -> bool
+            {
+                // Try to pop the most recent task of the thread's own queue
+                {
+                    auto& queue = queues_[idx];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (not queue.tasks.empty()) {
+                        result = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                        queued_.fetch_sub(1);
+                        return true;
+                    }
+                }
+
+                // Otherwise try to steal the oldest task of another queue
+                for (std::size_t offset = 1 ; offset < nb_queues_ ; ++offset) {
+                    auto& queue = queues_[(idx + offset) % nb_queues_];
+                    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+                    if (lock.owns_lock() && not queue.tasks.empty()) {
+                        result = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                        queued_.fetch_sub(1);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            auto run_one_task(std::size_t idx) noexcept
+                -> bool
+            {
+                task current;
+                if (not pop_task(idx, current)) {
+                    return false;
+                }
+
+                if (not cancelled_.load()) {
+                    try {
+                        current.func();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(exception_mutex_);
+                        if (not exception_) {
+                            exception_ = std::current_exception();
+                        }
+                        cancelled_.store(true);
+                    }
+                }
+                // Destroy the task before signaling its completion
+                current.func = nullptr;
+                current.group->pending_.fetch_sub(1);
+                pending_.fetch_sub(1);
+                return true;
+            }
+
+            auto help_until_done(const task_group& group) noexcept
+                -> void
+            {
+                auto idx = current_index();
+                while (group.pending_.load() != 0) {
+                    if (not run_one_task(idx)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            auto worker_loop(std::size_t idx)
+                -> void
+            {
+                this_worker() = { this, idx };
+                while (true) {
+                    if (run_one_task(idx)) {
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock(sleep_mutex_);
+                    sleep_cv_.wait(lock, [this] {
+                        return stopped_ || queued_.load() != 0;
+                    });
+                    if (stopped_) {
+                        return;
+                    }
+                }
+            }
+
+            auto shutdown() noexcept
+                -> void
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    stopped_ = true;
+                }
+                sleep_cv_.notify_all();
+                for (auto& thread: threads_) {
+                    thread.join();
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Data members
+
+            std::size_t nb_queues_;
+            std::unique_ptr<task_queue[]> queues_;
+            std::vector<std::thread> threads_;
+
+            // Tasks submitted but not finished yet, and tasks
+            // waiting in a queue
+            task_group default_group_;
+            std::atomic<std::size_t> pending_{0};
+            std::atomic<std::size_t> queued_{0};
+
+            std::mutex sleep_mutex_;
+            std::condition_variable sleep_cv_;
+            bool stopped_ = false;
+
+            std::atomic<bool> cancelled_{false};
+            std::mutex exception_mutex_;
+            std::exception_ptr exception_;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_WORK_STEALING_POOL_H_
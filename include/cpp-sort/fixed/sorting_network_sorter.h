@@ -41,11 +41,16 @@ namespace cppsort
         struct sorting_network_sorter_impl<1>:
             cppsort::detail::empty_network_sorter_impl
         {};
+
+        // Dispatches to a vectorized implementation of the network
+        // when possible
+        template<std::size_t N, typename>
+        struct simd_sorting_network_sorter_impl;
     }
 
     template<std::size_t N>
     struct sorting_network_sorter:
-        sorter_facade<detail::sorting_network_sorter_impl<N>>
+        sorter_facade<detail::simd_sorting_network_sorter_impl<N, void>>
     {};
 
     ////////////////////////////////////////////////////////////
@@ -93,6 +98,10 @@ namespace cppsort
 #include "../detail/swap_if.h"
 #include "../detail/type_traits.h"
 
+// Dispatch to vectorized networks, included first because some
+// specializations use smaller sorting networks
+#include "../detail/sorting_network/simd.h"
+
 // Explicit specializations of sorting_network_sorter
 #include "../detail/sorting_network/sort2.h"
 #include "../detail/sorting_network/sort3.h"
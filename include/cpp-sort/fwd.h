@@ -23,9 +23,15 @@ namespace cppsort
     // Sorters
 
     struct adaptive_shivers_sorter;
+    template<typename Table>
+    struct auto_sorter;
+    enum class tim_sorter_policy;
+    template<tim_sorter_policy Policy>
+    struct basic_tim_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct cartesian_tree_sorter;
+    struct configurable_tim_sorter;
     struct counting_sorter;
     template<int D>
     struct d_ary_heap_sorter;
@@ -37,9 +43,15 @@ namespace cppsort
     struct heap_sorter;
     struct insertion_sorter;
     struct integer_spread_sorter;
+    struct lsd_radix_sorter;
     struct mel_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct nth_element_sorter;
+    struct parallel_merge_sorter;
+    struct parallel_pdq_sorter;
+    struct parallel_ska_sorter;
+    struct partial_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
     struct quick_merge_sorter;
@@ -55,6 +67,7 @@ namespace cppsort
     struct std_sorter;
     struct string_spread_sorter;
     struct tim_sorter;
+    struct top_k_sorter;
     struct verge_sorter;
     template<typename BufferProvider>
     struct wiki_sorter;
@@ -76,6 +89,8 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // Sorter adapters
 
+    template<typename Sorter>
+    struct compact_schwartz_adapter;
     template<typename Sorter>
     struct container_aware_adapter;
     template<typename Sorter, typename CountType=std::size_t>
@@ -86,6 +101,10 @@ namespace cppsort
     struct hybrid_adapter;
     template<typename Sorter>
     struct indirect_adapter;
+#if __cplusplus > 201402L
+    template<typename Sorter>
+    struct memory_resource_adapter;
+#endif
     template<typename Sorter>
     struct out_of_place_adapter;
     template<typename Sorter>
@@ -106,6 +125,8 @@ namespace cppsort
 
     namespace metrics
     {
+        template<typename Sorter, typename CountType=std::size_t>
+        struct allocated_memory;
         template<typename Sorter, typename CountType=std::size_t>
         struct comparisons;
         template<typename Sorter, typename CountType=std::size_t>
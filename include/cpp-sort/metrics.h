@@ -7,6 +7,7 @@
 
 #include <cpp-sort/utility/metrics_tools.h>
 
+#include <cpp-sort/metrics/allocated_memory.h>
 #include <cpp-sort/metrics/comparisons.h>
 #include <cpp-sort/metrics/moves.h>
 #include <cpp-sort/metrics/running_time.h>
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_ALLOCATED_MEMORY_H_
+#define CPPSORT_METRICS_ALLOCATED_MEMORY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/checkers.h"
+#include "../detail/memory.h"
+#include "../detail/scope_exit.h"
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct allocated_memory_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter, typename CountType>
+    struct allocated_memory:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        using tag_t = allocated_memory_tag;
+        using metric_t = utility::metric<CountType, tag_t>;
+
+        allocated_memory() = default;
+
+        constexpr explicit allocated_memory(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter))
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<CountType>())
+            )
+        {
+            std::size_t count = 0;
+            auto& current_counter = cppsort::detail::current_scratch_memory_counter();
+            auto previous_counter = std::exchange(current_counter, &count);
+            auto restore_counter = cppsort::detail::make_scope_exit([&] {
+                // Let an enclosing allocated_memory see the allocations too
+                current_counter = previous_counter;
+                if (previous_counter) {
+                    *previous_counter += count;
+                }
+            });
+            this->get()(std::forward<Args>(args)...);
+            return metric_t(CountType(count));
+        }
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename CountType, typename... Args>
+    struct is_stable<metrics::allocated_memory<Sorter, CountType>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_ALLOCATED_MEMORY_H_
@@ -11,6 +11,7 @@
 #include <cpp-sort/probes/block.h>
 #include <cpp-sort/probes/dis.h>
 #include <cpp-sort/probes/enc.h>
+#include <cpp-sort/probes/estimate.h>
 #include <cpp-sort/probes/exc.h>
 #include <cpp-sort/probes/ham.h>
 #include <cpp-sort/probes/inv.h>
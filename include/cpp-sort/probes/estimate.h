@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_ESTIMATE_H_
+#define CPPSORT_PROBES_ESTIMATE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/random.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Estimated value of a measure of presortedness, the actual
+    // value is in [lower_bound, upper_bound] with the confidence
+    // requested from the estimator
+
+    template<typename T>
+    struct estimate_result
+    {
+        T value;
+        T lower_bound;
+        T upper_bound;
+    };
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // The supported measures count the events among a population
+        // of pairs of elements that are out of order: the proportion
+        // of such events is estimated by testing random pairs, and
+        // Hoeffding's inequality bounds the error of the estimate
+
+        template<typename T>
+        auto make_estimate_result(std::uint64_t hits, std::uint64_t sample_size,
+                                  T population, double confidence)
+            -> estimate_result<T>
+        {
+            auto ratio = static_cast<double>(hits) / static_cast<double>(sample_size);
+            auto error = std::sqrt(std::log(2.0 / (1.0 - confidence))
+                                   / (2.0 * static_cast<double>(sample_size)));
+
+            auto scale = [population](double r) {
+                r = r < 0.0 ? 0.0 : (r > 1.0 ? 1.0 : r);
+                return static_cast<T>(std::llround(r * static_cast<double>(population)));
+            };
+            return { scale(ratio), scale(ratio - error), scale(ratio + error) };
+        }
+
+        template<typename T>
+        auto make_exact_result(T value)
+            -> estimate_result<T>
+        {
+            return { value, value, value };
+        }
+
+        template<typename Probe>
+        struct estimate_impl;
+
+        ////////////////////////////////////////////////////////////
+        // Inv: proportion of inverted pairs among all the pairs
+
+        template<>
+        struct estimate_impl<sorter_facade<inv_impl>>
+        {
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            static auto sample(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::uint64_t sample_size, double confidence,
+                               cppsort::detail::splitmix64& engine)
+                -> estimate_result<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                auto size = last - first;
+                auto population = inv_impl::max_for_size(size);
+                if (static_cast<std::uint64_t>(population) <= sample_size) {
+                    return make_exact_result(inv(first, last, std::move(compare), std::move(projection)));
+                }
+
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                std::uint64_t hits = 0;
+                auto n = static_cast<std::uint64_t>(size);
+                for (std::uint64_t idx = 0; idx < sample_size; ++idx) {
+                    // Pick two distinct positions i < j uniformly
+                    auto i = cppsort::detail::random_below(engine, n);
+                    auto j = cppsort::detail::random_below(engine, n - 1);
+                    if (j >= i) {
+                        ++j;
+                    } else {
+                        std::swap(i, j);
+                    }
+                    hits += comp(proj(first[static_cast<std::ptrdiff_t>(j)]),
+                                 proj(first[static_cast<std::ptrdiff_t>(i)]));
+                }
+                return make_estimate_result(hits, sample_size, population, confidence);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Runs: proportion of step downs among the adjacent pairs
+
+        template<>
+        struct estimate_impl<sorter_facade<runs_impl>>
+        {
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            static auto sample(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::uint64_t sample_size, double confidence,
+                               cppsort::detail::splitmix64& engine)
+                -> estimate_result<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                auto size = last - first;
+                auto population = runs_impl::max_for_size(size);
+                if (static_cast<std::uint64_t>(population) <= sample_size) {
+                    return make_exact_result(runs(first, last, std::move(compare), std::move(projection)));
+                }
+
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                std::uint64_t hits = 0;
+                auto n = static_cast<std::uint64_t>(population);
+                for (std::uint64_t idx = 0; idx < sample_size; ++idx) {
+                    auto it = first + static_cast<std::ptrdiff_t>(cppsort::detail::random_below(engine, n));
+                    hits += comp(proj(it[1]), proj(*it));
+                }
+                return make_estimate_result(hits, sample_size, population, confidence);
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sublinear estimator of a measure of presortedness
+
+    template<typename Probe>
+    struct estimate
+    {
+        private:
+
+            using impl = detail::estimate_impl<cppsort::detail::remove_cvref_t<Probe>>;
+
+            std::uint64_t sample_size_;
+            double confidence_;
+            std::uint64_t seed_;
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            explicit estimate(std::uint64_t sample_size=1024, double confidence=0.95,
+                              std::uint64_t seed=0x2545f4914f6cdd1du):
+                sample_size_(sample_size == 0 ? 1 : sample_size),
+                confidence_(confidence),
+                seed_(seed)
+            {
+                CPPSORT_ASSERT(confidence > 0.0 && confidence < 1.0);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            auto sample_size() const noexcept
+                -> std::uint64_t
+            {
+                return sample_size_;
+            }
+
+            auto confidence() const noexcept
+                -> double
+            {
+                return confidence_;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Estimation
+
+            template<
+                typename RandomAccessIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, RandomAccessIterable, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return operator()(std::begin(iterable), std::end(iterable),
+                                  std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> estimate_result<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        cppsort::detail::iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "probe::estimate requires at least random-access iterators"
+                );
+
+                // Every call samples the same positions for a given
+                // size, which makes estimates reproducible
+                cppsort::detail::splitmix64 engine(seed_);
+                return impl::sample(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection),
+                                    sample_size_, confidence_, engine);
+            }
+    };
+}}
+
+#endif // CPPSORT_PROBES_ESTIMATE_H_
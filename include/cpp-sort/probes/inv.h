@@ -8,17 +8,22 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/size.h>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
 #include "../detail/count_inversions.h"
+#include "../detail/execution_policy.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/parallel_count_inversions.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -54,6 +59,35 @@ namespace probe
             );
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto parallel_inv_probe_algo(ForwardIterator first, ForwardIterator last,
+                                     cppsort::detail::difference_type_t<ForwardIterator> size,
+                                     Compare compare, Projection projection,
+                                     std::size_t nb_threads)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
+
+            if (size < 2) {
+                return 0;
+            }
+
+            auto iterators = std::make_unique<ForwardIterator[]>(size);
+            auto buffer = std::make_unique<ForwardIterator[]>(size);
+
+            auto store = iterators.get();
+            for (auto it = first; it != last; ++it) {
+                *store++ = it;
+            }
+
+            return cppsort::detail::parallel_count_inversions<difference_type>(
+                iterators.get(), iterators.get() + size, buffer.get(),
+                std::move(compare),
+                utility::indirect{} | std::move(projection),
+                nb_threads
+            );
+        }
+
         struct inv_impl
         {
             template<
@@ -89,6 +123,54 @@ namespace probe
                                       std::move(compare), std::move(projection));
             }
 
+#if CPPSORT_EXECUTION_POLICIES
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return parallel_inv_probe_algo(
+                    std::begin(iterable), std::end(iterable),
+                    utility::size(iterable),
+                    std::move(compare), std::move(projection),
+                    cppsort::detail::policy_thread_count<ExecutionPolicy>()
+                );
+            }
+
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return parallel_inv_probe_algo(
+                    first, last, std::distance(first, last),
+                    std::move(compare), std::move(projection),
+                    cppsort::detail::policy_thread_count<ExecutionPolicy>()
+                );
+            }
+
+            template<typename ExecutionPolicy>
+            using supports_execution_policy = std::true_type;
+#endif
+
             template<typename Integer>
             static constexpr auto max_for_size(Integer n)
                 -> Integer
@@ -16,6 +16,7 @@
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/simd_adjacent_find.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -60,25 +61,29 @@ namespace probe
                 while (next != last) {
 
                     if (comp(proj(*current), proj(*next))) {
-                        // Look for an ascending run
-                        do {
-                            current = next;
-                            ++next;
-                            if (next == last) {
-                                return count;
-                            }
-                        } while(not comp(proj(*next), proj(*current)));
+                        // Look for an ascending run, which ends with the
+                        // first step-down, vectorized when possible
+                        current = cppsort::detail::find_adjacent_pair(
+                            next, last, cppsort::detail::adjacent_descent{},
+                            compare, projection
+                        );
+                        if (current == last) {
+                            return count;
+                        }
+                        next = std::next(current);
                         ++count;
 
                     } else if (comp(proj(*next), proj(*current))) {
-                        // Look for a descending run
-                        do {
-                            current = next;
-                            ++next;
-                            if (next == last) {
-                                return count;
-                            }
-                        } while(not comp(proj(*current), proj(*next)));
+                        // Look for a descending run, which ends with the
+                        // first step-up, vectorized when possible
+                        current = cppsort::detail::find_adjacent_pair(
+                            next, last, cppsort::detail::adjacent_ascent{},
+                            compare, projection
+                        );
+                        if (current == last) {
+                            return count;
+                        }
+                        next = std::next(current);
                         ++count;
                     }
 
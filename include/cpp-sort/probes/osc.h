@@ -9,10 +9,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <new>
 #include <numeric>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <cpp-sort/sorter_facade.h>
@@ -21,11 +24,16 @@
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/size.h>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
 #include "../detail/equal_range.h"
+#include "../detail/execution_policy.h"
 #include "../detail/immovable_vector.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/parallel_merge_sort.h"
+#include "../detail/parallel_pdqsort.h"
 #include "../detail/pdqsort.h"
 #include "../detail/type_traits.h"
+#include "../detail/work_stealing_pool.h"
 
 namespace cppsort
 {
@@ -172,6 +180,125 @@ namespace probe
             }
         }
 
+        template<typename ForwardIterator, typename RandomAccessIterator,
+                 typename Compare, typename Projection>
+        auto osc_slice(ForwardIterator first, cppsort::detail::difference_type_t<ForwardIterator> nb_pairs,
+                       RandomAccessIterator sorted_first, RandomAccessIterator sorted_last,
+                       Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            // Oscillation of the nb_pairs pairs of adjacent elements
+            // starting at first: since every pair adds 1 to cross[k]
+            // for every k in [min_idx, max_idx) in the allocating
+            // algorithm, its contribution to the result is simply
+            // max_idx - min_idx
+
+            using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto prev_bounds = cppsort::detail::equal_range(
+                sorted_first, sorted_last, proj(*first),
+                compare, utility::indirect{} | projection
+            );
+
+            difference_type res = 0;
+            auto prev = first;
+            auto current = std::next(first);
+            for (; nb_pairs > 0 ; --nb_pairs, (void)++prev, (void)++current) {
+                if (comp(proj(*prev), proj(*current))) {
+                    auto current_bounds = cppsort::detail::equal_range(
+                        sorted_first, sorted_last, proj(*current),
+                        compare, utility::indirect{} | projection
+                    );
+                    res += current_bounds.first - prev_bounds.second;
+                    prev_bounds = current_bounds;
+                } else if (comp(proj(*current), proj(*prev))) {
+                    auto current_bounds = cppsort::detail::equal_range(
+                        sorted_first, sorted_last, proj(*current),
+                        compare, utility::indirect{} | projection
+                    );
+                    res += prev_bounds.first - current_bounds.second;
+                    prev_bounds = current_bounds;
+                }
+            }
+            return res;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto parallel_allocating_osc_algo(ForwardIterator first, ForwardIterator last,
+                                          cppsort::detail::difference_type_t<ForwardIterator> size,
+                                          Compare compare, Projection projection,
+                                          std::size_t nb_threads)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
+
+            // Split the pairs of adjacent elements into a few slices
+            // per thread so that threads which are done early can
+            // steal some of the work
+            auto nb_slices = 4 * static_cast<difference_type>(nb_threads);
+            auto slice_size = (std::max)(
+                static_cast<difference_type>(cppsort::detail::parallel_merge_sort_detail::min_merge_slice),
+                (size - 1 + nb_slices - 1) / nb_slices
+            );
+
+            // Copy the iterators in a vector, remembering where
+            // every slice starts along the way
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            std::vector<ForwardIterator> slice_starts;
+            difference_type idx = 0;
+            for (auto it = first; it != last; ++it, (void)++idx) {
+                if (idx % slice_size == 0 && idx < size - 1) {
+                    slice_starts.push_back(it);
+                }
+                iterators.emplace_back(it);
+            }
+
+            cppsort::detail::parallel_pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection,
+                nb_threads
+            );
+
+            cppsort::detail::work_stealing_pool pool(nb_threads);
+            std::atomic<difference_type> res(0);
+            for (std::size_t slice = 0 ; slice < slice_starts.size() ; ++slice) {
+                auto slice_begin = static_cast<difference_type>(slice) * slice_size;
+                auto nb_pairs = (std::min)(slice_size, size - 1 - slice_begin);
+                auto slice_first = slice_starts[slice];
+                pool.submit([=, &iterators, &res] {
+                    res += osc_slice(slice_first, nb_pairs,
+                                     iterators.begin(), iterators.end(),
+                                     compare, projection);
+                });
+            }
+            pool.wait();
+            return res.load();
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto parallel_osc_algo(ForwardIterator first, ForwardIterator last,
+                               cppsort::detail::difference_type_t<ForwardIterator> size,
+                               Compare compare, Projection projection,
+                               std::size_t nb_threads)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (nb_threads < 2 || size < cppsort::detail::parallel_merge_sort_detail::parallel_threshold) {
+                return osc_algo(first, last, size, std::move(compare), std::move(projection));
+            }
+
+            try {
+                return parallel_allocating_osc_algo(first, last, size, compare, projection,
+                                                    nb_threads);
+            } catch (std::bad_alloc&) {
+                return inplace_osc_algo(
+                    first, last, size,
+                    std::move(compare), std::move(projection)
+                );
+            }
+        }
+
         struct osc_impl
         {
             template<
@@ -206,6 +333,50 @@ namespace probe
                                 std::move(compare), std::move(projection));
             }
 
+#if CPPSORT_EXECUTION_POLICIES
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return parallel_osc_algo(std::begin(iterable), std::end(iterable),
+                                         utility::size(iterable),
+                                         std::move(compare), std::move(projection),
+                                         cppsort::detail::policy_thread_count<ExecutionPolicy>());
+            }
+
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return parallel_osc_algo(first, last, std::distance(first, last),
+                                         std::move(compare), std::move(projection),
+                                         cppsort::detail::policy_thread_count<ExecutionPolicy>());
+            }
+
+            template<typename ExecutionPolicy>
+            using supports_execution_policy = std::true_type;
+#endif
+
             template<typename Integer>
             static constexpr auto max_for_size(Integer n)
                 -> Integer
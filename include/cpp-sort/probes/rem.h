@@ -8,16 +8,23 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/size.h>
 #include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
+#include "../detail/execution_policy.h"
+#include "../detail/iterator_traits.h"
 #include "../detail/longest_non_descending_subsequence.h"
+#include "../detail/parallel_longest_non_descending_subsequence.h"
 #include "../detail/type_traits.h"
+#include "../detail/work_stealing_pool.h"
 
 namespace cppsort
 {
@@ -25,6 +32,34 @@ namespace probe
 {
     namespace detail
     {
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto parallel_rem_algo(ForwardIterator first, ForwardIterator last,
+                               Compare compare, Projection projection,
+                               std::size_t, std::forward_iterator_tag)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            // The parallel algorithm needs to traverse the second
+            // half of the collection backward
+            auto res = cppsort::detail::longest_non_descending_subsequence<true>(
+                first, last, 0, std::move(compare), std::move(projection)
+            );
+            auto lnds_size = res.second - res.first;
+            return lnds_size >= 0 ? lnds_size : 0;
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto parallel_rem_algo(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::size_t nb_threads, std::random_access_iterator_tag)
+            -> ::cppsort::detail::difference_type_t<RandomAccessIterator>
+        {
+            auto res = cppsort::detail::parallel_longest_non_descending_subsequence(
+                first, last, std::move(compare), std::move(projection), nb_threads
+            );
+            auto lnds_size = res.second - res.first;
+            return lnds_size >= 0 ? lnds_size : 0;
+        }
+
         struct rem_impl
         {
             template<
@@ -83,6 +118,51 @@ namespace probe
                 return lnds_size >= 0 ? lnds_size : 0;
             }
 
+#if CPPSORT_EXECUTION_POLICIES
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&& policy, ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return operator()(std::forward<ExecutionPolicy>(policy),
+                                  std::begin(iterable), std::end(iterable),
+                                  std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    cppsort::detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return parallel_rem_algo(
+                    first, last, std::move(compare), std::move(projection),
+                    cppsort::detail::policy_thread_count<ExecutionPolicy>(),
+                    cppsort::detail::iterator_category_t<ForwardIterator>{}
+                );
+            }
+
+            template<typename ExecutionPolicy>
+            using supports_execution_policy = std::true_type;
+#endif
+
             template<typename Integer>
             static constexpr auto max_for_size(Integer n)
                 -> Integer
@@ -9,13 +9,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <functional>
-#include <iterator>
+#include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
-#include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
+#include "../detail/simd_adjacent_find.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -38,30 +38,12 @@ namespace probe
                             Compare compare={}, Projection projection={}) const
                 -> cppsort::detail::difference_type_t<ForwardIterator>
             {
-                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
-                auto&& comp = utility::as_function(compare);
-                auto&& proj = utility::as_function(projection);
-
-                if (first == last || std::next(first) == last) {
-                    return 0;
-                }
-
-                auto current = first;
-                auto next = std::next(first);
-
-                difference_type count = 0;
-                while (true) {
-                    while (next != last && not comp(proj(*next), proj(*current))) {
-                        ++current;
-                        ++next;
-                    }
-
-                    if (next == last) break;
-                    ++count;
-                    ++current;
-                    ++next;
-                }
-                return count;
+                // Count the step-downs, vectorized when possible
+                return cppsort::detail::count_adjacent_pairs(
+                    std::move(first), std::move(last),
+                    cppsort::detail::adjacent_descent{},
+                    std::move(compare), std::move(projection)
+                );
             }
 
             template<typename Integer>
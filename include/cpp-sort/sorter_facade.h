@@ -16,6 +16,7 @@
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/functional.h>
 #include "detail/config.h"
+#include "detail/execution_policy.h"
 #include "detail/type_traits.h"
 
 namespace cppsort
@@ -1172,6 +1173,54 @@ namespace cppsort
                 refined<decltype(*std::begin(iterable))>(std::move(compare)),
                 refined<decltype(*std::begin(iterable))>(std::move(projection))));
         }
+
+#if CPPSORT_EXECUTION_POLICIES
+        ////////////////////////////////////////////////////////////
+        // Execution policy overloads
+
+        // Sorters that support an execution policy receive it along
+        // with the other parameters, an iterable being passed as a
+        // pair of iterators if needed; the policy is dropped for the
+        // other sorters, which then sort sequentially
+
+        template<typename ExecutionPolicy, typename... Args>
+        constexpr auto operator()(ExecutionPolicy&& policy, Args&&... args) const
+            -> detail::enable_if_t<
+                supports_execution_policy<Sorter, ExecutionPolicy>::value,
+                decltype(Sorter::operator()(std::forward<ExecutionPolicy>(policy),
+                                            std::forward<Args>(args)...))
+            >
+        {
+            return Sorter::operator()(std::forward<ExecutionPolicy>(policy),
+                                      std::forward<Args>(args)...);
+        }
+
+        template<typename ExecutionPolicy, typename Iterable, typename... Args>
+        constexpr auto operator()(ExecutionPolicy&& policy, Iterable&& iterable, Args&&... args) const
+            -> detail::enable_if_t<
+                supports_execution_policy<Sorter, ExecutionPolicy>::value &&
+                not detail::is_invocable<Sorter, ExecutionPolicy, Iterable, Args...>::value,
+                decltype(Sorter::operator()(std::forward<ExecutionPolicy>(policy),
+                                            std::begin(iterable), std::end(iterable),
+                                            std::forward<Args>(args)...))
+            >
+        {
+            return Sorter::operator()(std::forward<ExecutionPolicy>(policy),
+                                      std::begin(iterable), std::end(iterable),
+                                      std::forward<Args>(args)...);
+        }
+
+        template<typename ExecutionPolicy, typename... Args>
+        constexpr auto operator()(ExecutionPolicy&&, Args&&... args) const
+            -> detail::enable_if_t<
+                detail::is_execution_policy<ExecutionPolicy>::value &&
+                not supports_execution_policy<Sorter, ExecutionPolicy>::value,
+                decltype(operator()(std::forward<Args>(args)...))
+            >
+        {
+            return operator()(std::forward<Args>(args)...);
+        }
+#endif
     };
 }
 
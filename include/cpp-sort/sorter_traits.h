@@ -14,6 +14,7 @@
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/functional.h>
+#include "detail/execution_policy.h"
 #include "detail/raw_checkers.h"
 #include "detail/type_traits.h"
 
@@ -68,6 +69,16 @@ namespace cppsort
 
     namespace detail
     {
+        // Comparison used to check that a sorter can sort the values
+        // returned by a projection: sorters that don't take a
+        // comparison but order the keys in their own way can define
+        // it as key_compare, std::less<> is used otherwise
+        template<typename Sorter>
+        using key_compare_t = typename Sorter::key_compare;
+
+        template<typename Sorter>
+        using sorter_key_compare_t = typename detector<std::less<>, void, key_compare_t, Sorter>::type;
+
         template<typename Sorter, typename Iterable>
         struct has_sort:
             is_invocable<Sorter, Iterable&>
@@ -85,7 +96,7 @@ namespace cppsort
         struct has_projection_sort:
             conjunction<
                 is_invocable<Sorter, Iterable&, Projection>,
-                is_projection<Projection, Iterable>
+                is_projection<Projection, Iterable, sorter_key_compare_t<Sorter>>
             >
         {};
 
@@ -114,7 +125,7 @@ namespace cppsort
         struct has_projection_sort_iterator:
             conjunction<
                 is_invocable<Sorter, Iterator, Iterator, Projection>,
-                is_projection_iterator<Projection, Iterator>
+                is_projection_iterator<Projection, Iterator, sorter_key_compare_t<Sorter>>
             >
         {};
 
@@ -237,6 +248,44 @@ namespace cppsort
     template<typename Arg>
     constexpr bool is_stable_v = is_stable<Arg>::value;
 
+    ////////////////////////////////////////////////////////////
+    // Whether a sorter handles a given execution policy by
+    // itself, sorter_facade makes other sorters ignore the
+    // execution policies and sort sequentially
+
+    namespace detail
+    {
+        template<typename Sorter, typename ExecutionPolicy>
+        using supports_execution_policy_t
+            = typename Sorter::template supports_execution_policy<ExecutionPolicy>;
+
+        template<typename Sorter, typename ExecutionPolicy, typename=void>
+        struct raw_supports_execution_policy:
+            std::false_type
+        {};
+
+        template<typename Sorter, typename ExecutionPolicy>
+        struct raw_supports_execution_policy<
+            Sorter,
+            ExecutionPolicy,
+            void_t<supports_execution_policy_t<Sorter, ExecutionPolicy>>
+        >:
+            supports_execution_policy_t<Sorter, ExecutionPolicy>
+        {};
+    }
+
+    template<typename Sorter, typename ExecutionPolicy>
+    struct supports_execution_policy:
+        detail::conjunction<
+            detail::is_execution_policy<ExecutionPolicy>,
+            detail::raw_supports_execution_policy<Sorter, ExecutionPolicy>
+        >
+    {};
+
+    template<typename Sorter, typename ExecutionPolicy>
+    constexpr bool supports_execution_policy_v
+        = supports_execution_policy<Sorter, ExecutionPolicy>::value;
+
     ////////////////////////////////////////////////////////////
     // Fixed-size sorter traits
 
@@ -9,6 +9,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cpp-sort/sorters/adaptive_shivers_sorter.h>
+#include <cpp-sort/sorters/auto_sorter.h>
 #include <cpp-sort/sorters/block_sorter.h>
 #include <cpp-sort/sorters/cartesian_tree_sorter.h>
 #include <cpp-sort/sorters/counting_sorter.h>
@@ -18,9 +19,15 @@
 #include <cpp-sort/sorters/grail_sorter.h>
 #include <cpp-sort/sorters/heap_sorter.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
 #include <cpp-sort/sorters/mel_sorter.h>
 #include <cpp-sort/sorters/merge_insertion_sorter.h>
 #include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/nth_element_sorter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sorters/partial_sorter.h>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/poplar_sorter.h>
 #include <cpp-sort/sorters/quick_merge_sorter.h>
@@ -35,6 +42,7 @@
 #include <cpp-sort/sorters/split_sorter.h>
 #include <cpp-sort/sorters/std_sorter.h>
 #include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/top_k_sorter.h>
 #include <cpp-sort/sorters/verge_sorter.h>
 #include <cpp-sort/sorters/wiki_sorter.h>
 
@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_AUTO_SORTER_H_
+#define CPPSORT_SORTERS_AUTO_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/adapters/drop_merge_adapter.h>
+#include <cpp-sort/adapters/split_adapter.h>
+#include <cpp-sort/adapters/verge_adapter.h>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/probes/estimate.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/counting_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/bitops.h"
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/ska_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Decision table
+
+    enum class auto_sorter_choice
+    {
+        counting,   // counting_sorter
+        ska,        // ska_sorter
+        verge,      // verge_adapter<pdq_sorter>
+        drop_merge, // drop_merge_adapter<pdq_sorter>
+        split,      // split_adapter<pdq_sorter>
+        pdq         // pdq_sorter
+    };
+
+    // Properties of the collection measured before sorting
+    struct auto_sorter_features
+    {
+        // Number of elements
+        std::ptrdiff_t size = 0;
+        // Exact number of step downs, probe::runs
+        std::ptrdiff_t runs = 0;
+        // Sampled number of inversions divided by its maximum
+        double inversion_ratio = 0.0;
+        // Whether the keys can be sorted with ska_sorter
+        bool radix_sortable = false;
+        // Whether the elements can be sorted with counting_sorter
+        bool countable = false;
+        // Whether the keys are integers, the fields below are
+        // only meaningful when they are
+        bool integral_key = false;
+        // Difference between the biggest and smallest keys
+        std::uint64_t key_range = 0;
+        // Number of bits needed to represent key_range
+        int key_width = 0;
+    };
+
+    struct auto_sorter_decision
+    {
+        auto_sorter_choice choice;
+        // Human-readable explanation of the choice
+        const char* reason;
+        auto_sorter_features features;
+    };
+
+    // Default decision table, the thresholds can be tuned with the
+    // benchmarks/presortedness/tune-auto-sorter.cpp program
+    struct auto_sorter_table
+    {
+        // Below this size, directly use pdq_sorter
+        std::ptrdiff_t small_size = 128;
+        // Use counting_sorter when the range of the keys is smaller
+        // than this proportion of the size
+        double counting_max_range_ratio = 2.0;
+        // Use verge_adapter when the proportion of step downs among
+        // the adjacent pairs is below the first value or above the
+        // second one (mostly descending runs)
+        double verge_max_runs_ratio = 0.01;
+        double verge_min_runs_ratio = 0.99;
+        // The Rem-adaptive algorithms are only considered when the
+        // proportion of step downs is below this value, otherwise
+        // the disorder is mostly local
+        double rem_adaptive_max_runs_ratio = 0.2;
+        // Use split_adapter or drop_merge_adapter when the sampled
+        // proportion of inversions is below these values
+        double split_max_inversion_ratio = 0.001;
+        double drop_merge_max_inversion_ratio = 0.1;
+        // Use ska_sorter from this size, or from the smaller size
+        // when the integer keys fit in narrow_key_width bits
+        std::ptrdiff_t radix_min_size = 4096;
+        std::ptrdiff_t narrow_radix_min_size = 512;
+        int narrow_key_width = 16;
+
+        auto choose(const auto_sorter_features& features) const
+            -> auto_sorter_decision
+        {
+            if (features.size < small_size) {
+                return { auto_sorter_choice::pdq, "small collection", features };
+            }
+
+            if (features.countable &&
+                static_cast<double>(features.key_range) < counting_max_range_ratio * static_cast<double>(features.size)) {
+                return { auto_sorter_choice::counting, "dense integer keys", features };
+            }
+
+            auto runs_ratio = static_cast<double>(features.runs)
+                            / static_cast<double>(features.size - 1);
+            if (runs_ratio <= verge_max_runs_ratio) {
+                return { auto_sorter_choice::verge, "few ascending runs", features };
+            }
+            if (runs_ratio >= verge_min_runs_ratio) {
+                return { auto_sorter_choice::verge, "few descending runs", features };
+            }
+
+            if (runs_ratio <= rem_adaptive_max_runs_ratio) {
+                if (features.inversion_ratio <= split_max_inversion_ratio) {
+                    return { auto_sorter_choice::split, "very few inversions", features };
+                }
+                if (features.inversion_ratio <= drop_merge_max_inversion_ratio) {
+                    return { auto_sorter_choice::drop_merge, "few elements out of place", features };
+                }
+            }
+
+            if (features.radix_sortable) {
+                if (features.size >= radix_min_size) {
+                    return { auto_sorter_choice::ska, "large collection of radix-sortable keys", features };
+                }
+                if (features.integral_key && features.key_width <= narrow_key_width &&
+                    features.size >= narrow_radix_min_size) {
+                    return { auto_sorter_choice::ska, "narrow integer keys", features };
+                }
+            }
+
+            return { auto_sorter_choice::pdq, "no exploitable structure", features };
+        }
+    };
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Applicability of the type-specific sorters
+
+        template<typename Compare, typename Key>
+        struct is_auto_less:
+            disjunction<
+                std::is_same<Compare, std::less<>>,
+                std::is_same<Compare, std::less<Key>>
+#ifdef __cpp_lib_ranges
+                , std::is_same<Compare, std::ranges::less>
+#endif
+            >
+        {};
+
+        template<typename Iterator, typename Compare, typename Projection>
+        struct is_auto_radix_sortable:
+            conjunction<
+                is_ska_sortable<remove_cvref_t<projected_t<Iterator, Projection>>>,
+                is_auto_less<Compare, remove_cvref_t<projected_t<Iterator, Projection>>>
+            >
+        {};
+
+        // Integer keys whose range fits in auto_sorter_features::key_range,
+        // counting_sorter is only considered for them since the decision
+        // depends on that range
+        template<typename T>
+        struct has_auto_key_range:
+            std::integral_constant<bool,
+                std::is_integral<T>::value &&
+                not std::is_same<T, bool>::value &&
+                sizeof(T) <= sizeof(std::uint64_t)
+            >
+        {};
+
+        template<typename Iterator, typename Compare, typename Projection>
+        struct is_auto_countable:
+            conjunction<
+                is_integral<value_type_t<Iterator>>,
+                has_auto_key_range<value_type_t<Iterator>>,
+                disjunction<
+                    std::is_same<Projection, utility::identity>
+#if CPPSORT_STD_IDENTITY_AVAILABLE
+                    , std::is_same<Projection, std::identity>
+#endif
+                >,
+                is_auto_less<Compare, value_type_t<Iterator>>
+            >
+        {};
+
+        // Number of pairs sampled to estimate the inversions
+        constexpr std::uint64_t auto_sorter_inversion_samples = 1024;
+
+        ////////////////////////////////////////////////////////////
+        // Features computation
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto compute_key_range(RandomAccessIterator first, RandomAccessIterator last,
+                               Projection projection, auto_sorter_features& features,
+                               std::true_type /* integral key */)
+            -> void
+        {
+            auto&& proj = utility::as_function(projection);
+            using key_type = remove_cvref_t<projected_t<RandomAccessIterator, Projection>>;
+            key_type min = proj(*first);
+            key_type max = min;
+            for (++first; first != last; ++first) {
+                key_type key = proj(*first);
+                min = key < min ? key : min;
+                max = max < key ? key : max;
+            }
+            // Modular arithmetic gives the right difference for
+            // signed types too
+            features.integral_key = true;
+            features.key_range = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min);
+            features.key_width = features.key_range == 0 ? 0 : static_cast<int>(detail::log2(features.key_range)) + 1;
+        }
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto compute_key_range(RandomAccessIterator, RandomAccessIterator,
+                               Projection, auto_sorter_features&,
+                               std::false_type /* integral key */)
+            -> void
+        {}
+
+        // Tables with a small_size member directly pick an algorithm below
+        // that size, so the features don't need to be measured for them
+        template<typename Table>
+        using has_small_size_t = decltype(std::declval<const Table&>().small_size);
+
+        template<typename Table>
+        auto auto_sorter_small_size(const Table& table, std::true_type)
+            -> std::ptrdiff_t
+        {
+            return static_cast<std::ptrdiff_t>(table.small_size);
+        }
+
+        template<typename Table>
+        auto auto_sorter_small_size(const Table&, std::false_type)
+            -> std::ptrdiff_t
+        {
+            return 0;
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto compute_auto_sorter_features(RandomAccessIterator first, RandomAccessIterator last,
+                                          Compare compare, Projection projection,
+                                          std::ptrdiff_t small_size)
+            -> auto_sorter_features
+        {
+            using key_type = remove_cvref_t<projected_t<RandomAccessIterator, Projection>>;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto_sorter_features features;
+            features.size = last - first;
+            features.radix_sortable = is_auto_radix_sortable<RandomAccessIterator, Compare, Projection>::value;
+            features.countable = is_auto_countable<RandomAccessIterator, Compare, Projection>::value;
+            if (features.size < 2 || features.size < small_size) {
+                return features;
+            }
+
+            // Single linear pass for the runs
+            std::ptrdiff_t runs = 0;
+            for (auto it = first + 1; it != last; ++it) {
+                runs += comp(proj(*it), proj(it[-1]));
+            }
+            features.runs = runs;
+
+            // The key range is only used to choose between the
+            // type-specific sorters, don't pay for it otherwise
+            compute_key_range(first, last, projection, features,
+                              std::integral_constant<bool,
+                                  (is_auto_countable<RandomAccessIterator, Compare, Projection>::value ||
+                                   is_auto_radix_sortable<RandomAccessIterator, Compare, Projection>::value) &&
+                                  has_auto_key_range<key_type>::value
+                              >{});
+
+            auto inversions = probe::estimate<decltype(probe::inv)>(auto_sorter_inversion_samples)(
+                first, last, compare, projection
+            );
+            features.inversion_ratio = static_cast<double>(inversions.value)
+                                     / static_cast<double>(probe::inv.max_for_size(features.size));
+            return features;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Dispatch, the type-specific sorters fall back to pdq_sorter
+        // when a custom table picks them for unsupported types
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto auto_sort_counting(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare, Projection, std::true_type)
+            -> void
+        {
+            counting_sorter{}(std::move(first), std::move(last));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto auto_sort_counting(RandomAccessIterator first, RandomAccessIterator last,
+                                Compare compare, Projection projection, std::false_type)
+            -> void
+        {
+            pdq_sorter{}(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto auto_sort_ska(RandomAccessIterator first, RandomAccessIterator last,
+                           Compare, Projection projection, std::true_type)
+            -> void
+        {
+            ska_sorter{}(std::move(first), std::move(last), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto auto_sort_ska(RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection, std::false_type)
+            -> void
+        {
+            pdq_sorter{}(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto auto_sort_with(auto_sorter_choice choice,
+                            RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection)
+            -> void
+        {
+            switch (choice) {
+                case auto_sorter_choice::counting:
+                    auto_sort_counting(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection),
+                                       is_auto_countable<RandomAccessIterator, Compare, Projection>{});
+                    return;
+                case auto_sorter_choice::ska:
+                    auto_sort_ska(std::move(first), std::move(last),
+                                  std::move(compare), std::move(projection),
+                                  is_auto_radix_sortable<RandomAccessIterator, Compare, Projection>{});
+                    return;
+                case auto_sorter_choice::verge:
+                    verge_adapter<pdq_sorter>{}(std::move(first), std::move(last),
+                                                std::move(compare), std::move(projection));
+                    return;
+                case auto_sorter_choice::drop_merge:
+                    drop_merge_adapter<pdq_sorter>{}(std::move(first), std::move(last),
+                                                     std::move(compare), std::move(projection));
+                    return;
+                case auto_sorter_choice::split:
+                    split_adapter<pdq_sorter>{}(std::move(first), std::move(last),
+                                                std::move(compare), std::move(projection));
+                    return;
+                case auto_sorter_choice::pdq:
+                    break;
+            }
+            pdq_sorter{}(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Sorter
+
+        template<typename Table>
+        struct auto_sorter_impl
+        {
+            Table table;
+
+            auto_sorter_impl() = default;
+
+            constexpr explicit auto_sorter_impl(Table table):
+                table(std::move(table))
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto decide(RandomAccessIterator first, RandomAccessIterator last,
+                        Compare compare={}, Projection projection={}) const
+                -> auto_sorter_decision
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "auto_sorter requires at least random-access iterators"
+                );
+
+                return table.choose(compute_auto_sorter_features(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection),
+                    auto_sorter_small_size(table, is_detected<has_small_size_t, Table>{})
+                ));
+            }
+
+            template<
+                typename RandomAccessIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_v<Projection, RandomAccessIterable, Compare>
+                >
+            >
+            auto decide(RandomAccessIterable&& iterable,
+                        Compare compare={}, Projection projection={}) const
+                -> auto_sorter_decision
+            {
+                return decide(std::begin(iterable), std::end(iterable),
+                              std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                auto decision = decide(first, last, compare, projection);
+                auto_sort_with(decision.choice, std::move(first), std::move(last),
+                               std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    template<typename Table=auto_sorter_table>
+    struct auto_sorter:
+        sorter_facade<detail::auto_sorter_impl<Table>>
+    {
+        auto_sorter() = default;
+
+        constexpr explicit auto_sorter(Table table):
+            sorter_facade<detail::auto_sorter_impl<Table>>(std::move(table))
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& auto_sort
+            = utility::static_const<auto_sorter<>>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_AUTO_SORTER_H_
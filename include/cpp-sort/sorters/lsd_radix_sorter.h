@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+#define CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/insertion_sort.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/lsd_radix_sort.h"
+#include "../detail/memory.h"
+#include "../detail/merge_sort.h"
+#include "../detail/ska_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Keys handled by lsd_radix_sorter
+        //
+        // Composite keys are sorted field by field, from the least
+        // significant one to the most significant one, each field
+        // being sorted with a stable LSD radix sort. Fields are read
+        // through visitors, which call a function on the field of
+        // the projected element: that way temporaries returned by
+        // the projection live long enough to extract digits from
+        // them. Every key also provides a three-way comparison used
+        // by the comparison sorts that handle small collections.
+
+        template<typename T>
+        struct is_lsd_radix_scalar:
+            is_integral<T>
+        {};
+
+        template<typename T>
+        struct is_lsd_radix_scalar<T*>:
+            std::true_type
+        {};
+
+        template<>
+        struct is_lsd_radix_scalar<float>:
+            is_ska_sortable<float>
+        {};
+
+        template<>
+        struct is_lsd_radix_scalar<double>:
+            is_ska_sortable<double>
+        {};
+
+        template<typename T>
+        using lsd_radix_list_element_t = remove_cvref_t<decltype(std::declval<const T&>()[0])>;
+
+        template<typename T>
+        using lsd_radix_list_size_t = decltype(std::declval<const T&>().size());
+
+        // Sequences of small integers such as strings, sorted one
+        // position at a time: the keys need one more value than the
+        // elements to order a missing element before the others
+        template<typename T, typename Element=detected_t<lsd_radix_list_element_t, T>>
+        struct is_lsd_radix_list:
+            std::integral_constant<bool,
+                is_integral<Element>::value &&
+                sizeof(Element) <= sizeof(std::uint32_t) &&
+                is_detected<lsd_radix_list_size_t, T>::value &&
+                not has_radix_sort_key<T>::value
+            >
+        {};
+
+        template<typename Visitor, typename Getter>
+        auto make_lsd_radix_field_visitor(Visitor visit, Getter get)
+        {
+            return [visit=std::move(visit), get=std::move(get)](const auto& value, auto func) {
+                return visit(value, [&](const auto& key) {
+                    return func(get(key));
+                });
+            };
+        }
+
+        template<typename T, typename=void>
+        struct lsd_radix_key:
+            std::false_type
+        {};
+
+        template<typename T>
+        struct lsd_radix_key<T, detail::enable_if_t<is_lsd_radix_scalar<T>::value>>:
+            std::true_type
+        {
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                             value_type_t<RandomAccessIterator>* buffer, Visitor visit)
+                -> void
+            {
+                // Reuse the unsigned keys computed by ska_sort
+                lsd_radix_sort(std::move(first), std::move(last), buffer,
+                               [visit=std::move(visit)](const auto& value) {
+                                   return visit(value, [](const auto& key) {
+                                       return to_unsigned_or_bool(key);
+                                   });
+                               });
+            }
+
+            static auto compare(const T& lhs, const T& rhs)
+                -> int
+            {
+                auto lhs_key = to_unsigned_or_bool(lhs);
+                auto rhs_key = to_unsigned_or_bool(rhs);
+                return (rhs_key < lhs_key) - (lhs_key < rhs_key);
+            }
+        };
+
+        template<typename T>
+        struct lsd_radix_key<T, detail::enable_if_t<is_lsd_radix_list<T>::value>>:
+            std::true_type
+        {
+            using element_key_type = decltype(to_unsigned_or_bool(std::declval<lsd_radix_list_element_t<T>>()));
+            using key_type = typename UnsignedForSize<2 * sizeof(element_key_type)>::type;
+
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                             value_type_t<RandomAccessIterator>* buffer, Visitor visit)
+                -> void
+            {
+                // The longest list gives the number of passes
+                std::size_t max_size = 0;
+                for (auto it = first ; it != last ; ++it) {
+                    max_size = (std::max)(max_size, visit(*it, [](const auto& list) {
+                        return static_cast<std::size_t>(list.size());
+                    }));
+                }
+
+                for (std::size_t pos = max_size ; pos > 0 ; --pos) {
+                    std::size_t index = pos - 1;
+                    lsd_radix_sort(first, last, buffer, [visit, index](const auto& value) {
+                        return visit(value, [index](const auto& list) {
+                            if (index >= static_cast<std::size_t>(list.size())) {
+                                return key_type(0);
+                            }
+                            return static_cast<key_type>(static_cast<key_type>(to_unsigned_or_bool(list[index])) + 1);
+                        });
+                    });
+                }
+            }
+
+            static auto compare(const T& lhs, const T& rhs)
+                -> int
+            {
+                auto lhs_size = static_cast<std::size_t>(lhs.size());
+                auto rhs_size = static_cast<std::size_t>(rhs.size());
+                auto size = (std::min)(lhs_size, rhs_size);
+                for (std::size_t idx = 0 ; idx < size ; ++idx) {
+                    auto lhs_key = to_unsigned_or_bool(lhs[idx]);
+                    auto rhs_key = to_unsigned_or_bool(rhs[idx]);
+                    if (lhs_key != rhs_key) {
+                        return lhs_key < rhs_key ? -1 : 1;
+                    }
+                }
+                return (rhs_size < lhs_size) - (lhs_size < rhs_size);
+            }
+        };
+
+        template<typename T, typename U>
+        struct lsd_radix_key<std::pair<T, U>>:
+            std::integral_constant<bool,
+                lsd_radix_key<remove_cvref_t<T>>::value &&
+                lsd_radix_key<remove_cvref_t<U>>::value
+            >
+        {
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                             value_type_t<RandomAccessIterator>* buffer, Visitor visit)
+                -> void
+            {
+                lsd_radix_key<remove_cvref_t<U>>::sort(
+                    first, last, buffer,
+                    make_lsd_radix_field_visitor(visit, [](const auto& pair) -> decltype(auto) {
+                        return (pair.second);
+                    })
+                );
+                lsd_radix_key<remove_cvref_t<T>>::sort(
+                    std::move(first), std::move(last), buffer,
+                    make_lsd_radix_field_visitor(std::move(visit), [](const auto& pair) -> decltype(auto) {
+                        return (pair.first);
+                    })
+                );
+            }
+
+            static auto compare(const std::pair<T, U>& lhs, const std::pair<T, U>& rhs)
+                -> int
+            {
+                int res = lsd_radix_key<remove_cvref_t<T>>::compare(lhs.first, rhs.first);
+                if (res != 0) {
+                    return res;
+                }
+                return lsd_radix_key<remove_cvref_t<U>>::compare(lhs.second, rhs.second);
+            }
+        };
+
+        template<typename... Args>
+        struct lsd_radix_key<std::tuple<Args...>>:
+            std::integral_constant<bool,
+                conjunction<lsd_radix_key<remove_cvref_t<Args>>...>::value
+            >
+        {
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                             value_type_t<RandomAccessIterator>* buffer, Visitor visit)
+                -> void
+            {
+                sort_fields(std::move(first), std::move(last), buffer, std::move(visit),
+                            std::integral_constant<std::size_t, sizeof...(Args)>{});
+            }
+
+            static auto compare(const std::tuple<Args...>& lhs, const std::tuple<Args...>& rhs)
+                -> int
+            {
+                return compare_fields(lhs, rhs, std::integral_constant<std::size_t, 0>{});
+            }
+
+        private:
+
+            template<std::size_t Index>
+            using field_key = lsd_radix_key<
+                remove_cvref_t<std::tuple_element_t<Index, std::tuple<Args...>>>
+            >;
+
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort_fields(RandomAccessIterator, RandomAccessIterator,
+                                    value_type_t<RandomAccessIterator>*, Visitor,
+                                    std::integral_constant<std::size_t, 0>)
+                -> void
+            {}
+
+            template<typename RandomAccessIterator, typename Visitor, std::size_t Size>
+            static auto sort_fields(RandomAccessIterator first, RandomAccessIterator last,
+                                    value_type_t<RandomAccessIterator>* buffer, Visitor visit,
+                                    std::integral_constant<std::size_t, Size>)
+                -> void
+            {
+                // Least significant field first
+                field_key<Size - 1>::sort(
+                    first, last, buffer,
+                    make_lsd_radix_field_visitor(visit, [](const auto& tuple) -> decltype(auto) {
+                        return std::get<Size - 1>(tuple);
+                    })
+                );
+                sort_fields(std::move(first), std::move(last), buffer, std::move(visit),
+                            std::integral_constant<std::size_t, Size - 1>{});
+            }
+
+            static auto compare_fields(const std::tuple<Args...>&, const std::tuple<Args...>&,
+                                       std::integral_constant<std::size_t, sizeof...(Args)>)
+                -> int
+            {
+                return 0;
+            }
+
+            template<std::size_t Index>
+            static auto compare_fields(const std::tuple<Args...>& lhs, const std::tuple<Args...>& rhs,
+                                       std::integral_constant<std::size_t, Index>)
+                -> int
+            {
+                int res = field_key<Index>::compare(std::get<Index>(lhs), std::get<Index>(rhs));
+                if (res != 0) {
+                    return res;
+                }
+                return compare_fields(lhs, rhs, std::integral_constant<std::size_t, Index + 1>{});
+            }
+        };
+
+        template<typename T>
+        struct lsd_radix_key<T, detail::enable_if_t<has_radix_sort_key<T>::value>>:
+            std::integral_constant<bool,
+                lsd_radix_key<radix_sort_key_t<T>>::value
+            >
+        {
+            template<typename RandomAccessIterator, typename Visitor>
+            static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                             value_type_t<RandomAccessIterator>* buffer, Visitor visit)
+                -> void
+            {
+                lsd_radix_key<radix_sort_key_t<T>>::sort(
+                    std::move(first), std::move(last), buffer,
+                    make_lsd_radix_field_visitor(std::move(visit), [](const auto& value) {
+                        return to_radix_sort_key(value);
+                    })
+                );
+            }
+
+            static auto compare(const T& lhs, const T& rhs)
+                -> int
+            {
+                return lsd_radix_key<radix_sort_key_t<T>>::compare(to_radix_sort_key(lhs),
+                                                                    to_radix_sort_key(rhs));
+            }
+        };
+
+        template<typename T>
+        struct is_lsd_radix_sortable:
+            lsd_radix_key<T>
+        {};
+
+        struct lsd_radix_key_less
+        {
+            template<typename T>
+            auto operator()(const T& lhs, const T& rhs) const
+                -> bool
+            {
+                return lsd_radix_key<T>::compare(lhs, rhs) < 0;
+            }
+        };
+
+        template<typename Projection>
+        auto make_lsd_radix_visitor(Projection projection)
+        {
+            return [projection=std::move(projection)](const auto& value, auto func) {
+                auto&& proj = utility::as_function(projection);
+                return func(proj(value));
+            };
+        }
+
+        struct lsd_radix_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> detail::enable_if_t<
+                    is_lsd_radix_sortable<projected_t<RandomAccessIterator, Projection>>::value &&
+                    is_projection_iterator_v<Projection, RandomAccessIterator, lsd_radix_key_less>
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                auto size = last - first;
+                if (size < 64) {
+                    insertion_sort(std::move(first), std::move(last),
+                                   lsd_radix_key_less{}, std::move(projection));
+                    return;
+                }
+
+                temporary_buffer<value_type_t<RandomAccessIterator>> buffer(size);
+                if (buffer.size() < size) {
+                    // Not enough memory for the radix sort, fall back
+                    // to a stable comparison sort on the keys
+                    merge_sort(std::move(first), std::move(last), size,
+                               lsd_radix_key_less{}, std::move(projection));
+                    return;
+                }
+                using key_traits = lsd_radix_key<projected_t<RandomAccessIterator, Projection>>;
+                key_traits::sort(std::move(first), std::move(last), buffer.data(),
+                                 make_lsd_radix_visitor(std::move(projection)));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::true_type;
+
+            // The keys are ordered by the radix sort, not by operator<
+            using key_compare = lsd_radix_key_less;
+        };
+    }
+
+    struct lsd_radix_sorter:
+        sorter_facade<detail::lsd_radix_sorter_impl>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& lsd_radix_sort
+            = utility::static_const<lsd_radix_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_NTH_ELEMENT_SORTER_H_
+#define CPPSORT_SORTERS_NTH_ELEMENT_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/config.h"
+#include "../detail/execution_policy.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/partial_sort.h"
+#include "../detail/type_traits.h"
+#include "../detail/work_stealing_pool.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct nth_element_sorter_impl
+        {
+            std::ptrdiff_t nth;
+
+            constexpr explicit nth_element_sorter_impl(std::ptrdiff_t nth):
+                nth(nth)
+            {}
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(std::begin(iterable))
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<decltype(std::begin(iterable))>
+                    >::value,
+                    "nth_element_sorter requires at least forward iterators"
+                );
+
+                using difference_type = difference_type_t<decltype(std::begin(iterable))>;
+                return select_nth(std::begin(iterable), std::end(iterable),
+                                  static_cast<difference_type>(nth),
+                                  utility::size(iterable),
+                                  std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> ForwardIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "nth_element_sorter requires at least forward iterators"
+                );
+
+                using difference_type = difference_type_t<ForwardIterator>;
+                auto dist = std::distance(first, last);
+                return select_nth(std::move(first), std::move(last),
+                                  static_cast<difference_type>(nth), dist,
+                                  std::move(compare), std::move(projection));
+            }
+
+#if CPPSORT_EXECUTION_POLICIES
+            template<
+                typename ExecutionPolicy,
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> ForwardIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "nth_element_sorter requires at least forward iterators"
+                );
+
+                using difference_type = difference_type_t<ForwardIterator>;
+                auto dist = std::distance(first, last);
+                return parallel_select_nth(std::move(first), std::move(last),
+                                           static_cast<difference_type>(nth), dist,
+                                           std::move(compare), std::move(projection),
+                                           policy_thread_count<ExecutionPolicy>());
+            }
+#endif
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::forward_iterator_tag;
+            using is_always_stable = std::false_type;
+
+#if CPPSORT_EXECUTION_POLICIES
+            template<typename ExecutionPolicy>
+            using supports_execution_policy = std::true_type;
+#endif
+        };
+    }
+
+    struct nth_element_sorter:
+        sorter_facade<detail::nth_element_sorter_impl>
+    {
+        constexpr explicit nth_element_sorter(std::ptrdiff_t nth):
+            sorter_facade<detail::nth_element_sorter_impl>(nth)
+        {}
+    };
+}
+
+#endif // CPPSORT_SORTERS_NTH_ELEMENT_SORTER_H_
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/config.h"
+#include "../detail/execution_policy.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/parallel_merge_sort.h"
+#include "../detail/type_traits.h"
+#include "../detail/work_stealing_pool.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct parallel_merge_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_merge_sorter requires at least random-access iterators"
+                );
+
+                parallel_merge_sort(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection));
+            }
+
+#if CPPSORT_EXECUTION_POLICIES
+            template<
+                typename ExecutionPolicy,
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    detail::is_execution_policy<ExecutionPolicy>::value &&
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(ExecutionPolicy&&, RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_merge_sorter requires at least random-access iterators"
+                );
+
+                // Policies that don't allow parallelism run the
+                // algorithm on the calling thread
+                parallel_merge_sort(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection),
+                                    policy_thread_count<ExecutionPolicy>());
+            }
+#endif
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::true_type;
+
+#if CPPSORT_EXECUTION_POLICIES
+            template<typename ExecutionPolicy>
+            using supports_execution_policy = std::true_type;
+#endif
+        };
+    }
+
+    struct parallel_merge_sorter:
+        sorter_facade<detail::parallel_merge_sorter_impl>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_merge_sort
+            = utility::static_const<parallel_merge_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
@@ -32,7 +32,7 @@ namespace cppsort
                 typename RandomAccessIterator,
                 typename Projection = utility::identity,
                 typename = detail::enable_if_t<
-                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                    is_projection_iterator_v<Projection, RandomAccessIterator, radix_key_less>
                 >
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
@@ -57,6 +57,9 @@ namespace cppsort
 
             using iterator_category = std::random_access_iterator_tag;
             using is_always_stable = std::false_type;
+
+            // The keys are ordered by the radix sort, not by operator<
+            using key_compare = radix_key_less;
         };
     }
 
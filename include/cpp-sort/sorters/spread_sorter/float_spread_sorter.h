@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021 Morwenn
+ * Copyright (c) 2015-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_SORTERS_SPREAD_SORTER_FLOAT_SPREAD_SORTER_H_
@@ -9,16 +9,22 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/comparators/total_less.h>
+#include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/static_const.h>
+#include "../../detail/floating_point_weight.h"
 #include "../../detail/iterator_traits.h"
+#include "../../detail/lsd_radix_sort.h"
 #include "../../detail/spreadsort/float_sort.h"
+#include "../../detail/spreadsort/integer_sort.h"
 #include "../../detail/type_traits.h"
 
 namespace cppsort
@@ -28,6 +34,26 @@ namespace cppsort
 
     namespace detail
     {
+        template<typename RandomAccessIterator, typename Projection>
+        using is_float_spread_sortable = std::integral_constant<bool,
+            std::numeric_limits<projected_t<RandomAccessIterator, Projection>>::is_iec559 && (
+                sizeof(projected_t<RandomAccessIterator, Projection>) == sizeof(std::uint32_t) ||
+                sizeof(projected_t<RandomAccessIterator, Projection>) == sizeof(std::uint64_t)
+            ) &&
+            is_projection_iterator_v<Projection, RandomAccessIterator>
+        >;
+
+        template<typename Projection>
+        auto make_total_order_key(Projection projection)
+        {
+            // Projection returning the unsigned integer such that sorting
+            // the keys sorts the floating point numbers per totalOrder
+            return [projection=std::move(projection)](const auto& value) {
+                auto&& proj = utility::as_function(projection);
+                return total_order_key(proj(value));
+            };
+        }
+
         struct float_spread_sorter_impl
         {
             template<
@@ -37,11 +63,7 @@ namespace cppsort
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             Projection projection={}) const
                 -> detail::enable_if_t<
-                    std::numeric_limits<projected_t<RandomAccessIterator, Projection>>::is_iec559 && (
-                        sizeof(projected_t<RandomAccessIterator, Projection>) == sizeof(std::uint32_t) ||
-                        sizeof(projected_t<RandomAccessIterator, Projection>) == sizeof(std::uint64_t)
-                    ) &&
-                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                    is_float_spread_sortable<RandomAccessIterator, Projection>::value
                 >
             {
                 static_assert(
@@ -52,9 +74,39 @@ namespace cppsort
                     "float_spread_sorter requires at least random-access iterators"
                 );
 
+                // The totalOrder keys of numbers that aren't NaN are
+                // ordered the same way as the numbers themselves
+                if (try_lsd_radix_sort(first, last, make_total_order_key(projection))) {
+                    return;
+                }
                 spreadsort::float_sort(std::move(first), std::move(last), std::move(projection));
             }
 
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            total_less_t, Projection projection={}) const
+                -> detail::enable_if_t<
+                    is_float_spread_sortable<RandomAccessIterator, Projection>::value
+                >
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "float_spread_sorter requires at least random-access iterators"
+                );
+
+                auto key = make_total_order_key(std::move(projection));
+                if (try_lsd_radix_sort(first, last, key)) {
+                    return;
+                }
+                spreadsort::integer_sort(std::move(first), std::move(last), std::move(key));
+            }
+
             ////////////////////////////////////////////////////////////
             // Sorter traits
 
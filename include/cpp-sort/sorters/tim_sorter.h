@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021 Morwenn
+ * Copyright (c) 2015-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_SORTERS_TIM_SORTER_H_
@@ -8,6 +8,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <type_traits>
@@ -22,11 +23,70 @@
 
 namespace cppsort
 {
+    ////////////////////////////////////////////////////////////
+    // Configuration
+
+    enum class tim_sorter_policy
+    {
+        classic,          // timsort stack invariants
+        adaptive_shivers, // adaptive ShiversSort merge policy
+        powersort         // powersort merge policy
+    };
+
+    // The defaults are those of tim_sorter
+    struct tim_sorter_config
+    {
+        // Runs shorter than minrun are extended with an insertion
+        // sort, minrun is chosen in [min_run, max_run] so that the
+        // number of runs is close to a power of 2
+        std::ptrdiff_t min_run = 32;
+        std::ptrdiff_t max_run = 64;
+        // Initial number of consecutive wins of a run needed to
+        // enter the galloping mode, adapted during the sort
+        std::ptrdiff_t min_gallop = 7;
+        // Policy deciding which runs to merge
+        tim_sorter_policy policy = tim_sorter_policy::classic;
+        // When not null, the counters of every sort are added to
+        // the pointed object
+        tim_sorter_stats* stats = nullptr;
+    };
+
     ////////////////////////////////////////////////////////////
     // Sorter
 
     namespace detail
     {
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto tim_sort_with_policy(std::integral_constant<tim_sorter_policy, tim_sorter_policy::classic>,
+                                  RandomAccessIterator first, RandomAccessIterator last,
+                                  Compare compare, Projection projection)
+            -> void
+        {
+            timsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto tim_sort_with_policy(std::integral_constant<tim_sorter_policy, tim_sorter_policy::adaptive_shivers>,
+                                  RandomAccessIterator first, RandomAccessIterator last,
+                                  Compare compare, Projection projection)
+            -> void
+        {
+            adaptive_shivers_sort(std::move(first), std::move(last),
+                                  std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto tim_sort_with_policy(std::integral_constant<tim_sorter_policy, tim_sorter_policy::powersort>,
+                                  RandomAccessIterator first, RandomAccessIterator last,
+                                  Compare compare, Projection projection)
+            -> void
+        {
+            powersort(std::move(first), std::move(last),
+                      std::move(compare), std::move(projection));
+        }
+
+        template<tim_sorter_policy Policy>
         struct tim_sorter_impl
         {
             template<
@@ -49,8 +109,82 @@ namespace cppsort
                     "tim_sorter requires at least random-access iterators"
                 );
 
-                timsort(std::move(first), std::move(last),
-                        std::move(compare), std::move(projection));
+                tim_sort_with_policy(std::integral_constant<tim_sorter_policy, Policy>{},
+                                     std::move(first), std::move(last),
+                                     std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::true_type;
+        };
+
+        // Clamps the tuning parameters to values the algorithm can
+        // work with: minrun and the galloping threshold must be
+        // positive, and max_run can't be smaller than min_run
+        constexpr auto clamp_tim_sorter_config(tim_sorter_config config)
+            -> tim_sorter_config
+        {
+            config.min_run = config.min_run < 1 ? 1 : config.min_run;
+            config.max_run = config.max_run < config.min_run ? config.min_run : config.max_run;
+            config.min_gallop = config.min_gallop < 1 ? 1 : config.min_gallop;
+            return config;
+        }
+
+        struct configurable_tim_sorter_impl
+        {
+            tim_sorter_config config;
+
+            configurable_tim_sorter_impl() = default;
+
+            constexpr explicit configurable_tim_sorter_impl(tim_sorter_config config):
+                config(clamp_tim_sorter_config(config))
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "configurable_tim_sorter requires at least random-access iterators"
+                );
+
+                timsort_tuning tuning;
+                tuning.min_run = config.min_run;
+                tuning.max_run = config.max_run;
+                tuning.min_gallop = config.min_gallop;
+
+                switch (config.policy) {
+                    case tim_sorter_policy::classic:
+                        timsort(std::move(first), std::move(last),
+                                std::move(compare), std::move(projection),
+                                tuning, config.stats);
+                        break;
+                    case tim_sorter_policy::adaptive_shivers:
+                        adaptive_shivers_sort(std::move(first), std::move(last),
+                                              std::move(compare), std::move(projection),
+                                              tuning, config.stats);
+                        break;
+                    case tim_sorter_policy::powersort:
+                        powersort(std::move(first), std::move(last),
+                                  std::move(compare), std::move(projection),
+                                  tuning, config.stats);
+                        break;
+                }
             }
 
             ////////////////////////////////////////////////////////////
@@ -62,9 +196,26 @@ namespace cppsort
     }
 
     struct tim_sorter:
-        sorter_facade<detail::tim_sorter_impl>
+        sorter_facade<detail::tim_sorter_impl<tim_sorter_policy::classic>>
     {};
 
+    template<tim_sorter_policy Policy>
+    struct basic_tim_sorter:
+        sorter_facade<detail::tim_sorter_impl<Policy>>
+    {};
+
+    using powersort_sorter = basic_tim_sorter<tim_sorter_policy::powersort>;
+
+    struct configurable_tim_sorter:
+        sorter_facade<detail::configurable_tim_sorter_impl>
+    {
+        configurable_tim_sorter() = default;
+
+        constexpr explicit configurable_tim_sorter(tim_sorter_config config):
+            sorter_facade<detail::configurable_tim_sorter_impl>(config)
+        {}
+    };
+
     ////////////////////////////////////////////////////////////
     // Sort function
 
@@ -72,6 +223,9 @@ namespace cppsort
     {
         constexpr auto&& tim_sort
             = utility::static_const<tim_sorter>::value;
+
+        constexpr auto&& powersort_sort
+            = utility::static_const<powersort_sorter>::value;
     }
 }
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_TOP_K_SORTER_H_
+#define CPPSORT_SORTERS_TOP_K_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/partial_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct top_k_sorter_impl
+        {
+            std::ptrdiff_t k;
+
+            constexpr explicit top_k_sorter_impl(std::ptrdiff_t k):
+                k(k)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> RandomAccessIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "top_k_sorter requires at least random-access iterators"
+                );
+
+                using difference_type = difference_type_t<RandomAccessIterator>;
+                return top_k(std::move(first), std::move(last),
+                             static_cast<difference_type>(k),
+                             std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Streaming interface: reads the elements once and writes
+            // the k smallest ones in sorted order to out, the input
+            // collection is left untouched
+
+            template<
+                typename InputIterator,
+                typename OutputIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, InputIterator, Compare>
+                >
+            >
+            auto copy(InputIterator first, InputIterator last, OutputIterator out,
+                      Compare compare={}, Projection projection={}) const
+                -> OutputIterator
+            {
+                return top_k_copy(std::move(first), std::move(last), k, std::move(out),
+                                  std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename InputIterable,
+                typename OutputIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_v<Projection, InputIterable, Compare>
+                >
+            >
+            auto copy(InputIterable&& iterable, OutputIterator out,
+                      Compare compare={}, Projection projection={}) const
+                -> OutputIterator
+            {
+                return copy(std::begin(iterable), std::end(iterable), std::move(out),
+                            std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct top_k_sorter:
+        sorter_facade<detail::top_k_sorter_impl>
+    {
+        constexpr explicit top_k_sorter(std::ptrdiff_t k):
+            sorter_facade<detail::top_k_sorter_impl>(k)
+        {}
+    };
+}
+
+#endif // CPPSORT_SORTERS_TOP_K_SORTER_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Morwenn
+ * Copyright (c) 2022-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_UTILITY_APPLY_PERMUTATION_H_
@@ -8,11 +8,13 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <iterator>
 #include <utility>
 #include <cpp-sort/utility/iter_move.h>
 #include "../detail/config.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/position_bitset.h"
 
 namespace cppsort
 {
@@ -52,6 +54,46 @@ namespace utility
         apply_permutation(std::begin(iterable), std::end(iterable),
                           std::begin(indices), std::end(indices));
     }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    auto apply_const_permutation(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                 RandomAccessIterator2 indices_first, RandomAccessIterator2 indices_last)
+        -> void
+    {
+        using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator1>;
+        using utility::iter_move;
+        CPPSORT_ASSERT( (last - first) == (indices_last - indices_first) );
+        (void)last;
+
+        // Same algorithm as apply_permutation, except that the visited
+        // positions are recorded in a bitset instead of the indices
+        auto size = static_cast<std::size_t>(indices_last - indices_first);
+        cppsort::detail::position_bitset visited(size);
+        for (auto start = visited.next_unset(0); start < size; start = visited.next_unset(start + 1)) {
+            visited.set(start);
+            auto start_idx = static_cast<difference_type>(start);
+            auto next_idx = static_cast<difference_type>(indices_first[start_idx]);
+            if (next_idx == start_idx) continue;
+
+            auto current_idx = start_idx;
+            auto tmp = iter_move(first + current_idx);
+            do {
+                first[current_idx] = iter_move(first + next_idx);
+                visited.set(static_cast<std::size_t>(next_idx));
+                current_idx = next_idx;
+                next_idx = static_cast<difference_type>(indices_first[current_idx]);
+            } while (next_idx != start_idx);
+            first[current_idx] = std::move(tmp);
+        }
+    }
+
+    template<typename RandomAccessIterable1, typename RandomAccessIterable2>
+    auto apply_const_permutation(RandomAccessIterable1&& iterable, const RandomAccessIterable2& indices)
+        -> void
+    {
+        apply_const_permutation(std::begin(iterable), std::end(iterable),
+                                std::begin(indices), std::end(indices));
+    }
 }}
 
 #endif // CPPSORT_UTILITY_APPLY_PERMUTATION_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021 Morwenn
+ * Copyright (c) 2015-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_UTILITY_BUFFER_H_
@@ -8,9 +8,12 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <new>
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -179,13 +182,13 @@ namespace utility
             private:
 
                 std::size_t _size;
-                std::unique_ptr<T[]> _memory;
+                std::unique_ptr<T, cppsort::detail::scratch_array_deleter<T>> _memory;
 
             public:
 
                 explicit dynamic_buffer_impl(std::size_t size):
                     _size(size),
-                    _memory(std::make_unique<T[]>(_size))
+                    _memory(cppsort::detail::make_scratch_array<T>(_size))
                 {}
 
                 auto size() const
@@ -195,15 +198,15 @@ namespace utility
                 }
 
                 auto operator[](std::size_t pos)
-                    -> decltype(_memory[pos])
+                    -> decltype(_memory.get()[pos])
                 {
-                    return _memory[pos];
+                    return _memory.get()[pos];
                 }
 
                 auto operator[](std::size_t pos) const
-                    -> decltype(_memory[pos])
+                    -> decltype(_memory.get()[pos])
                 {
-                    return _memory[pos];
+                    return _memory.get()[pos];
                 }
 
                 auto begin()
@@ -258,6 +261,213 @@ namespace utility
             {}
         };
     };
+
+    ////////////////////////////////////////////////////////////
+    // Dynamic buffer reusing its memory between calls
+
+    namespace detail
+    {
+        // Memory block kept by every thread for cached_buffer: it
+        // grows geometrically when a bigger buffer is requested and
+        // only shrinks when explicitly released
+
+        class cached_buffer_storage
+        {
+            public:
+
+                cached_buffer_storage() = default;
+                cached_buffer_storage(const cached_buffer_storage&) = delete;
+                cached_buffer_storage& operator=(const cached_buffer_storage&) = delete;
+
+                ~cached_buffer_storage()
+                {
+                    ::operator delete(memory);
+                }
+
+                auto acquire(std::size_t bytes)
+                    -> void*
+                {
+                    if (capacity < bytes) {
+                        // The old contents don't matter, release them first
+                        // to avoid holding both blocks at once
+                        std::size_t new_capacity = (std::max)(bytes, capacity * 2);
+                        ::operator delete(memory);
+                        memory = nullptr;
+                        capacity = 0;
+                        memory = ::operator new(new_capacity);
+                        capacity = new_capacity;
+                    }
+                    in_use = true;
+                    return memory;
+                }
+
+                auto release() noexcept
+                    -> void
+                {
+                    if (not in_use) {
+                        ::operator delete(memory);
+                        memory = nullptr;
+                        capacity = 0;
+                    }
+                }
+
+                void* memory = nullptr;
+                std::size_t capacity = 0;
+                bool in_use = false;
+        };
+
+        inline auto thread_cached_buffer_storage()
+            -> cached_buffer_storage&
+        {
+            static thread_local cached_buffer_storage storage;
+            return storage;
+        }
+
+        template<typename T>
+        class cached_buffer_impl
+        {
+            static_assert(
+                alignof(T) <= alignof(std::max_align_t),
+                "cached_buffer does not support over-aligned types"
+            );
+
+            private:
+
+                std::size_t _size;
+                T* _memory;
+                // Whether the memory comes from the thread cache, which
+                // might not be the case when a sort happens while the
+                // cache is already lent to another buffer
+                bool _cached;
+
+                auto release_memory() noexcept
+                    -> void
+                {
+                    if (_cached) {
+                        thread_cached_buffer_storage().in_use = false;
+                    } else {
+                        ::operator delete(_memory);
+                    }
+                }
+
+            public:
+
+                explicit cached_buffer_impl(std::size_t size):
+                    _size(size)
+                {
+                    auto& storage = thread_cached_buffer_storage();
+                    _cached = not storage.in_use;
+                    _memory = static_cast<T*>(
+                        _cached ? storage.acquire(size * sizeof(T))
+                                : ::operator new(size * sizeof(T))
+                    );
+
+                    std::size_t constructed = 0;
+                    try {
+                        for (; constructed < _size; ++constructed) {
+                            ::new(_memory + constructed) T();
+                        }
+                    } catch (...) {
+                        cppsort::detail::destroy_n(_memory, constructed);
+                        release_memory();
+                        throw;
+                    }
+                }
+
+                cached_buffer_impl(const cached_buffer_impl&) = delete;
+                cached_buffer_impl& operator=(const cached_buffer_impl&) = delete;
+
+                ~cached_buffer_impl()
+                {
+                    cppsort::detail::destroy_n(_memory, _size);
+                    release_memory();
+                }
+
+                auto size() const
+                    -> std::size_t
+                {
+                    return _size;
+                }
+
+                auto operator[](std::size_t pos)
+                    -> T&
+                {
+                    return _memory[pos];
+                }
+
+                auto operator[](std::size_t pos) const
+                    -> const T&
+                {
+                    return _memory[pos];
+                }
+
+                auto begin()
+                    -> T*
+                {
+                    return _memory;
+                }
+
+                auto begin() const
+                    -> const T*
+                {
+                    return _memory;
+                }
+
+                auto cbegin() const
+                    -> const T*
+                {
+                    return _memory;
+                }
+
+                auto end()
+                    -> T*
+                {
+                    return _memory + _size;
+                }
+
+                auto end() const
+                    -> const T*
+                {
+                    return _memory + _size;
+                }
+
+                auto cend() const
+                    -> const T*
+                {
+                    return _memory + _size;
+                }
+        };
+    }
+
+    template<typename SizePolicy>
+    struct cached_buffer
+    {
+        template<typename T>
+        struct buffer:
+            detail::cached_buffer_impl<T>
+        {
+            explicit buffer(std::size_t size):
+                detail::cached_buffer_impl<T>(
+                    static_cast<std::size_t>(SizePolicy{}(size))
+                )
+            {}
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Cache management, affects the calling thread only
+
+        static auto capacity()
+            -> std::size_t
+        {
+            return detail::thread_cached_buffer_storage().capacity;
+        }
+
+        static auto release()
+            -> void
+        {
+            detail::thread_cached_buffer_storage().release();
+        }
+    };
 }}
 
 #endif // CPPSORT_UTILITY_BUFFER_H_
@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_EXTERNAL_SORTER_H_
+#define CPPSORT_UTILITY_EXTERNAL_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/loser_tree.h"
+#include "../detail/memory.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Unbuffered temporary file, deleted when closed
+
+    class temporary_file
+    {
+        public:
+
+            temporary_file():
+                file_(std::tmpfile())
+            {
+                if (file_ == nullptr) {
+                    throw std::system_error(errno, std::generic_category(),
+                                            "external_sorter: could not create a temporary file");
+                }
+                // Reads and writes are always done by big blocks, the
+                // stdio buffer would only add a useless copy
+                std::setvbuf(file_, nullptr, _IONBF, 0);
+            }
+
+            temporary_file(const temporary_file&) = delete;
+            temporary_file& operator=(const temporary_file&) = delete;
+
+            ~temporary_file()
+            {
+                std::fclose(file_);
+            }
+
+            auto write(const void* data, std::size_t bytes)
+                -> void
+            {
+                if (std::fwrite(data, 1, bytes, file_) != bytes) {
+                    throw std::system_error(errno, std::generic_category(),
+                                            "external_sorter: could not write to a temporary file");
+                }
+            }
+
+            auto read(void* data, std::size_t bytes)
+                -> std::size_t
+            {
+                auto res = std::fread(data, 1, bytes, file_);
+                if (res != bytes && std::ferror(file_)) {
+                    throw std::system_error(errno, std::generic_category(),
+                                            "external_sorter: could not read from a temporary file");
+                }
+                return res;
+            }
+
+            auto rewind() noexcept
+                -> void
+            {
+                std::rewind(file_);
+            }
+
+        private:
+
+            std::FILE* file_;
+    };
+
+    // Sorted run spilled to disk
+    struct external_run
+    {
+        std::unique_ptr<temporary_file> file;
+        std::size_t size;
+    };
+
+    template<typename T>
+    using external_block = std::unique_ptr<T, operator_deleter>;
+
+    template<typename T>
+    auto make_external_block(std::size_t size)
+        -> external_block<T>
+    {
+        return external_block<T>(
+            static_cast<T*>(allocate_scratch(size * sizeof(T))),
+            operator_deleter(size * sizeof(T))
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Thread reading blocks from temporary files in the order
+    // the reads were requested, shared by every run of a sort
+
+    struct external_read_request
+    {
+        temporary_file* file;
+        void* buffer;
+        std::size_t bytes;
+        // Set by the reader thread
+        std::size_t result = 0;
+        std::exception_ptr error = nullptr;
+        bool done = false;
+    };
+
+    class external_reader_thread
+    {
+        public:
+
+            external_reader_thread():
+                thread_([this] { run(); })
+            {}
+
+            external_reader_thread(const external_reader_thread&) = delete;
+            external_reader_thread& operator=(const external_reader_thread&) = delete;
+
+            ~external_reader_thread()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                requested_.notify_one();
+                thread_.join();
+            }
+
+            // The request must stay alive until wait returns
+            auto submit(external_read_request& request)
+                -> void
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    queue_.push_back(&request);
+                }
+                requested_.notify_one();
+            }
+
+            // Number of bytes read, rethrows the read errors
+            auto wait(external_read_request& request)
+                -> std::size_t
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                completed_.wait(lock, [&] { return request.done; });
+                if (request.error) {
+                    std::rethrow_exception(request.error);
+                }
+                return request.result;
+            }
+
+        private:
+
+            auto run()
+                -> void
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (true) {
+                    requested_.wait(lock, [this] { return stopping_ || not queue_.empty(); });
+                    if (queue_.empty()) {
+                        return;
+                    }
+                    auto request = queue_.front();
+                    queue_.pop_front();
+
+                    lock.unlock();
+                    std::size_t result = 0;
+                    std::exception_ptr error = nullptr;
+                    try {
+                        result = request->file->read(request->buffer, request->bytes);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    lock.lock();
+
+                    request->result = result;
+                    request->error = error;
+                    request->done = true;
+                    completed_.notify_all();
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable requested_;
+            std::condition_variable completed_;
+            std::deque<external_read_request*> queue_;
+            bool stopping_ = false;
+            std::thread thread_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Double-buffered reader of a run: the next block of the run
+    // is read by the reader thread while the current one is
+    // consumed
+
+    template<typename T>
+    class external_run_reader
+    {
+        public:
+
+            external_run_reader(external_run& run, std::size_t block_size,
+                                external_reader_thread& reader_thread):
+                reader_thread_(&reader_thread),
+                file_(run.file.get()),
+                remaining_(run.size),
+                block_size_(block_size),
+                front_(make_external_block<T>(block_size)),
+                back_(make_external_block<T>(block_size))
+            {
+                file_->rewind();
+                prefetch();
+                refill();
+            }
+
+            external_run_reader(const external_run_reader&) = delete;
+            external_run_reader& operator=(const external_run_reader&) = delete;
+
+            ~external_run_reader()
+            {
+                // The block being read must outlive the read
+                if (has_pending_) {
+                    try {
+                        reader_thread_->wait(pending_);
+                    } catch (...) {}
+                }
+            }
+
+            // Current element, or nullptr if the run is exhausted
+            auto head() const noexcept
+                -> const T*
+            {
+                return current_ == end_ ? nullptr : current_;
+            }
+
+            auto advance()
+                -> const T*
+            {
+                if (++current_ == end_) {
+                    refill();
+                }
+                return head();
+            }
+
+        private:
+
+            auto prefetch()
+                -> void
+            {
+                auto count = (std::min)(remaining_, block_size_);
+                remaining_ -= count;
+                if (count == 0) {
+                    return;
+                }
+                pending_ = external_read_request{ file_, back_.get(), count * sizeof(T) };
+                has_pending_ = true;
+                reader_thread_->submit(pending_);
+            }
+
+            auto refill()
+                -> void
+            {
+                if (not has_pending_) {
+                    current_ = end_ = front_.get();
+                    return;
+                }
+                has_pending_ = false;
+                auto count = reader_thread_->wait(pending_) / sizeof(T);
+                std::swap(front_, back_);
+                current_ = front_.get();
+                end_ = current_ + count;
+                prefetch();
+            }
+
+            external_reader_thread* reader_thread_;
+            temporary_file* file_;
+            // Number of elements not yet requested from the file
+            std::size_t remaining_;
+            std::size_t block_size_;
+            external_block<T> front_;
+            external_block<T> back_;
+            T* current_ = nullptr;
+            T* end_ = nullptr;
+            external_read_request pending_ = { nullptr, nullptr, 0 };
+            bool has_pending_ = false;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Merges runs with a loser tree, passing every element in
+    // order to the given sink
+
+    template<typename T, typename Compare, typename Projection, typename Sink>
+    auto merge_external_runs(external_run* first, external_run* last, std::size_t block_size,
+                             external_reader_thread& reader_thread,
+                             Compare compare, Projection projection, Sink&& sink)
+        -> void
+    {
+        auto nb_runs = static_cast<std::size_t>(last - first);
+        std::vector<std::unique_ptr<external_run_reader<T>>> readers;
+        readers.reserve(nb_runs);
+        loser_tree<const T*, Compare, Projection> tree(nb_runs, std::move(compare), std::move(projection));
+        for (std::size_t idx = 0; idx < nb_runs; ++idx) {
+            readers.emplace_back(new external_run_reader<T>(first[idx], block_size, reader_thread));
+            if (auto head = readers.back()->head()) {
+                tree.set_head(idx, head);
+            }
+        }
+        tree.build();
+
+        while (not tree.empty()) {
+            sink(tree.top());
+            if (auto head = readers[tree.winner()]->advance()) {
+                tree.replace_top(head);
+            } else {
+                tree.pop_top();
+            }
+        }
+    }
+
+    template<typename T>
+    auto write_external_run(const T* data, std::size_t size)
+        -> external_run
+    {
+        external_run run{ std::unique_ptr<temporary_file>(new temporary_file), size };
+        run.file->write(data, size * sizeof(T));
+        return run;
+    }
+
+    // Smallest block read at once from a run during the merge
+    constexpr std::size_t external_min_block_bytes = 1 << 20;
+}
+
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Sorts an input range of fixed-size records that does not fit
+    // in memory: sorted runs are formed with the adapted sorter and
+    // spilled to temporary files, then merged into the output
+
+    template<typename Sorter=pdq_sorter>
+    struct external_sorter:
+        utility::adapter_storage<Sorter>
+    {
+        private:
+
+            std::size_t memory_budget_ = std::size_t(1) << 28;
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            external_sorter() = default;
+
+            explicit external_sorter(std::size_t memory_budget):
+                memory_budget_(memory_budget)
+            {}
+
+            explicit external_sorter(Sorter sorter, std::size_t memory_budget=std::size_t(1) << 28):
+                utility::adapter_storage<Sorter>(std::move(sorter)),
+                memory_budget_(memory_budget)
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            // Approximate amount of memory in bytes used for the
+            // elements being sorted or merged
+            auto memory_budget() const noexcept
+                -> std::size_t
+            {
+                return memory_budget_;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorting
+
+            template<
+                typename InputIterator,
+                typename OutputIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity
+            >
+            auto operator()(InputIterator first, InputIterator last, OutputIterator out,
+                            Compare compare={}, Projection projection={}) const
+                -> OutputIterator
+            {
+                using value_type = cppsort::detail::value_type_t<InputIterator>;
+                static_assert(
+                    std::is_trivially_copyable<value_type>::value,
+                    "external_sorter only handles trivially copyable records"
+                );
+                using namespace cppsort::detail;
+
+                ////////////////////////////////////////////////////////////
+                // Form sorted runs the size of the memory budget
+
+                auto run_size = (std::max)(memory_budget_ / sizeof(value_type), std::size_t(1));
+                std::vector<external_run> runs;
+                {
+                    auto buffer = make_external_block<value_type>(run_size);
+                    auto buffer_first = buffer.get();
+                    while (first != last) {
+                        auto buffer_last = buffer_first;
+                        for (; first != last && std::size_t(buffer_last - buffer_first) < run_size; ++first) {
+                            ::new(buffer_last) value_type(*first);
+                            ++buffer_last;
+                        }
+                        this->get()(buffer_first, buffer_last, compare, projection);
+
+                        if (runs.empty() && first == last) {
+                            // Everything fit in memory, no need for a temporary file
+                            return std::copy(buffer_first, buffer_last, std::move(out));
+                        }
+                        runs.push_back(write_external_run(buffer_first,
+                                                          std::size_t(buffer_last - buffer_first)));
+                    }
+                }
+                if (runs.empty()) {
+                    return out;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Merge the runs, in several passes if there are more
+                // runs than blocks of reasonable size in the budget
+
+                external_reader_thread reader_thread;
+                auto max_blocks = memory_budget_ / (sizeof(value_type) * 2);
+                auto min_block_size = (std::max)(external_min_block_bytes / sizeof(value_type), std::size_t(1));
+                auto max_fan_in = (std::max)(max_blocks / min_block_size, std::size_t(2));
+
+                while (runs.size() > max_fan_in) {
+                    // Merge groups of runs into bigger ones; an output
+                    // block is kept out of the budget of the readers
+                    std::vector<external_run> merged_runs;
+                    auto block_size = (std::max)(max_blocks / (max_fan_in + 1), std::size_t(1));
+                    for (std::size_t idx = 0; idx < runs.size(); idx += max_fan_in) {
+                        auto group_end = (std::min)(idx + max_fan_in, runs.size());
+                        if (group_end - idx == 1) {
+                            merged_runs.push_back(std::move(runs[idx]));
+                            continue;
+                        }
+
+                        external_run merged{ std::unique_ptr<temporary_file>(new temporary_file), 0 };
+                        auto output = make_external_block<value_type>(block_size);
+                        std::size_t output_size = 0;
+                        merge_external_runs<value_type>(
+                            runs.data() + idx, runs.data() + group_end, block_size,
+                            reader_thread, compare, projection,
+                            [&](const value_type& value) {
+                                ::new(output.get() + output_size) value_type(value);
+                                if (++output_size == block_size) {
+                                    merged.file->write(output.get(), output_size * sizeof(value_type));
+                                    merged.size += output_size;
+                                    output_size = 0;
+                                }
+                            }
+                        );
+                        merged.file->write(output.get(), output_size * sizeof(value_type));
+                        merged.size += output_size;
+                        merged_runs.push_back(std::move(merged));
+                        // Free the disk space as soon as possible
+                        for (auto it = idx; it != group_end; ++it) {
+                            runs[it].file.reset();
+                        }
+                    }
+                    runs = std::move(merged_runs);
+                }
+
+                auto block_size = (std::max)(max_blocks / runs.size(), std::size_t(1));
+                merge_external_runs<value_type>(
+                    runs.data(), runs.data() + runs.size(), block_size,
+                    reader_thread, std::move(compare), std::move(projection),
+                    [&](const value_type& value) {
+                        *out = value;
+                        ++out;
+                    }
+                );
+                return out;
+            }
+
+            template<
+                typename InputIterable,
+                typename OutputIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = decltype(std::begin(std::declval<InputIterable&>()))
+            >
+            auto operator()(InputIterable&& iterable, OutputIterator out,
+                            Compare compare={}, Projection projection={}) const
+                -> OutputIterator
+            {
+                return operator()(std::begin(iterable), std::end(iterable), std::move(out),
+                                  std::move(compare), std::move(projection));
+            }
+    };
+}}
+
+#endif // CPPSORT_UTILITY_EXTERNAL_SORTER_H_
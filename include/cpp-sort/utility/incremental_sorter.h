@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_INCREMENTAL_SORTER_H_
+#define CPPSORT_UTILITY_INCREMENTAL_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "../detail/adaptive_quickselect.h"
+#include "../detail/bitops.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/iter_sort3.h"
+#include "../detail/pdqsort.h"
+#include "../detail/simd.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Incremental quicksort: the collection is sorted from left
+    // to right on demand, only partitioning the leftmost segment
+    // that isn't sorted yet until it is small enough to be sorted
+    // or entirely needed. The positions of the pivots right of
+    // the sorted prefix are kept on a stack, so the partitions
+    // done during a call are reused by the following ones, and
+    // the total work never exceeds that of a full quicksort.
+
+    template<
+        typename RandomAccessIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    class incremental_sorter
+    {
+        public:
+
+            using iterator = RandomAccessIterator;
+            using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            incremental_sorter(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare={}, Projection projection={}):
+                first_(std::move(first)),
+                size_(last - first_),
+                bad_allowed_(size_ < 2 ? 0 : cppsort::detail::log2(size_)),
+                compare_(std::move(compare)),
+                projection_(std::move(projection))
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            auto begin() const
+                -> RandomAccessIterator
+            {
+                return first_;
+            }
+
+            auto end() const
+                -> RandomAccessIterator
+            {
+                return first_ + size_;
+            }
+
+            // End of the sorted prefix
+            auto sorted_end() const
+                -> RandomAccessIterator
+            {
+                return first_ + sorted_;
+            }
+
+            // Whether the whole collection is sorted
+            auto done() const noexcept
+                -> bool
+            {
+                return sorted_ == size_;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorting
+
+            // Extends the sorted prefix by at least n elements, or
+            // to the whole collection if there are fewer elements
+            // left, and returns the new end of the sorted prefix
+            auto next(difference_type n)
+                -> RandomAccessIterator
+            {
+                if (n <= 0) {
+                    return sorted_end();
+                }
+                difference_type target = n >= size_ - sorted_ ? size_ : sorted_ + n;
+
+                while (sorted_ < target) {
+                    difference_type bound = pivots_.empty() ? size_ : pivots_.back().position;
+                    if (bound <= target ||
+                        bound - sorted_ < cppsort::detail::pdqsort_detail::insertion_sort_threshold) {
+                        // The whole segment is needed or small enough,
+                        // sort it and move past its bounding pivot
+                        cppsort::detail::pdqsort(first_ + sorted_, first_ + bound,
+                                                 compare_, projection_);
+                        sorted_ = bound;
+                        if (not pivots_.empty()) {
+                            // The next segment is the right part of the
+                            // partition that put that pivot in place, and
+                            // inherits the budget stored with the pivot
+                            bad_allowed_ = pivots_.back().bad_allowed;
+                            pivots_.pop_back();
+                            ++sorted_;
+                        }
+                    } else {
+                        partition_segment(first_ + sorted_, first_ + bound);
+                    }
+                }
+                return sorted_end();
+            }
+
+        private:
+
+            // Partitions [begin, end) and pushes the position of
+            // its pivot on the stack; also extends the sorted prefix
+            // when the segment starts with elements equal to the
+            // last sorted one
+            auto partition_segment(RandomAccessIterator begin, RandomAccessIterator end)
+                -> void
+            {
+                using namespace cppsort::detail::pdqsort_detail;
+                using cppsort::detail::iter_sort3;
+                using utility::iter_swap;
+                using value_type = cppsort::detail::value_type_t<RandomAccessIterator>;
+                using projected_type = cppsort::detail::projected_t<RandomAccessIterator, Projection>;
+
+                constexpr bool is_branchless =
+                    utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+                    utility::is_probably_branchless_projection_v<Projection, value_type>;
+                (void)is_branchless; // Silence a -Wunused-but-set-variable false positive
+
+                auto&& comp = utility::as_function(compare_);
+                auto&& proj = utility::as_function(projection_);
+                difference_type size = end - begin;
+
+                if (bad_allowed_ <= 0) {
+                    // Too many unbalanced partitions, use the median
+                    // as a pivot, found in linear time. Unlike pdqsort
+                    // we can't switch to heapsort, so both halves are
+                    // given a small constant budget again: it is enough
+                    // to keep the O(n log n) worst case while avoiding
+                    // a linear-time selection for every subsequent
+                    // partition when the patterns are only local
+                    auto middle = begin + size / 2;
+                    cppsort::detail::median_of_ninthers_select(begin, middle, end,
+                                                               compare_, projection_);
+                    bad_allowed_ = 2;
+                    pivots_.push_back({ middle - first_, bad_allowed_ });
+                    return;
+                }
+
+                // Choose pivot as median of 3 or pseudomedian of 9
+                difference_type s2 = size / 2;
+                if (size > ninther_threshold) {
+                    iter_sort3(begin, begin + s2, end - 1, compare_, projection_);
+                    iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare_, projection_);
+                    iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare_, projection_);
+                    iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare_, projection_);
+                    iter_swap(begin, begin + s2);
+                } else {
+                    iter_sort3(begin + s2, begin, end - 1, compare_, projection_);
+                }
+
+                // The last sorted element is not greater than any of
+                // the elements left, if the pivot is equal to it then
+                // the elements equal to the pivot are already sorted
+                if (sorted_ > 0 && not comp(proj(*(begin - 1)), proj(*begin))) {
+                    auto pivot_pos = partition_left(begin, end, compare_, projection_);
+                    sorted_ = (pivot_pos - first_) + 1;
+                    return;
+                }
+
+                std::pair<RandomAccessIterator, bool> part_result = is_branchless ?
+                    partition_right_vectorized(begin, end, compare_, projection_,
+                                               cppsort::detail::is_simd_compatible<
+                                                   RandomAccessIterator, Compare, Projection
+                                               >{}) :
+                    partition_right(begin, end, compare_, projection_);
+                auto pivot_pos = part_result.first;
+
+                difference_type l_size = pivot_pos - begin;
+                difference_type r_size = end - (pivot_pos + 1);
+                if (l_size < size / 8 || r_size < size / 8) {
+                    --bad_allowed_;
+
+                    // Shuffle elements to break patterns, see pdqsort_loop
+                    if (l_size >= insertion_sort_threshold) {
+                        iter_swap(begin,             begin + l_size / 4);
+                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    }
+                    if (r_size >= insertion_sort_threshold) {
+                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        iter_swap(end - 1,                   end - r_size / 4);
+                    }
+                }
+
+                // Both parts of the partition get the same budget of
+                // unbalanced partitions, the left one being processed
+                // first, see pdqsort_loop
+                pivots_.push_back({ pivot_pos - first_, bad_allowed_ });
+            }
+
+            struct pivot_info
+            {
+                difference_type position;
+                // Number of unbalanced partitions allowed in the
+                // segment right of the pivot
+                int bad_allowed;
+            };
+
+            RandomAccessIterator first_;
+            difference_type size_;
+            // Size of the sorted prefix
+            difference_type sorted_ = 0;
+            // Pivots right of the sorted prefix, the leftmost one
+            // being on top of the stack
+            std::vector<pivot_info> pivots_;
+            // Number of unbalanced partitions allowed in the segment
+            // starting at the end of the sorted prefix
+            int bad_allowed_;
+            Compare compare_;
+            Projection projection_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Construction functions
+
+    template<
+        typename RandomAccessIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = cppsort::detail::enable_if_t<
+            is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+        >
+    >
+    auto make_incremental_sorter(RandomAccessIterator first, RandomAccessIterator last,
+                                 Compare compare={}, Projection projection={})
+        -> incremental_sorter<RandomAccessIterator, Compare, Projection>
+    {
+        static_assert(
+            std::is_base_of<
+                std::random_access_iterator_tag,
+                cppsort::detail::iterator_category_t<RandomAccessIterator>
+            >::value,
+            "make_incremental_sorter requires at least random-access iterators"
+        );
+
+        return { std::move(first), std::move(last),
+                 std::move(compare), std::move(projection) };
+    }
+
+    template<
+        typename RandomAccessIterable,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity,
+        typename = cppsort::detail::enable_if_t<
+            is_projection_v<Projection, RandomAccessIterable, Compare>
+        >
+    >
+    auto make_incremental_sorter(RandomAccessIterable& iterable,
+                                 Compare compare={}, Projection projection={})
+        -> incremental_sorter<decltype(std::begin(iterable)), Compare, Projection>
+    {
+        return make_incremental_sorter(std::begin(iterable), std::end(iterable),
+                                       std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_UTILITY_INCREMENTAL_SORTER_H_
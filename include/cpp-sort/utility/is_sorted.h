@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_IS_SORTED_H_
+#define CPPSORT_UTILITY_IS_SORTED_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/is_sorted_until.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    namespace detail
+    {
+        struct is_sorted_until_impl
+        {
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            constexpr auto operator()(ForwardIterator first, ForwardIterator last,
+                                      Compare compare={}, Projection projection={}) const
+                -> ForwardIterator
+            {
+                return cppsort::detail::is_sorted_until(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection)
+                );
+            }
+        };
+
+        struct is_sorted_impl
+        {
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            constexpr auto operator()(ForwardIterator first, ForwardIterator last,
+                                      Compare compare={}, Projection projection={}) const
+                -> bool
+            {
+                return cppsort::detail::is_sorted(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection)
+                );
+            }
+        };
+    }
+
+    namespace
+    {
+        constexpr auto&& is_sorted_until = utility::static_const<
+            sorter_facade<detail::is_sorted_until_impl>
+        >::value;
+
+        constexpr auto&& is_sorted = utility::static_const<
+            sorter_facade<detail::is_sorted_impl>
+        >::value;
+    }
+}}
+
+#endif // CPPSORT_UTILITY_IS_SORTED_H_
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_MULTIWAY_MERGE_H_
+#define CPPSORT_UTILITY_MULTIWAY_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/multiway_merge.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    namespace detail
+    {
+        // A run is either an iterable or a pair of iterators
+
+        template<typename Iterable>
+        auto run_begin(Iterable&& iterable)
+            -> decltype(std::begin(iterable))
+        {
+            return std::begin(iterable);
+        }
+
+        template<typename Iterator>
+        auto run_begin(const std::pair<Iterator, Iterator>& run)
+            -> Iterator
+        {
+            return run.first;
+        }
+
+        template<typename Iterable>
+        auto run_end(Iterable&& iterable)
+            -> decltype(std::end(iterable))
+        {
+            return std::end(iterable);
+        }
+
+        template<typename Iterator>
+        auto run_end(const std::pair<Iterator, Iterator>& run)
+            -> Iterator
+        {
+            return run.second;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Merges a collection of sorted runs into out in a single
+    // pass, stable and with log2(k) comparisons per element
+
+    template<
+        typename ForwardIterable,
+        typename OutputIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto multiway_merge(ForwardIterable&& runs, OutputIterator out,
+                        Compare compare={}, Projection projection={})
+        -> OutputIterator
+    {
+        using iterator = decltype(detail::run_begin(*std::begin(runs)));
+
+        std::vector<std::pair<iterator, iterator>> iterators;
+        for (auto&& run: runs) {
+            iterators.emplace_back(detail::run_begin(run), detail::run_end(run));
+        }
+        return cppsort::detail::multiway_merge<false>(iterators, std::move(out),
+                                                      std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_UTILITY_MULTIWAY_MERGE_H_
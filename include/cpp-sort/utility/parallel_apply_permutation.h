@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_PARALLEL_APPLY_PERMUTATION_H_
+#define CPPSORT_UTILITY_PARALLEL_APPLY_PERMUTATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "../detail/config.h"
+#include "../detail/immovable_vector.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/position_bitset.h"
+#include "../detail/work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    // Permutations moving less memory than this are applied
+    // sequentially, they fit in the cache of most machines
+    constexpr std::size_t parallel_permutation_min_bytes = 1 << 23;
+
+    // Maximum number of positions moved by a single segment of
+    // cycle, longer cycles are split into several segments
+    constexpr std::size_t permutation_segment_size = 1 << 14;
+
+    // Segment of a cycle of the permutation: [begin, end) is a range
+    // of the positions stored in cycle order. A segment covering a
+    // whole cycle is rotated on its own, otherwise its last position
+    // receives the value that initially was at the first position of
+    // the next segment of the cycle, saved beforehand at index saved
+    struct permutation_segment
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t saved;
+        bool whole_cycle;
+    };
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    auto parallel_apply_permutation(RandomAccessIterator1 first,
+                                    RandomAccessIterator2 indices_first, std::size_t size,
+                                    std::size_t nb_threads)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator1>;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator1>;
+        using utility::iter_move;
+
+        ////////////////////////////////////////////////////////////
+        // Find the cycles of the permutation and split them into
+        // segments, this only reads the indices
+
+        std::vector<difference_type> positions;
+        positions.reserve(size);
+        std::vector<permutation_segment> segments;
+        std::size_t nb_saved = 0;
+
+        position_bitset visited(size);
+        for (auto start = visited.next_unset(0); start < size; start = visited.next_unset(start + 1)) {
+            visited.set(start);
+            auto start_idx = static_cast<difference_type>(start);
+            auto next_idx = static_cast<difference_type>(indices_first[start_idx]);
+            if (next_idx == start_idx) continue;
+
+            auto cycle_begin = positions.size();
+            positions.push_back(start_idx);
+            do {
+                positions.push_back(next_idx);
+                visited.set(static_cast<std::size_t>(next_idx));
+                next_idx = static_cast<difference_type>(indices_first[next_idx]);
+            } while (next_idx != start_idx);
+            auto cycle_end = positions.size();
+
+            if (cycle_end - cycle_begin <= permutation_segment_size) {
+                segments.push_back({ cycle_begin, cycle_end, 0, true });
+                continue;
+            }
+            // The segment i receives the value saved by the segment i+1,
+            // and the last one receives the value saved by the first one
+            auto first_saved = nb_saved;
+            for (auto begin = cycle_begin; begin < cycle_end; begin += permutation_segment_size) {
+                auto end = (std::min)(begin + permutation_segment_size, cycle_end);
+                segments.push_back({ begin, end, ++nb_saved, false });
+            }
+            segments.back().saved = first_saved;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Save the first value of every segment of the split cycles
+        // before any of them is overwritten
+
+        immovable_vector<rvalue_type> saved(static_cast<std::ptrdiff_t>(nb_saved));
+        for (const auto& segment: segments) {
+            if (not segment.whole_cycle) {
+                saved.emplace_back(iter_move(first + positions[segment.begin]));
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Move the elements, every position is written by exactly
+        // one segment and only read by the segment that writes it,
+        // which makes the segments independent from each other
+
+        auto move_segment = [&](const permutation_segment& segment) {
+            auto pos = positions.begin() + static_cast<difference_type>(segment.begin);
+            auto end = positions.begin() + static_cast<difference_type>(segment.end) - 1;
+            if (segment.whole_cycle) {
+                auto tmp = iter_move(first + *pos);
+                for (; pos != end; ++pos) {
+                    first[*pos] = iter_move(first + pos[1]);
+                }
+                first[*end] = std::move(tmp);
+            } else {
+                for (; pos != end; ++pos) {
+                    first[*pos] = iter_move(first + pos[1]);
+                }
+                first[*end] = std::move(saved[static_cast<std::ptrdiff_t>(segment.saved)]);
+            }
+        };
+
+        work_stealing_pool pool(nb_threads);
+        std::size_t batch_begin = 0;
+        while (batch_begin < segments.size()) {
+            // Group small cycles so that every task moves roughly the
+            // same number of elements
+            auto batch_end = batch_begin;
+            std::size_t batch_size = 0;
+            do {
+                batch_size += segments[batch_end].end - segments[batch_end].begin;
+                ++batch_end;
+            } while (batch_end < segments.size() && batch_size < permutation_segment_size);
+
+            pool.submit([&, batch_begin, batch_end] {
+                for (auto idx = batch_begin; idx < batch_end; ++idx) {
+                    move_segment(segments[idx]);
+                }
+            });
+            batch_begin = batch_end;
+        }
+        pool.wait();
+    }
+}
+
+namespace utility
+{
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    auto parallel_apply_permutation(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                    RandomAccessIterator2 indices_first, RandomAccessIterator2 indices_last,
+                                    std::size_t nb_threads=cppsort::detail::default_thread_count())
+        -> void
+    {
+        using rvalue_type = cppsort::detail::rvalue_type_t<RandomAccessIterator1>;
+        CPPSORT_ASSERT( (last - first) == (indices_last - indices_first) );
+        (void)last;
+
+        auto size = static_cast<std::size_t>(indices_last - indices_first);
+        if (nb_threads < 2 || size * sizeof(rvalue_type) < cppsort::detail::parallel_permutation_min_bytes) {
+            apply_const_permutation(std::move(first), std::move(last),
+                                    std::move(indices_first), std::move(indices_last));
+            return;
+        }
+        cppsort::detail::parallel_apply_permutation(std::move(first), std::move(indices_first),
+                                                    size, nb_threads);
+    }
+
+    template<typename RandomAccessIterable1, typename RandomAccessIterable2>
+    auto parallel_apply_permutation(RandomAccessIterable1&& iterable, const RandomAccessIterable2& indices,
+                                    std::size_t nb_threads=cppsort::detail::default_thread_count())
+        -> void
+    {
+        parallel_apply_permutation(std::begin(iterable), std::end(iterable),
+                                   std::begin(indices), std::end(indices),
+                                   nb_threads);
+    }
+}}
+
+#endif // CPPSORT_UTILITY_PARALLEL_APPLY_PERMUTATION_H_
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/compact_schwartz_adapter.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+namespace
+{
+    struct tagged_value
+    {
+        int value;
+        int order;
+    };
+}
+
+TEMPLATE_TEST_CASE( "compact_schwartz_adapter with several sorters", "[compact_schwartz_adapter]",
+                    cppsort::heap_sorter,
+                    cppsort::merge_sorter,
+                    cppsort::pdq_sorter,
+                    cppsort::spin_sorter,
+                    cppsort::tim_sorter )
+{
+    using wrapper = generic_wrapper<double>;
+
+    std::vector<wrapper> collection;
+    auto distribution = dist::shuffled{};
+    distribution.call<double>(std::back_inserter(collection), 412, -125);
+
+    cppsort::compact_schwartz_adapter<TestType> sorter;
+
+    SECTION( "ascending order" )
+    {
+        sorter(collection, &wrapper::value);
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::less<>{}, &wrapper::value) );
+    }
+
+    SECTION( "descending order" )
+    {
+        sorter(collection.begin(), collection.end(), std::greater<>{}, &wrapper::value);
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::greater<>{}, &wrapper::value) );
+    }
+}
+
+TEST_CASE( "compact_schwartz_adapter with expensive projections", "[compact_schwartz_adapter]" )
+{
+    std::vector<std::string> collection;
+    auto distribution = dist::shuffled{};
+    std::vector<int> values;
+    distribution(std::back_inserter(values), 1000);
+    for (int value: values) {
+        collection.push_back(std::to_string(value));
+    }
+
+    int nb_projections = 0;
+    auto to_int = [&nb_projections](const std::string& str) {
+        ++nb_projections;
+        return std::stoi(str);
+    };
+
+    SECTION( "integral keys, radix sort" )
+    {
+        cppsort::compact_schwartz_adapter<cppsort::heap_sorter> sorter;
+        sorter(collection, std::less<>{}, to_int);
+        CHECK( nb_projections == 1000 );
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::less<>{}, to_int) );
+    }
+
+    SECTION( "integral keys, adapted sorter" )
+    {
+        cppsort::compact_schwartz_adapter<cppsort::pdq_sorter> sorter;
+        sorter(collection, std::greater<>{}, to_int);
+        CHECK( nb_projections == 1000 );
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::greater<>{}, to_int) );
+    }
+}
+
+TEST_CASE( "compact_schwartz_adapter stability", "[compact_schwartz_adapter][is_stable]" )
+{
+    std::vector<tagged_value> collection;
+    for (int i = 0; i < 1000; ++i) {
+        collection.push_back({ (i * 7919) % 37, i });
+    }
+
+    auto check_stable = [](const std::vector<tagged_value>& vec) {
+        return std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.order < rhs.order);
+        });
+    };
+
+    SECTION( "radix sort is stable" )
+    {
+        auto copy = collection;
+        cppsort::compact_schwartz_adapter<cppsort::heap_sorter> sorter;
+        sorter(copy, &tagged_value::value);
+        CHECK( check_stable(copy) );
+    }
+
+    SECTION( "stable adapted sorter" )
+    {
+        auto copy = collection;
+        cppsort::compact_schwartz_adapter<cppsort::merge_sorter> sorter;
+        sorter(copy, [](int lhs, int rhs) { return lhs < rhs; }, &tagged_value::value);
+        CHECK( check_stable(copy) );
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/memory_resource_adapter.h>
+#include <cpp-sort/sorters/grail_sorter.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/wiki_sorter.h>
+#include <cpp-sort/utility/buffer.h>
+#include <testing-tools/distributions.h>
+
+#if __cplusplus > 201402L && __has_include(<memory_resource>)
+
+#include <memory_resource>
+
+namespace
+{
+    // Memory resource keeping track of what goes through it
+    class tracking_resource:
+        public std::pmr::memory_resource
+    {
+        public:
+            std::size_t allocations = 0;
+            std::size_t bytes_in_use = 0;
+
+        private:
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                ++allocations;
+                bytes_in_use += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+                -> void override
+            {
+                bytes_in_use -= bytes;
+                std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+            }
+
+            auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+    };
+}
+
+TEMPLATE_TEST_CASE( "memory_resource_adapter with buffered sorters", "[memory_resource_adapter]",
+                    cppsort::grail_sorter<
+                        cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
+                    >,
+                    cppsort::merge_sorter,
+                    cppsort::spin_sorter,
+                    cppsort::tim_sorter,
+                    cppsort::wiki_sorter<
+                        cppsort::utility::dynamic_buffer<cppsort::utility::half>
+                    > )
+{
+    std::vector<int> collection;
+    collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000);
+
+    tracking_resource resource;
+    cppsort::memory_resource_adapter<TestType> sorter(&resource);
+    sorter(collection);
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    CHECK( resource.allocations > 0 );
+    CHECK( resource.bytes_in_use == 0 );
+}
+
+TEMPLATE_TEST_CASE( "memory_resource_adapter with an arena", "[memory_resource_adapter]",
+                    cppsort::merge_sorter,
+                    cppsort::tim_sorter )
+{
+    std::vector<long long> collection;
+    collection.reserve(5000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 5000);
+
+    // The first block of the arena is big enough for both sorts
+    tracking_resource upstream;
+    std::pmr::monotonic_buffer_resource arena(1 << 20, &upstream);
+    cppsort::memory_resource_adapter<TestType> sorter(&arena);
+    CHECK( sorter.resource() == &arena );
+
+    sorter(collection);
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    auto upstream_allocations = upstream.allocations;
+    CHECK( upstream_allocations > 0 );
+
+    // Sorting again only allocates through the arena
+    std::reverse(collection.begin(), collection.end());
+    sorter(collection.begin(), collection.end());
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    CHECK( upstream.allocations == upstream_allocations );
+}
+
+TEST_CASE( "memory_resource_adapter with tim_sorter's run stack", "[memory_resource_adapter]" )
+{
+    // A sorted collection is a single run and needs no merge
+    // buffer, only the stack of pending runs is allocated
+    std::vector<int> collection;
+    collection.reserve(1000);
+    auto distribution = dist::ascending{};
+    distribution(std::back_inserter(collection), 1000);
+
+    tracking_resource resource;
+    cppsort::memory_resource_adapter<cppsort::tim_sorter> sorter(&resource);
+    sorter(collection);
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    CHECK( resource.allocations > 0 );
+    CHECK( resource.bytes_in_use == 0 );
+}
+
+TEST_CASE( "memory_resource_adapter with an unbuffered sorter", "[memory_resource_adapter]" )
+{
+    std::vector<int> collection;
+    collection.reserve(500);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 500);
+
+    tracking_resource resource;
+    cppsort::memory_resource_adapter<cppsort::heap_sorter> sorter(&resource);
+    sorter(collection, std::greater<>{});
+    CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    CHECK( resource.allocations == 0 );
+}
+
+#endif
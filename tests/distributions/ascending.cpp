@@ -28,6 +28,9 @@ TEMPLATE_TEST_CASE( "test sorter with ascending distribution", "[distributions]"
                     cppsort::heap_sorter,
                     cppsort::mel_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/metrics/allocated_memory.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::allocated_memory tests", "[metrics]" )
+{
+    std::vector<int> collection;
+    collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000);
+
+    SECTION( "with an algorithm that allocates memory" )
+    {
+        cppsort::metrics::allocated_memory<
+            cppsort::merge_sorter
+        > sorter;
+
+        auto res = sorter(collection);
+        CHECK( res >= 500 * sizeof(int) );
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "with an algorithm that doesn't allocate memory" )
+    {
+        cppsort::metrics::allocated_memory<
+            cppsort::heap_sorter
+        > sorter;
+
+        auto res = sorter(collection);
+        CHECK( res == 0 );
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+}
+
+TEST_CASE( "nested metrics::allocated_memory", "[metrics]" )
+{
+    std::vector<int> collection;
+    collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1000);
+
+    using inner_t = cppsort::metrics::allocated_memory<cppsort::tim_sorter>;
+    cppsort::metrics::allocated_memory<inner_t> sorter;
+
+    auto copy = collection;
+    auto inner_res = inner_t{}(copy);
+
+    auto res = sorter(collection);
+    CHECK( res == inner_res.value() );
+    CHECK( res > 0 );
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes/estimate.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/runs.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "presortedness estimate: inv", "[probe][inv][estimate]" )
+{
+    using cppsort::probe::inv;
+    cppsort::probe::estimate<decltype(inv)> estimate_inv;
+
+    SECTION( "small collections are measured exactly" )
+    {
+        std::vector<int> vec = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+        auto res = estimate_inv(vec);
+        CHECK( res.value == 19 );
+        CHECK( res.lower_bound == 19 );
+        CHECK( res.upper_bound == 19 );
+
+        std::vector<internal_compare<int>> tricky(vec.begin(), vec.end());
+        CHECK( estimate_inv(tricky, &internal_compare<int>::compare_to).value == 19 );
+    }
+
+    SECTION( "bounds contain the exact value" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(vec), 50'000);
+
+        auto exact = inv(vec);
+        auto res = estimate_inv(vec);
+        CHECK( res.lower_bound <= exact );
+        CHECK( exact <= res.upper_bound );
+        CHECK( res.lower_bound <= res.value );
+        CHECK( res.value <= res.upper_bound );
+
+        auto res_greater = estimate_inv(vec.begin(), vec.end(), std::greater<>{});
+        auto exact_greater = inv(vec, std::greater<>{});
+        CHECK( res_greater.lower_bound <= exact_greater );
+        CHECK( exact_greater <= res_greater.upper_bound );
+    }
+
+    SECTION( "sorted collections" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::ascending{};
+        distribution(std::back_inserter(vec), 50'000);
+
+        auto res = estimate_inv(vec);
+        CHECK( res.value == 0 );
+        CHECK( res.lower_bound == 0 );
+
+        std::reverse(vec.begin(), vec.end());
+        res = estimate_inv(vec);
+        CHECK( res.value == inv.max_for_size(std::ptrdiff_t(50'000)) );
+        CHECK( res.upper_bound == inv.max_for_size(std::ptrdiff_t(50'000)) );
+    }
+
+    SECTION( "more samples give tighter bounds" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 50'000);
+
+        cppsort::probe::estimate<decltype(inv)> precise_inv(16'384);
+        auto res = estimate_inv(vec);
+        auto precise_res = precise_inv(vec);
+        CHECK( precise_res.upper_bound - precise_res.lower_bound
+               < res.upper_bound - res.lower_bound );
+    }
+}
+
+TEST_CASE( "presortedness estimate: runs", "[probe][runs][estimate]" )
+{
+    using cppsort::probe::runs;
+    cppsort::probe::estimate<decltype(runs)> estimate_runs(256, 0.99);
+    CHECK( estimate_runs.sample_size() == 256 );
+    CHECK( estimate_runs.confidence() == 0.99 );
+
+    SECTION( "small collections are measured exactly" )
+    {
+        std::vector<int> vec = { 40, 49, 58, 99, 60, 70, 12, 87, 9, 8, 82, 91, 99, 67, 82, 92 };
+        auto res = estimate_runs(vec);
+        CHECK( res.value == 5 );
+        CHECK( res.lower_bound == 5 );
+        CHECK( res.upper_bound == 5 );
+    }
+
+    SECTION( "bounds contain the exact value" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(vec), 50'000);
+
+        auto exact = runs(vec);
+        auto res = estimate_runs(vec);
+        CHECK( res.lower_bound <= exact );
+        CHECK( exact <= res.upper_bound );
+
+        std::vector<int> shuffled;
+        auto shuffled_distribution = dist::shuffled{};
+        shuffled_distribution(std::back_inserter(shuffled), 50'000);
+        exact = runs(shuffled);
+        res = estimate_runs(shuffled);
+        CHECK( res.lower_bound <= exact );
+        CHECK( exact <= res.upper_bound );
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/config.h>
+#include <cpp-sort/detail/parallel_longest_non_descending_subsequence.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/osc.h>
+#include <cpp-sort/probes/rem.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+#if CPPSORT_EXECUTION_POLICIES
+#   include <execution>
+#endif
+
+namespace
+{
+    // Collections need to be big enough to trigger the parallel
+    // algorithms, and varied enough to exercise every merge and
+    // reconciliation path
+    template<typename Distribution>
+    auto make_collection(Distribution distribution)
+        -> std::vector<int>
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), 100'000);
+        return vec;
+    }
+
+    auto test_collections()
+        -> std::vector<std::vector<int>>
+    {
+        return {
+            make_collection(dist::shuffled{}),
+            make_collection(dist::shuffled_16_values{}),
+            make_collection(dist::ascending{}),
+            make_collection(dist::descending{}),
+            make_collection(dist::pipe_organ{}),
+            make_collection(dist::push_middle{}),
+            make_collection(dist::ascending_sawtooth{}),
+            make_collection(dist::alternating{}),
+        };
+    }
+}
+
+TEST_CASE( "parallel presortedness measures", "[probe][parallel]" )
+{
+    using cppsort::probe::inv;
+    using cppsort::probe::osc;
+    using cppsort::probe::rem;
+
+    // The machines running the tests might not have more than
+    // one hardware thread, so the algorithms are also called
+    // directly with an explicit number of threads
+    auto collections = test_collections();
+
+    SECTION( "inv" )
+    {
+        for (auto& vec: collections) {
+            auto expected = inv(vec);
+            auto expected_greater = inv(vec, std::greater<>{});
+            for (std::size_t nb_threads: { 2, 3, 4, 9, 40 }) {
+                CHECK( cppsort::probe::detail::parallel_inv_probe_algo(
+                    vec.begin(), vec.end(), vec.size(),
+                    std::less<>{}, cppsort::utility::identity{}, nb_threads
+                ) == expected );
+                CHECK( cppsort::probe::detail::parallel_inv_probe_algo(
+                    vec.begin(), vec.end(), vec.size(),
+                    std::greater<>{}, cppsort::utility::identity{}, nb_threads
+                ) == expected_greater );
+            }
+        }
+    }
+
+    SECTION( "rem" )
+    {
+        for (auto& vec: collections) {
+            auto expected = rem(vec);
+            auto expected_greater = rem(vec, std::greater<>{});
+            for (std::size_t nb_threads: { 2, 3, 4, 9, 40 }) {
+                auto res = cppsort::detail::parallel_longest_non_descending_subsequence(
+                    vec.begin(), vec.end(),
+                    std::less<>{}, cppsort::utility::identity{}, nb_threads
+                );
+                CHECK( res.second == static_cast<std::ptrdiff_t>(vec.size()) );
+                CHECK( res.second - res.first == expected );
+
+                auto res_greater = cppsort::detail::parallel_longest_non_descending_subsequence(
+                    vec.begin(), vec.end(),
+                    std::greater<>{}, cppsort::utility::identity{}, nb_threads
+                );
+                CHECK( res_greater.second - res_greater.first == expected_greater );
+            }
+        }
+    }
+
+    SECTION( "osc" )
+    {
+        for (auto& vec: collections) {
+            auto expected = osc(vec);
+            for (std::size_t nb_threads: { 2, 3, 4, 9, 40 }) {
+                CHECK( cppsort::probe::detail::parallel_osc_algo(
+                    vec.begin(), vec.end(), vec.size(),
+                    std::less<>{}, cppsort::utility::identity{}, nb_threads
+                ) == expected );
+            }
+        }
+    }
+
+    SECTION( "forward iterators and projections" )
+    {
+        auto vec = make_collection(dist::shuffled{});
+        std::list<internal_compare<int>> li(vec.begin(), vec.end());
+        std::list<int> ints(vec.begin(), vec.end());
+        auto expected_inv = inv(vec);
+        auto expected_osc = osc(vec, std::negate<>{});
+
+        for (std::size_t nb_threads: { 2, 4 }) {
+            CHECK( cppsort::probe::detail::parallel_inv_probe_algo(
+                li.begin(), li.end(), li.size(),
+                &internal_compare<int>::compare_to, cppsort::utility::identity{}, nb_threads
+            ) == expected_inv );
+            CHECK( cppsort::probe::detail::parallel_osc_algo(
+                ints.begin(), ints.end(), ints.size(),
+                std::less<>{}, std::negate<>{}, nb_threads
+            ) == expected_osc );
+        }
+    }
+
+#if CPPSORT_EXECUTION_POLICIES
+    SECTION( "execution policies" )
+    {
+        auto vec = make_collection(dist::shuffled_16_values{});
+        std::list<int> li(vec.begin(), vec.end());
+
+        CHECK( inv(std::execution::par, vec) == inv(vec) );
+        CHECK( inv(std::execution::seq, vec.begin(), vec.end()) == inv(vec) );
+        CHECK( inv(std::execution::par_unseq, li, std::greater<>{}) == inv(vec, std::greater<>{}) );
+
+        CHECK( rem(std::execution::par, vec) == rem(vec) );
+        CHECK( rem(std::execution::seq, vec.begin(), vec.end()) == rem(vec) );
+        CHECK( rem(std::execution::par_unseq, li, std::greater<>{}) == rem(vec, std::greater<>{}) );
+
+        CHECK( osc(std::execution::par, vec) == osc(vec) );
+        CHECK( osc(std::execution::seq, vec.begin(), vec.end()) == osc(vec) );
+        CHECK( osc(std::execution::par_unseq, li.begin(), li.end(), std::greater<>{}) == osc(vec, std::greater<>{}) );
+    }
+#endif
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/config.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
+
+#if CPPSORT_EXECUTION_POLICIES
+#include <execution>
+
+namespace
+{
+    enum struct call
+    {
+        sequential,
+        policy
+    };
+
+    struct sequential_sorter_impl
+    {
+        template<
+            typename Iterator,
+            typename Compare = std::less<>,
+            typename Projection = cppsort::utility::identity,
+            typename = std::enable_if_t<cppsort::is_projection_iterator_v<
+                Projection, Iterator, Compare
+            >>
+        >
+        auto operator()(Iterator, Iterator, Compare={}, Projection={}) const
+            -> call
+        {
+            return call::sequential;
+        }
+    };
+
+    struct policy_sorter_impl:
+        sequential_sorter_impl
+    {
+        using sequential_sorter_impl::operator();
+
+        template<
+            typename ExecutionPolicy,
+            typename Iterator,
+            typename Compare = std::less<>,
+            typename Projection = cppsort::utility::identity,
+            typename = std::enable_if_t<
+                std::is_execution_policy_v<std::decay_t<ExecutionPolicy>> &&
+                cppsort::is_projection_iterator_v<Projection, Iterator, Compare>
+            >
+        >
+        auto operator()(ExecutionPolicy&&, Iterator, Iterator, Compare={}, Projection={}) const
+            -> call
+        {
+            return call::policy;
+        }
+
+        template<typename ExecutionPolicy>
+        using supports_execution_policy = std::is_same<
+            std::decay_t<ExecutionPolicy>,
+            std::execution::parallel_policy
+        >;
+    };
+
+    struct sequential_sorter:
+        cppsort::sorter_facade<sequential_sorter_impl>
+    {};
+
+    struct policy_sorter:
+        cppsort::sorter_facade<policy_sorter_impl>
+    {};
+}
+
+TEST_CASE( "sorter_facade with execution policies", "[sorter_facade][execution]" )
+{
+    std::vector<int> vec;
+    std::list<int> li;
+
+    SECTION( "supports_execution_policy" )
+    {
+        using par_t = std::execution::parallel_policy;
+        using seq_t = std::execution::sequenced_policy;
+
+        STATIC_CHECK( cppsort::supports_execution_policy_v<policy_sorter, par_t> );
+        STATIC_CHECK( cppsort::supports_execution_policy_v<policy_sorter, const par_t&> );
+        STATIC_CHECK( not cppsort::supports_execution_policy_v<policy_sorter, seq_t> );
+        STATIC_CHECK( not cppsort::supports_execution_policy_v<policy_sorter, int> );
+        STATIC_CHECK( not cppsort::supports_execution_policy_v<sequential_sorter, par_t> );
+        STATIC_CHECK( not cppsort::supports_execution_policy_v<cppsort::pdq_sorter, par_t> );
+
+        STATIC_CHECK( cppsort::supports_execution_policy_v<cppsort::parallel_merge_sorter, par_t> );
+        STATIC_CHECK( cppsort::supports_execution_policy_v<cppsort::parallel_pdq_sorter, seq_t> );
+        STATIC_CHECK( cppsort::supports_execution_policy_v<
+            cppsort::parallel_ska_sorter,
+            std::execution::parallel_unsequenced_policy
+        > );
+    }
+
+    SECTION( "supported policies are forwarded" )
+    {
+        policy_sorter sorter;
+        CHECK( sorter(std::execution::par, vec) == call::policy );
+        CHECK( sorter(std::execution::par, vec.begin(), vec.end()) == call::policy );
+        CHECK( sorter(std::execution::par, li, std::greater<>{}) == call::policy );
+        CHECK( sorter(std::execution::par, vec, std::greater<>{}, std::negate<>{}) == call::policy );
+        CHECK( sorter(std::execution::par, li.begin(), li.end(),
+                      std::greater<>{}, std::negate<>{}) == call::policy );
+    }
+
+    SECTION( "other policies fall back to sequential sorting" )
+    {
+        policy_sorter sorter;
+        CHECK( sorter(std::execution::seq, vec) == call::sequential );
+        CHECK( sorter(std::execution::par_unseq, vec.begin(), vec.end()) == call::sequential );
+        CHECK( sorter(std::execution::seq, li, std::greater<>{}) == call::sequential );
+        CHECK( sorter(std::execution::par_unseq, vec, std::greater<>{}, std::negate<>{}) == call::sequential );
+
+        sequential_sorter seq_sorter;
+        CHECK( seq_sorter(std::execution::par, vec) == call::sequential );
+        CHECK( seq_sorter(std::execution::par, li, std::negate<>{}) == call::sequential );
+        CHECK( seq_sorter(std::execution::seq, vec.begin(), vec.end(), std::greater<>{}) == call::sequential );
+    }
+
+    SECTION( "library sorters" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+
+        auto copy = vec;
+        cppsort::parallel_pdq_sort(std::execution::par, copy);
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+        copy = vec;
+        cppsort::parallel_merge_sort(std::execution::seq, copy.begin(), copy.end(), std::greater<>{});
+        CHECK( std::is_sorted(copy.begin(), copy.end(), std::greater<>{}) );
+
+        copy = vec;
+        cppsort::parallel_ska_sort(std::execution::par_unseq, copy, std::negate<>{});
+        CHECK( std::is_sorted(copy.begin(), copy.end(), std::greater<>{}) );
+
+        copy = vec;
+        cppsort::pdq_sort(std::execution::par, copy.begin(), copy.end());
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+    }
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/auto_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+namespace
+{
+    // Table always picking the same algorithm
+    struct forced_table
+    {
+        cppsort::auto_sorter_choice choice;
+
+        auto choose(const cppsort::auto_sorter_features& features) const
+            -> cppsort::auto_sorter_decision
+        {
+            return { choice, "forced", features };
+        }
+    };
+}
+
+TEST_CASE( "auto_sorter decisions", "[auto_sorter]" )
+{
+    using cppsort::auto_sorter_choice;
+    cppsort::auto_sorter<> sorter;
+
+    SECTION( "small collection" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 50);
+
+        auto decision = sorter.decide(vec);
+        CHECK( decision.choice == auto_sorter_choice::pdq );
+        CHECK( decision.features.size == 50 );
+        // Nothing else is measured below small_size
+        CHECK( decision.features.runs == 0 );
+        CHECK( decision.features.inversion_ratio == 0.0 );
+        CHECK( not decision.features.integral_key );
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "ascending and descending runs" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(vec), 100'000);
+        // Keys too sparse for counting_sorter
+        for (auto& value: vec) {
+            value *= 1000;
+        }
+
+        auto decision = sorter.decide(vec);
+        CHECK( decision.choice == auto_sorter_choice::verge );
+        CHECK( decision.features.runs == cppsort::probe::runs(vec) );
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<int> vec2;
+        auto distribution2 = dist::ascending{};
+        distribution2(std::back_inserter(vec2), 100'000);
+
+        decision = sorter.decide(vec2, std::greater<>{});
+        CHECK( decision.choice == auto_sorter_choice::verge );
+        CHECK( decision.features.runs == 99'999 );
+        sorter(vec2, std::greater<>{});
+        CHECK( std::is_sorted(vec2.begin(), vec2.end(), std::greater<>{}) );
+    }
+
+    SECTION( "dense integer keys" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(vec), 100'000);
+
+        auto decision = sorter.decide(vec);
+        CHECK( decision.choice == auto_sorter_choice::counting );
+        CHECK( decision.features.integral_key );
+        CHECK( decision.features.key_range == 15 );
+        CHECK( decision.features.key_width == 4 );
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "wide 128-bit integer keys" )
+    {
+        // The range of these keys doesn't fit in key_range, which
+        // used to make them look dense enough for counting_sorter
+        std::vector<__int128_t> vec;
+        for (int i = 0 ; i < 5000 ; ++i) {
+            vec.push_back(__int128_t(i * 7919 % 5000) << 80);
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        auto decision = sorter.decide(vec);
+        CHECK( decision.choice != auto_sorter_choice::counting );
+        CHECK( not decision.features.countable );
+        sorter(vec);
+        CHECK( vec == expected );
+
+        // counting_sorter forced by a custom table falls back to pdq_sorter
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::auto_sorter<forced_table> forced_sorter(
+            forced_table{ auto_sorter_choice::counting }
+        );
+        forced_sorter(vec);
+        CHECK( vec == expected );
+    }
+#endif
+
+    SECTION( "few inversions" )
+    {
+        std::vector<double> vec;
+        auto distribution = dist::inversions(0.01);
+        distribution.operator()<double>(std::back_inserter(vec), 100'000);
+
+        auto decision = sorter.decide(vec);
+        CHECK( (decision.choice == auto_sorter_choice::drop_merge ||
+                decision.choice == auto_sorter_choice::split) );
+        CHECK( decision.features.inversion_ratio < 0.05 );
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "radix-sortable keys" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+        for (auto& value: vec) {
+            value *= 1000;
+        }
+
+        auto decision = sorter.decide(vec);
+        CHECK( decision.choice == auto_sorter_choice::ska );
+        CHECK( decision.features.radix_sortable );
+        CHECK( decision.features.key_range == 99'999'000 );
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        // ska_sorter doesn't handle other comparisons
+        decision = sorter.decide(vec, std::greater<>{});
+        CHECK( decision.choice == auto_sorter_choice::verge );
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        decision = sorter.decide(vec, std::greater<>{});
+        CHECK( decision.choice == auto_sorter_choice::pdq );
+        CHECK( not decision.features.radix_sortable );
+        CHECK( not decision.features.integral_key );
+        CHECK( decision.reason == std::string("no exploitable structure") );
+        sorter(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "auto_sorter with a custom table", "[auto_sorter]" )
+{
+    using cppsort::auto_sorter_choice;
+
+    std::vector<std::string> strings;
+    std::vector<int> integers;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(integers), 10'000);
+    for (int value: integers) {
+        strings.push_back(std::to_string(value));
+    }
+
+    // The type-specific algorithms fall back to pdq_sorter
+    // when they can't sort the collection
+    for (auto choice: { auto_sorter_choice::counting, auto_sorter_choice::ska,
+                        auto_sorter_choice::verge, auto_sorter_choice::drop_merge,
+                        auto_sorter_choice::split, auto_sorter_choice::pdq }) {
+        cppsort::auto_sorter<forced_table> sorter(forced_table{choice});
+        CHECK( sorter.decide(strings).choice == choice );
+
+        auto vec = strings;
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        sorter(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+
+        auto vec2 = integers;
+        sorter(vec2, [](int value) { return -value; });
+        CHECK( std::is_sorted(vec2.begin(), vec2.end(), std::greater<>{}) );
+        sorter(vec2);
+        CHECK( std::is_sorted(vec2.begin(), vec2.end()) );
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/branchless_merge.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    // Elements with a key and their original position, the
+    // latter is used to check the stability of the merges
+    struct trivial_element
+    {
+        int key;
+        int index;
+    };
+
+    struct non_trivial_element
+    {
+        int key;
+        int index;
+        std::string padding;
+    };
+
+    template<typename Element>
+    auto make_elements(const std::vector<int>& keys)
+        -> std::vector<Element>
+    {
+        std::vector<Element> res;
+        for (int idx = 0 ; idx < static_cast<int>(keys.size()) ; ++idx) {
+            Element elem{};
+            elem.key = keys[idx];
+            elem.index = idx;
+            res.push_back(std::move(elem));
+        }
+        return res;
+    }
+
+    template<typename Element>
+    auto is_stably_sorted(const std::vector<Element>& collection)
+        -> bool
+    {
+        return std::is_sorted(collection.begin(), collection.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.index < rhs.index);
+        });
+    }
+}
+
+TEST_CASE( "branchless merge kernels", "[branchless_merge]" )
+{
+    using cppsort::detail::is_branchless_merge;
+    using int_iterator = std::vector<int>::iterator;
+
+    STATIC_CHECK( is_branchless_merge<int*, int_iterator, std::less<>, cppsort::utility::identity>::value );
+    STATIC_CHECK( is_branchless_merge<
+        trivial_element*, trivial_element*, std::less<>, decltype(&trivial_element::key)
+    >::value );
+    STATIC_CHECK( not is_branchless_merge<
+        int_iterator, int_iterator, std::function<bool(int, int)>, cppsort::utility::identity
+    >::value );
+    STATIC_CHECK( not is_branchless_merge<
+        std::string*, std::string*, std::less<>, cppsort::utility::identity
+    >::value );
+
+    auto check_merges = [](int len1, int len2, auto distribution) {
+        std::vector<int> keys;
+        distribution(std::back_inserter(keys), 250);
+        keys.resize(len1 + len2);
+        std::sort(keys.begin(), keys.begin() + len1);
+        std::sort(keys.begin() + len1, keys.end());
+
+        std::vector<int> expected(len1 + len2);
+        std::merge(keys.begin(), keys.begin() + len1, keys.begin() + len1, keys.end(), expected.begin());
+
+        // Bidirectional merge
+        std::vector<int> out(len1 + len2);
+        auto res = cppsort::detail::branchless_merge_move(
+            keys.begin(), keys.begin() + len1, keys.begin() + len1, keys.end(), out.begin(),
+            std::less<>{}, cppsort::utility::identity{}, cppsort::utility::identity{}
+        );
+        CHECK( res == out.end() );
+        CHECK( out == expected );
+
+        // Forward merge, second run already at the end of the output
+        std::vector<int> buffer(keys.begin(), keys.begin() + len1);
+        std::vector<int> half = keys;
+        cppsort::detail::branchless_half_inplace_merge(
+            buffer.begin(), buffer.end(), half.begin() + len1, half.end(), half.begin(),
+            std::less<>{}, cppsort::utility::identity{}
+        );
+        CHECK( half == expected );
+
+        // Stability of both variants
+        auto elements = make_elements<trivial_element>(keys);
+        std::vector<trivial_element> trivial_out(len1 + len2);
+        cppsort::detail::branchless_merge_move(
+            elements.begin(), elements.begin() + len1, elements.begin() + len1, elements.end(),
+            trivial_out.begin(), std::less<>{}, &trivial_element::key, &trivial_element::key
+        );
+        CHECK( is_stably_sorted(trivial_out) );
+
+        auto non_trivial = make_elements<non_trivial_element>(keys);
+        std::vector<non_trivial_element> non_trivial_out(len1 + len2);
+        cppsort::detail::branchless_merge_move(
+            non_trivial.begin(), non_trivial.begin() + len1, non_trivial.begin() + len1, non_trivial.end(),
+            non_trivial_out.begin(), std::less<>{}, &non_trivial_element::key, &non_trivial_element::key
+        );
+        CHECK( is_stably_sorted(non_trivial_out) );
+    };
+
+    for (int len1: { 0, 1, 2, 7, 64, 100 }) {
+        for (int len2: { 0, 1, 3, 64, 101 }) {
+            check_merges(len1, len2, dist::shuffled{});
+            check_merges(len1, len2, dist::shuffled_16_values{});
+            check_merges(len1, len2, dist::all_equal{});
+            check_merges(len1, len2, dist::descending{});
+        }
+    }
+}
+
+TEST_CASE( "stable sorters with branchless merges", "[branchless_merge][merge_sorter][tim_sorter][spin_sorter]" )
+{
+    std::vector<int> keys;
+    dist::shuffled_16_values{}(std::back_inserter(keys), 50'000);
+    auto elements = make_elements<trivial_element>(keys);
+    auto non_trivial = make_elements<non_trivial_element>(keys);
+
+    auto check_sorter = [&](auto sorter) {
+        auto copy = elements;
+        sorter(copy, &trivial_element::key);
+        CHECK( is_stably_sorted(copy) );
+
+        auto non_trivial_copy = non_trivial;
+        sorter(non_trivial_copy, &non_trivial_element::key);
+        CHECK( is_stably_sorted(non_trivial_copy) );
+
+        auto keys_copy = keys;
+        sorter(keys_copy);
+        CHECK( std::is_sorted(keys_copy.begin(), keys_copy.end()) );
+        sorter(keys_copy, std::greater<>{});
+        CHECK( std::is_sorted(keys_copy.begin(), keys_copy.end(), std::greater<>{}) );
+    };
+
+    check_sorter(cppsort::merge_sort);
+    check_sorter(cppsort::tim_sort);
+    check_sorter(cppsort::spin_sort);
+}
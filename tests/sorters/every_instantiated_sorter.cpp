@@ -34,6 +34,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "auto_sort" )
+    {
+        cppsort::auto_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
     SECTION( "cartesian_tree_sort" )
     {
         cppsort::cartesian_tree_sort(collection);
@@ -76,6 +82,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "lsd_radix_sorter" )
+    {
+        cppsort::lsd_radix_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
     SECTION( "mel_sorter" )
     {
         cppsort::mel_sort(collection);
@@ -94,6 +106,24 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "parallel_merge_sorter" )
+    {
+        cppsort::parallel_merge_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_pdq_sorter" )
+    {
+        cppsort::parallel_pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_ska_sorter" )
+    {
+        cppsort::parallel_ska_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
     SECTION( "pdq_sorter" )
     {
         cppsort::pdq_sort(collection);
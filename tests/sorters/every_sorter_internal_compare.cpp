@@ -13,6 +13,7 @@
 TEMPLATE_TEST_CASE( "test every sorter with a pointer to member function comparison",
                     "[sorters][as_function]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter<>,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<4>,
                     cppsort::drop_merge_sorter,
@@ -22,8 +23,11 @@ TEMPLATE_TEST_CASE( "test every sorter with a pointer to member function compari
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::powersort_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
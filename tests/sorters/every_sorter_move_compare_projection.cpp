@@ -14,6 +14,7 @@
 
 TEMPLATE_TEST_CASE( "every sorter with comparison function altered by move", "[sorters]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter<>,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<2>,
                     cppsort::drop_merge_sorter,
@@ -26,8 +27,11 @@ TEMPLATE_TEST_CASE( "every sorter with comparison function altered by move", "[s
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::powersort_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
@@ -56,6 +60,7 @@ TEMPLATE_TEST_CASE( "every sorter with comparison function altered by move", "[s
 
 TEMPLATE_TEST_CASE( "every sorter with projection function altered by move", "[sorters][projection]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter<>,
                     cppsort::cartesian_tree_sorter,
                     cppsort::drop_merge_sorter,
                     cppsort::grail_sorter<>,
@@ -64,11 +69,16 @@ TEMPLATE_TEST_CASE( "every sorter with projection function altered by move", "[s
                     >,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter,
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::powersort_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
@@ -15,6 +15,7 @@
 
 TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter<>,
                     cppsort::cartesian_tree_sorter,
                     cppsort::counting_sorter,
                     cppsort::d_ary_heap_sorter<6>,
@@ -23,11 +24,16 @@ TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter,
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::powersort_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
@@ -57,6 +63,7 @@ TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
 
 TEMPLATE_TEST_CASE( "test type-specific sorters with no_post_iterator further",
                     "[sorters][ska_sorter][spread_sorter]",
+                    cppsort::parallel_ska_sorter,
                     cppsort::ska_sorter,
                     cppsort::spread_sorter )
 {
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "lsd_radix_sorter tests", "[lsd_radix_sorter]" )
+{
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with unsigned int iterators" )
+    {
+        std::vector<unsigned> vec;
+        distribution(std::back_inserter(vec), 100'000);
+        cppsort::lsd_radix_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with 64-bit integers" )
+    {
+        std::vector<std::int64_t> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(static_cast<std::int64_t>(hasard::engine()()));
+        }
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<std::uint64_t> uvec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            uvec.push_back(hasard::engine()());
+        }
+        cppsort::lsd_radix_sort(uvec);
+        CHECK( std::is_sorted(uvec.begin(), uvec.end()) );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "sort with int128 iterable" )
+    {
+        std::vector<__int128_t> vec;
+        distribution(std::back_inserter(vec), 100'000, -10'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+#endif
+
+    SECTION( "sort with float and double iterables" )
+    {
+        std::vector<float> vec;
+        distribution.call<float>(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<double> dvec;
+        distribution.call<double>(std::back_inserter(dvec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(dvec);
+        CHECK( std::is_sorted(dvec.begin(), dvec.end()) );
+    }
+
+    SECTION( "different collection sizes" )
+    {
+        // Exercise the different digit sizes and the small
+        // collections fallback
+        for (int size: { 10, 63, 64, 1'000, 70'000, (1 << 22) + 17 }) {
+            std::vector<std::uint32_t> vec;
+            distribution(std::back_inserter(vec), size);
+            cppsort::lsd_radix_sort(vec);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        }
+
+        // Big collections of wider keys are scattered with write-combining
+        std::vector<std::uint64_t> vec;
+        distribution(std::back_inserter(vec), (1 << 22) + 17);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "digits shared by every key" )
+    {
+        std::vector<std::uint64_t> vec;
+        distribution(std::back_inserter(vec), 100'000, 0x1234'0000'0000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<int> equal_vec;
+        dist::all_equal{}(std::back_inserter(equal_vec), 100'000);
+        cppsort::lsd_radix_sort(equal_vec);
+        CHECK( std::is_sorted(equal_vec.begin(), equal_vec.end()) );
+    }
+}
+
+TEST_CASE( "lsd_radix_sorter tests with projections",
+           "[lsd_radix_sorter][projection]" )
+{
+    SECTION( "stability" )
+    {
+        // Only sort on some bits of the index so that there are
+        // lots of equivalent keys, in different digits
+        std::vector<std::pair<int, int>> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.emplace_back(i, i);
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        for (auto& elem: vec) {
+            elem.first = (elem.first >> 4) & 0x0f0f;
+        }
+        auto copy = vec;
+
+        cppsort::lsd_radix_sort(vec, &std::pair<int, int>::first);
+        std::stable_sort(copy.begin(), copy.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        CHECK( vec == copy );
+    }
+
+    SECTION( "non-trivially copyable elements" )
+    {
+        std::vector<std::pair<int, std::string>> vec;
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.emplace_back(i, std::to_string(i));
+        }
+        auto sorted = vec;
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::lsd_radix_sort(vec, &std::pair<int, std::string>::first);
+        CHECK( vec == sorted );
+    }
+
+    SECTION( "move-only elements" )
+    {
+        std::vector<std::unique_ptr<int>> vec;
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.push_back(std::make_unique<int>(i));
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::lsd_radix_sort(vec, [](const auto& ptr) { return *ptr; });
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(), std::less<>{},
+                                  [](const auto& ptr) { return *ptr; }) );
+    }
+}
+
+namespace
+{
+    struct record
+    {
+        std::uint32_t tenant;
+        std::int64_t timestamp;
+        std::string id;
+        int index;
+    };
+
+    auto to_radix_sort_key(const record& rec)
+    {
+        return std::tie(rec.tenant, rec.timestamp, rec.id);
+    }
+
+    auto make_records(int size)
+        -> std::vector<record>
+    {
+        // Few different values per field so that the less
+        // significant fields and the stability matter
+        std::vector<record> res;
+        for (int i = 0 ; i < size ; ++i) {
+            res.push_back({
+                static_cast<std::uint32_t>(hasard::engine()() % 8),
+                static_cast<std::int64_t>(hasard::engine()() % 1'000) - 500,
+                std::to_string(hasard::engine()() % 97),
+                i
+            });
+        }
+        return res;
+    }
+
+    auto record_fields(const std::vector<record>& vec)
+        -> std::vector<std::tuple<std::uint32_t, std::int64_t, std::string, int>>
+    {
+        std::vector<std::tuple<std::uint32_t, std::int64_t, std::string, int>> res;
+        for (auto& rec: vec) {
+            res.emplace_back(rec.tenant, rec.timestamp, rec.id, rec.index);
+        }
+        return res;
+    }
+
+    auto stable_sort_records(std::vector<record> vec)
+        -> std::vector<std::tuple<std::uint32_t, std::int64_t, std::string, int>>
+    {
+        std::stable_sort(vec.begin(), vec.end(), [](const record& lhs, const record& rhs) {
+            return to_radix_sort_key(lhs) < to_radix_sort_key(rhs);
+        });
+        return record_fields(vec);
+    }
+}
+
+TEST_CASE( "lsd_radix_sorter tests with composite keys",
+           "[lsd_radix_sorter][projection]" )
+{
+    SECTION( "to_radix_sort_key customization point" )
+    {
+        for (int size: { 10, 1'000, 100'000 }) {
+            auto vec = make_records(size);
+            auto expected = stable_sort_records(vec);
+            cppsort::lsd_radix_sort(vec);
+            CHECK( record_fields(vec) == expected );
+        }
+    }
+
+    SECTION( "projection returning a tuple of references" )
+    {
+        auto vec = make_records(100'000);
+        auto expected = stable_sort_records(vec);
+        cppsort::lsd_radix_sort(vec, [](const record& rec) {
+            return std::tie(rec.tenant, rec.timestamp, rec.id);
+        });
+        CHECK( record_fields(vec) == expected );
+    }
+
+    SECTION( "projection returning a tuple of values" )
+    {
+        auto vec = make_records(100'000);
+        auto expected = stable_sort_records(vec);
+        cppsort::lsd_radix_sort(vec, [](const record& rec) {
+            return std::make_tuple(rec.tenant, rec.timestamp, rec.id);
+        });
+        CHECK( record_fields(vec) == expected );
+    }
+
+    SECTION( "projection returning a custom key" )
+    {
+        // record has no operator<, the projection is checked
+        // against the order of the radix sort instead
+        std::vector<std::pair<int, record>> vec;
+        auto records = make_records(10'000);
+        auto expected = stable_sort_records(records);
+        for (auto& rec: records) {
+            vec.emplace_back(0, std::move(rec));
+        }
+        cppsort::lsd_radix_sort(vec, &std::pair<int, record>::second);
+        std::vector<record> res;
+        for (auto& elem: vec) {
+            res.push_back(std::move(elem.second));
+        }
+        CHECK( record_fields(res) == expected );
+    }
+
+    SECTION( "strings and pairs" )
+    {
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(std::to_string(hasard::engine()() % 1'000'000));
+        }
+        vec.emplace_back();
+        vec.emplace_back("\xff\xfe");
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<std::pair<std::string, double>> pairs;
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            pairs.emplace_back(std::to_string(hasard::engine()() % 100),
+                               static_cast<double>(hasard::engine()() % 1'000) - 500.5);
+        }
+        cppsort::lsd_radix_sort(pairs);
+        CHECK( std::is_sorted(pairs.begin(), pairs.end()) );
+    }
+}
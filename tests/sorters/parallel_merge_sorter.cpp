@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/parallel_merge_sort.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+using wrapper = generic_stable_wrapper<int>;
+
+TEST_CASE( "parallel_merge_sorter tests", "[parallel_merge_sorter]" )
+{
+    // The generic tests use collections too small to reach the
+    // parallel code path, and the machine running the tests might
+    // not have more than one hardware thread, so the algorithm is
+    // also called directly with an explicit number of threads
+
+    std::vector<long long int> collection;
+    collection.reserve(300'000);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 300'000, -100'000);
+        cppsort::parallel_merge_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "different numbers of threads" )
+    {
+        for (std::size_t nb_threads: { 2, 3, 4, 9, 40 }) {
+            collection.clear();
+            auto distribution = dist::shuffled{};
+            distribution(std::back_inserter(collection), 300'000);
+            cppsort::detail::parallel_merge_sort(collection.begin(), collection.end(),
+                                                 std::greater<>{}, cppsort::utility::identity{},
+                                                 nb_threads);
+            CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+        }
+    }
+
+    SECTION( "stability" )
+    {
+        std::vector<wrapper> wrappers(300'003);
+        helpers::iota(wrappers.begin(), wrappers.end(), 0, &wrapper::order);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(wrappers.begin(), wrappers.size());
+        cppsort::detail::parallel_merge_sort(wrappers.begin(), wrappers.end(),
+                                             std::less<>{}, &wrapper::value, 4);
+        CHECK( std::is_sorted(wrappers.begin(), wrappers.end()) );
+
+        // All the slices boundaries fall among equivalent elements
+        helpers::iota(wrappers.begin(), wrappers.end(), 0, &wrapper::order);
+        for (auto& wrapper: wrappers) {
+            wrapper.value = 0;
+        }
+        cppsort::detail::parallel_merge_sort(wrappers.begin(), wrappers.end(),
+                                             std::less<>{}, &wrapper::value, 9);
+        CHECK( std::is_sorted(wrappers.begin(), wrappers.end()) );
+    }
+
+    SECTION( "exceptions are propagated to the caller" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 300'000);
+        auto throwing_compare = [](long long int lhs, long long int rhs) {
+            if (lhs == 1234 || rhs == 1234) {
+                throw std::runtime_error("comparison failure");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS(
+            cppsort::detail::parallel_merge_sort(collection.begin(), collection.end(),
+                                                 throwing_compare, cppsort::utility::identity{}, 4),
+            std::runtime_error
+        );
+    }
+}
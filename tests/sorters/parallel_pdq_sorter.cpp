@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/parallel_pdqsort.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "parallel_pdq_sorter tests", "[parallel_pdq_sorter]" )
+{
+    // The generic tests use collections too small to reach the
+    // parallel code path, and the machine running the tests might
+    // not have more than one hardware thread, so the algorithm is
+    // also called directly with an explicit number of threads
+
+    std::vector<long long int> collection;
+    collection.reserve(500'000);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 500'000, -100'000);
+        cppsort::parallel_pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "several threads with different distributions" )
+    {
+        auto check_distribution = [&](auto distribution) {
+            collection.clear();
+            distribution(std::back_inserter(collection), 500'000);
+            cppsort::detail::parallel_pdqsort(collection.begin(), collection.end(),
+                                              std::less<>{}, cppsort::utility::identity{}, 4);
+            CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        };
+        check_distribution(dist::shuffled{});
+        check_distribution(dist::shuffled_16_values{});
+        check_distribution(dist::all_equal{});
+        check_distribution(dist::descending{});
+        check_distribution(dist::pipe_organ{});
+        check_distribution(dist::median_of_3_killer{});
+    }
+
+    SECTION( "several threads with a projection" )
+    {
+        std::vector<generic_wrapper<long long int>> wrappers;
+        wrappers.reserve(500'000);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(wrappers), 500'000);
+        cppsort::detail::parallel_pdqsort(wrappers.begin(), wrappers.end(), std::greater<>{},
+                                          &generic_wrapper<long long int>::value, 4);
+        CHECK( helpers::is_sorted(wrappers.begin(), wrappers.end(), std::greater<>{},
+                                  &generic_wrapper<long long int>::value) );
+    }
+
+    SECTION( "exceptions are propagated to the caller" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 500'000);
+        auto throwing_compare = [](long long int lhs, long long int rhs) {
+            if (lhs == 1234 || rhs == 1234) {
+                throw std::runtime_error("comparison failure");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS(
+            cppsort::detail::parallel_pdqsort(collection.begin(), collection.end(),
+                                              throwing_compare, cppsort::utility::identity{}, 4),
+            std::runtime_error
+        );
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/ska_sort.h>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "parallel_ska_sorter tests", "[parallel_ska_sorter]" )
+{
+    // The generic tests use collections too small to reach the
+    // parallel code path, and the machine running the tests might
+    // not have more than one hardware thread, so the algorithm is
+    // also called directly with an explicit number of threads
+
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), 300'000, -100'000);
+        cppsort::parallel_ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "different numbers of threads" )
+    {
+        for (std::size_t nb_threads: { 2, 3, 4, 9, 40 }) {
+            std::vector<long long int> vec;
+            distribution(std::back_inserter(vec), 300'000, -100'000);
+            cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                               cppsort::utility::identity{}, nb_threads);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        }
+    }
+
+    SECTION( "skewed distributions" )
+    {
+        auto check_distribution = [](auto distribution) {
+            std::vector<unsigned> vec;
+            distribution(std::back_inserter(vec), 300'000);
+            cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                               cppsort::utility::identity{}, 4);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        };
+        check_distribution(dist::shuffled_16_values{});
+        check_distribution(dist::all_equal{});
+        check_distribution(dist::descending{});
+        check_distribution(dist::pipe_organ{});
+    }
+
+    SECTION( "sort with double iterable" )
+    {
+        std::vector<double> vec;
+        distribution.call<double>(std::back_inserter(vec), 300'000, -100'000);
+        cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                           cppsort::utility::identity{}, 4);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < 200'000 ; ++i) {
+            vec.push_back(std::to_string(i % 50'000));
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                           cppsort::utility::identity{}, 4);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with std::tuple" )
+    {
+        std::vector<std::tuple<std::uint16_t, int>> vec;
+        for (int i = 0 ; i < 300'000 ; ++i) {
+            vec.emplace_back(hasard::engine()() % 4, i % 1000 - 500);
+        }
+        cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                           cppsort::utility::identity{}, 4);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with a projection" )
+    {
+        std::vector<generic_wrapper<int>> vec;
+        distribution(std::back_inserter(vec), 300'000, -100'000);
+        cppsort::detail::parallel_ska_sort(vec.begin(), vec.end(),
+                                           &generic_wrapper<int>::value, 4);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(), std::less<>{},
+                                  &generic_wrapper<int>::value) );
+    }
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/config.h>
+#include <cpp-sort/detail/parallel_quickselect.h>
+#include <cpp-sort/sorters/nth_element_sorter.h>
+#include <cpp-sort/sorters/partial_sorter.h>
+#include <cpp-sort/sorters/top_k_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+#if CPPSORT_EXECUTION_POLICIES
+#   include <execution>
+#endif
+
+namespace
+{
+    // Checks that collection is a permutation of original where
+    // the first k elements are the k smallest ones of original,
+    // in sorted order
+    template<typename T, typename Compare=std::less<>>
+    auto is_partially_sorted(std::vector<T> collection, std::vector<T> original,
+                             int k, Compare compare={})
+        -> bool
+    {
+        std::sort(original.begin(), original.end(), compare);
+        if (not std::equal(collection.begin(), collection.begin() + k, original.begin())) {
+            return false;
+        }
+        std::sort(collection.begin(), collection.end(), compare);
+        return collection == original;
+    }
+
+    // Checks that the element at position nth is the one that
+    // would be there if collection was sorted, and that the
+    // elements are partitioned around it
+    template<typename T, typename Compare=std::less<>>
+    auto is_nth_element(std::vector<T> collection, std::vector<T> original,
+                        int nth, Compare compare={})
+        -> bool
+    {
+        std::sort(original.begin(), original.end(), compare);
+        auto pivot = collection[nth];
+        if (pivot != original[nth]) {
+            return false;
+        }
+        for (int idx = 0 ; idx < nth ; ++idx) {
+            if (compare(pivot, collection[idx])) return false;
+        }
+        for (int idx = nth + 1 ; idx < static_cast<int>(collection.size()) ; ++idx) {
+            if (compare(collection[idx], pivot)) return false;
+        }
+        std::sort(collection.begin(), collection.end(), compare);
+        return collection == original;
+    }
+}
+
+TEST_CASE( "selection sorters", "[nth_element_sorter][partial_sorter][top_k_sorter]" )
+{
+    auto check_distribution = [](auto distribution, int size) {
+        std::vector<int> original;
+        distribution(std::back_inserter(original), size);
+
+        for (int k: { 0, 1, 2, size / 10, size / 2, size - 1 }) {
+            auto collection = original;
+            auto it = cppsort::nth_element_sorter(k)(collection);
+            CHECK( it == collection.begin() + k );
+            CHECK( is_nth_element(collection, original, k) );
+
+            collection = original;
+            it = cppsort::partial_sorter(k)(collection);
+            CHECK( it == collection.begin() + k );
+            CHECK( is_partially_sorted(collection, original, k) );
+
+            collection = original;
+            it = cppsort::top_k_sorter(k)(collection);
+            CHECK( it == collection.begin() + k );
+            CHECK( is_partially_sorted(collection, original, k) );
+        }
+    };
+
+    SECTION( "random-access iterators" )
+    {
+        for (int size: { 10, 100, 10'000 }) {
+            check_distribution(dist::shuffled{}, size);
+            check_distribution(dist::shuffled_16_values{}, size);
+            check_distribution(dist::all_equal{}, size);
+            check_distribution(dist::ascending{}, size);
+            check_distribution(dist::descending{}, size);
+            check_distribution(dist::pipe_organ{}, size);
+            check_distribution(dist::push_front{}, size);
+            check_distribution(dist::median_of_3_killer{}, size);
+        }
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        std::vector<generic_wrapper<int>> original;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(original), 1'000);
+        auto sorted = original;
+        std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.value > rhs.value;
+        });
+
+        auto collection = original;
+        auto it = cppsort::nth_element_sorter(300)(collection, std::greater<>{},
+                                                   &generic_wrapper<int>::value);
+        CHECK( it->value == sorted[300].value );
+
+        collection = original;
+        it = cppsort::partial_sorter(300)(collection, std::greater<>{},
+                                          &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(collection.begin(), it, std::greater<>{},
+                                  &generic_wrapper<int>::value) );
+        CHECK( std::prev(it)->value == sorted[299].value );
+
+        collection = original;
+        it = cppsort::top_k_sorter(300)(collection, std::greater<>{},
+                                        &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(collection.begin(), it, std::greater<>{},
+                                  &generic_wrapper<int>::value) );
+        CHECK( std::prev(it)->value == sorted[299].value );
+    }
+
+    SECTION( "out of range positions" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100);
+        auto original = collection;
+
+        CHECK( cppsort::nth_element_sorter(100)(collection) == collection.end() );
+        CHECK( cppsort::nth_element_sorter(-1)(collection) == collection.end() );
+        CHECK( collection == original );
+
+        CHECK( cppsort::partial_sorter(-1)(collection) == collection.begin() );
+        CHECK( cppsort::top_k_sorter(-1)(collection) == collection.begin() );
+        CHECK( collection == original );
+
+        CHECK( cppsort::partial_sorter(1'000)(collection) == collection.end() );
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        collection = original;
+        CHECK( cppsort::top_k_sorter(1'000)(collection) == collection.end() );
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "forward iterators" )
+    {
+        std::vector<int> original;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(original), 1'000);
+        auto sorted = original;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::list<int> collection(original.begin(), original.end());
+        auto it = cppsort::nth_element_sorter(500)(collection);
+        CHECK( *it == sorted[500] );
+
+        collection.assign(original.begin(), original.end());
+        it = cppsort::partial_sorter(500)(collection.begin(), collection.end());
+        CHECK( std::distance(collection.begin(), it) == 500 );
+        CHECK( std::equal(collection.begin(), it, sorted.begin()) );
+    }
+
+    SECTION( "top_k_sorter streaming interface" )
+    {
+        std::vector<int> original;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(original), 1'000);
+        auto sorted = original;
+        std::sort(sorted.begin(), sorted.end());
+
+        // Single-pass input read from a stream
+        std::ostringstream oss;
+        for (int value: original) {
+            oss << value << ' ';
+        }
+        for (int k: { 0, 1, 10, 500, 1'000, 2'000 }) {
+            std::istringstream iss(oss.str());
+            std::vector<int> res;
+            cppsort::top_k_sorter(k).copy(std::istream_iterator<int>(iss), std::istream_iterator<int>(),
+                                          std::back_inserter(res));
+            auto expected_size = (std::min)(k, 1'000);
+            CHECK( res.size() == static_cast<std::size_t>(expected_size) );
+            CHECK( std::equal(res.begin(), res.end(), sorted.begin()) );
+        }
+
+        // The input collection is left untouched
+        std::list<generic_wrapper<int>> collection(original.begin(), original.end());
+        std::vector<generic_wrapper<int>> res(20);
+        auto it = cppsort::top_k_sorter(20).copy(collection, res.begin(), std::greater<>{},
+                                                 &generic_wrapper<int>::value);
+        CHECK( it == res.end() );
+        CHECK( std::equal(collection.begin(), collection.end(), original.begin(),
+                          [](const auto& lhs, int rhs) { return lhs.value == rhs; }) );
+        CHECK( std::equal(res.begin(), res.end(), sorted.rbegin(),
+                          [](const auto& lhs, int rhs) { return lhs.value == rhs; }) );
+    }
+}
+
+TEST_CASE( "parallel selection", "[nth_element_sorter][partial_sorter]" )
+{
+    // The generic tests use collections too small to reach the
+    // parallel code path, and the machine running the tests might
+    // not have more than one hardware thread, so the algorithm is
+    // also called directly with an explicit number of threads
+
+    auto check_distribution = [](auto distribution) {
+        std::vector<long long int> original;
+        distribution(std::back_inserter(original), 300'000);
+
+        for (int nb_threads: { 2, 3, 4 }) {
+            for (int nth: { 0, 1'000, 150'000, 299'999 }) {
+                auto collection = original;
+                cppsort::detail::parallel_quickselect(collection.begin(), collection.end(),
+                                                      collection.begin() + nth,
+                                                      std::less<>{}, cppsort::utility::identity{},
+                                                      nb_threads);
+                CHECK( is_nth_element(collection, original, nth) );
+            }
+        }
+    };
+
+    SECTION( "several threads with different distributions" )
+    {
+        check_distribution(dist::shuffled{});
+        check_distribution(dist::shuffled_16_values{});
+        check_distribution(dist::all_equal{});
+        check_distribution(dist::ascending{});
+        check_distribution(dist::descending{});
+        check_distribution(dist::pipe_organ{});
+        check_distribution(dist::median_of_3_killer{});
+    }
+
+    SECTION( "structured inputs with more threads" )
+    {
+        // Chunks that are entirely on one side of the partition point
+        // once partitioned are common with such inputs
+        auto check = [](auto distribution) {
+            std::vector<long long int> original;
+            distribution(std::back_inserter(original), 1 << 18);
+
+            for (int nb_threads: { 4, 5, 8 }) {
+                for (int nth: { 0, 5'000, 100'000, 131'072, 200'000, (1 << 18) - 1 }) {
+                    auto collection = original;
+                    cppsort::detail::parallel_quickselect(collection.begin(), collection.end(),
+                                                          collection.begin() + nth,
+                                                          std::less<>{}, cppsort::utility::identity{},
+                                                          nb_threads);
+                    CHECK( is_nth_element(collection, original, nth) );
+                }
+            }
+        };
+
+        check(dist::ascending_sawtooth{});
+        check(dist::descending_sawtooth{});
+        check(dist::pipe_organ{});
+        check(dist::shuffled_16_values{});
+        check(dist::ascending_duplicates{});
+        check(dist::descending_plateau{});
+    }
+
+    SECTION( "several threads with a projection" )
+    {
+        std::vector<generic_wrapper<long long int>> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 300'000);
+        auto nth = collection.begin() + 100'000;
+        cppsort::detail::parallel_quickselect(collection.begin(), collection.end(), nth,
+                                              std::greater<>{},
+                                              &generic_wrapper<long long int>::value, 4);
+        CHECK( nth->value == 300'000 - 100'001 );
+        CHECK( std::all_of(collection.begin(), nth, [&](const auto& wrapper) {
+            return wrapper.value >= nth->value;
+        }) );
+        CHECK( std::all_of(nth, collection.end(), [&](const auto& wrapper) {
+            return wrapper.value <= nth->value;
+        }) );
+    }
+
+#if CPPSORT_EXECUTION_POLICIES
+    SECTION( "execution policies" )
+    {
+        std::vector<long long int> original;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(original), 300'000);
+
+        auto collection = original;
+        auto it = cppsort::nth_element_sorter(200'000)(std::execution::par, collection);
+        CHECK( it == collection.begin() + 200'000 );
+        CHECK( is_nth_element(collection, original, 200'000) );
+
+        collection = original;
+        it = cppsort::partial_sorter(50'000)(std::execution::par, collection);
+        CHECK( it == collection.begin() + 50'000 );
+        CHECK( is_partially_sorted(collection, original, 50'000) );
+
+        collection = original;
+        it = cppsort::partial_sorter(50'000)(std::execution::seq, collection);
+        CHECK( is_partially_sorted(collection, original, 50'000) );
+
+        std::list<long long int> list(original.begin(), original.end());
+        auto list_it = cppsort::nth_element_sorter(1'000)(std::execution::par, list);
+        CHECK( *list_it == 1'000 );
+    }
+#endif
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/drop_merge_adapter.h>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/adapters/verge_adapter.h>
+#include <cpp-sort/detail/simd_adjacent_find.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/is_sorted.h>
+#include <testing-tools/distributions.h>
+
+TEMPLATE_TEST_CASE( "vectorized adjacent find", "[simd_adjacent_find]",
+                    int, unsigned int, long long int, unsigned long long int, float, double )
+{
+    using cppsort::detail::adjacent_ascent;
+    using cppsort::detail::adjacent_descent;
+    using cppsort::detail::adjacent_non_descent;
+
+    // Sizes around the boundaries of AVX2 and AVX-512 registers
+    // make sure that every code path of the kernels is exercised
+    auto check_relation = [](const std::vector<TestType>& collection, auto relation) {
+        // Comparison that isn't recognized by the kernels
+        auto compare = [](TestType lhs, TestType rhs) { return lhs < rhs; };
+        cppsort::utility::identity projection;
+
+        for (std::size_t size : { 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000 }) {
+            const TestType* first = collection.data();
+            const TestType* last = first + size;
+            CHECK( cppsort::detail::simd_find_adjacent_pair(first, last, relation) ==
+                   cppsort::detail::scalar_find_adjacent_pair(first, last, relation, compare, projection) );
+            CHECK( cppsort::detail::simd_find_last_adjacent_pair(first, last, relation) ==
+                   cppsort::detail::scalar_find_last_adjacent_pair(first, last, relation, compare, projection) );
+            CHECK( cppsort::detail::simd_count_adjacent_pairs(first, last, relation) ==
+                   cppsort::detail::scalar_count_adjacent_pairs(first, last, relation, compare, projection) );
+        }
+    };
+
+    auto check_distribution = [&](auto distribution) {
+        std::vector<TestType> collection;
+        distribution.template call<TestType>(std::back_inserter(collection), 1000);
+        check_relation(collection, adjacent_descent{});
+        check_relation(collection, adjacent_ascent{});
+        check_relation(collection, adjacent_non_descent{});
+    };
+
+    check_distribution(dist::shuffled{});
+    check_distribution(dist::shuffled_16_values{});
+    check_distribution(dist::all_equal{});
+    check_distribution(dist::ascending{});
+    check_distribution(dist::descending{});
+    check_distribution(dist::ascending_sawtooth{});
+}
+
+TEMPLATE_TEST_CASE( "adapters and probes with vectorized scans", "[simd_adjacent_find]",
+                    int, unsigned int, long long int, unsigned long long int, float, double )
+{
+    std::vector<TestType> collection;
+    collection.reserve(100'000);
+
+    auto check_distribution = [&](auto distribution) {
+        collection.clear();
+        distribution.template call<TestType>(std::back_inserter(collection), 100'000);
+
+        auto compare = [](TestType lhs, TestType rhs) { return lhs < rhs; };
+        CHECK( cppsort::probe::runs(collection) == cppsort::probe::runs(collection, compare) );
+        CHECK( cppsort::probe::mono(collection) == cppsort::probe::mono(collection, compare) );
+        CHECK( cppsort::utility::is_sorted_until(collection) ==
+               cppsort::utility::is_sorted_until(collection, compare) );
+        CHECK( cppsort::utility::is_sorted(collection) ==
+               std::is_sorted(collection.begin(), collection.end()) );
+
+        auto copy = collection;
+        cppsort::verge_adapter<cppsort::pdq_sorter>{}(copy);
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+        copy = collection;
+        cppsort::stable_adapter<cppsort::verge_adapter<cppsort::pdq_sorter>>{}(copy);
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+
+        copy = collection;
+        cppsort::drop_merge_adapter<cppsort::pdq_sorter>{}(copy);
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+    };
+    check_distribution(dist::ascending{});
+    check_distribution(dist::descending{});
+    check_distribution(dist::pipe_organ{});
+    check_distribution(dist::push_middle{});
+    check_distribution(dist::ascending_sawtooth{});
+    check_distribution(dist::descending_sawtooth{});
+    check_distribution(dist::shuffled_16_values{});
+    check_distribution(dist::alternating{});
+}
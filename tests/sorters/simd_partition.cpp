@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/simd_partition.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/quick_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEMPLATE_TEST_CASE( "vectorized partition", "[simd_partition]",
+                    int, unsigned int, long long int, unsigned long long int, float, double )
+{
+    // Sizes around the boundaries of AVX2 and AVX-512 registers
+    // make sure that every code path of the kernels is exercised
+    auto check_partition = [](std::vector<TestType> collection, auto pred) {
+        for (std::size_t size : { 0, 1, 7, 15, 16, 17, 31, 32, 33, 48, 63, 64, 65, 100, 1000 }) {
+            std::vector<TestType> values(collection.begin(), collection.begin() + size);
+            TestType pivot = size == 0 ? TestType(0) : values[size / 2];
+            auto expected = values;
+            auto middle = cppsort::detail::simd_partition(values.data(), values.data() + size, pivot, pred);
+            for (auto it = values.data() ; it != middle ; ++it) {
+                CHECK( cppsort::detail::simd_scalar_predicate(*it, pivot, pred) );
+            }
+            for (auto it = middle ; it != values.data() + size ; ++it) {
+                CHECK_FALSE( cppsort::detail::simd_scalar_predicate(*it, pivot, pred) );
+            }
+            std::sort(values.begin(), values.end());
+            std::sort(expected.begin(), expected.end());
+            CHECK( values == expected );
+        }
+    };
+
+    std::vector<TestType> collection;
+    collection.reserve(1000);
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 1000);
+        check_partition(collection, cppsort::detail::simd_less_than{});
+        check_partition(collection, cppsort::detail::simd_not_greater{});
+    }
+
+    SECTION( "shuffled_16_values distribution" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        distribution.call<TestType>(std::back_inserter(collection), 1000);
+        check_partition(collection, cppsort::detail::simd_less_than{});
+        check_partition(collection, cppsort::detail::simd_not_greater{});
+    }
+}
+
+TEMPLATE_TEST_CASE( "pdq_sorter and quick_sorter with vectorized partitions", "[simd_partition]",
+                    int, unsigned int, long long int, unsigned long long int, float, double )
+{
+    std::vector<TestType> collection;
+    collection.reserve(100'000);
+
+    auto check_sorters = [&](auto distribution) {
+        collection.clear();
+        distribution.template call<TestType>(std::back_inserter(collection), 100'000);
+        auto copy = collection;
+        cppsort::pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        cppsort::quick_sort(copy, std::less<TestType>{});
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+    };
+    check_sorters(dist::shuffled{});
+    check_sorters(dist::shuffled_16_values{});
+    check_sorters(dist::all_equal{});
+    check_sorters(dist::descending{});
+    check_sorters(dist::pipe_organ{});
+    check_sorters(dist::median_of_3_killer{});
+}
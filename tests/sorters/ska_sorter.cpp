@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022 Morwenn
+ * Copyright (c) 2017-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #include <algorithm>
@@ -87,6 +87,110 @@ TEST_CASE( "ska_sorter tests", "[ska_sorter]" )
     }
 }
 
+namespace
+{
+    struct record
+    {
+        std::uint32_t tenant;
+        std::int64_t timestamp;
+        std::string id;
+    };
+
+    auto to_radix_sort_key(const record& rec)
+    {
+        return std::tie(rec.tenant, rec.timestamp, rec.id);
+    }
+
+    auto make_records(int size)
+        -> std::vector<record>
+    {
+        // Few different values per field so that the
+        // less significant fields matter
+        std::vector<record> res;
+        for (int i = 0 ; i < size ; ++i) {
+            res.push_back({
+                static_cast<std::uint32_t>(hasard::engine()() % 8),
+                static_cast<std::int64_t>(hasard::engine()() % 1'000) - 500,
+                std::to_string(hasard::engine()() % 97)
+            });
+        }
+        return res;
+    }
+
+    auto is_sorted_records(const std::vector<record>& vec)
+        -> bool
+    {
+        return std::is_sorted(vec.begin(), vec.end(), [](const record& lhs, const record& rhs) {
+            return to_radix_sort_key(lhs) < to_radix_sort_key(rhs);
+        });
+    }
+}
+
+TEST_CASE( "ska_sorter tests with composite keys", "[ska_sorter][projection]" )
+{
+    SECTION( "to_radix_sort_key customization point" )
+    {
+        for (int size: { 100, 1'000, 100'000 }) {
+            auto vec = make_records(size);
+            cppsort::ska_sort(vec);
+            CHECK( is_sorted_records(vec) );
+        }
+    }
+
+    SECTION( "projection returning a tuple of references" )
+    {
+        auto vec = make_records(100'000);
+        cppsort::ska_sort(vec, [](const record& rec) {
+            return std::tie(rec.tenant, rec.timestamp, rec.id);
+        });
+        CHECK( is_sorted_records(vec) );
+    }
+
+    SECTION( "projection returning a tuple of values" )
+    {
+        auto vec = make_records(100'000);
+        cppsort::ska_sort(vec, [](const record& rec) {
+            return std::make_tuple(rec.tenant, rec.timestamp, rec.id);
+        });
+        CHECK( is_sorted_records(vec) );
+    }
+
+    SECTION( "projection returning a custom key" )
+    {
+        // record has no operator<, the projection is checked
+        // against the order of the radix sort instead
+        std::vector<std::pair<int, record>> vec;
+        for (auto& rec: make_records(10'000)) {
+            vec.emplace_back(0, std::move(rec));
+        }
+        cppsort::ska_sort(vec, &std::pair<int, record>::second);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return to_radix_sort_key(lhs.second) < to_radix_sort_key(rhs.second);
+        }) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::ska_sort(vec.begin(), vec.end(), [](const auto& elem) -> const record& {
+            return elem.second;
+        });
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return to_radix_sort_key(lhs.second) < to_radix_sort_key(rhs.second);
+        }) );
+    }
+
+    SECTION( "key nested in a pair" )
+    {
+        std::vector<std::pair<int, record>> vec;
+        for (auto& rec: make_records(10'000)) {
+            vec.emplace_back(static_cast<int>(rec.tenant % 2), std::move(rec));
+        }
+        cppsort::ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return std::tie(lhs.first, lhs.second.tenant, lhs.second.timestamp, lhs.second.id)
+                 < std::tie(rhs.first, rhs.second.tenant, rhs.second.timestamp, rhs.second.id);
+        }) );
+    }
+}
+
 namespace
 {
     template<typename T>
@@ -159,4 +263,12 @@ TEST_CASE( "is_ska_sortable", "[ska_sorter]" )
         STATIC_CHECK( is_ska_sortable<std::tuple<long int, int, std::string, std::vector<unsigned long long>>> );
         STATIC_CHECK_FALSE( is_ska_sortable<std::tuple<std::string, std::vector<unsigned long long>, std::deque<long double>>> );
     }
+
+    SECTION( "types with a radix sort key" )
+    {
+        STATIC_CHECK( is_ska_sortable<record> );
+        STATIC_CHECK( is_ska_sortable<std::tuple<const int&, const std::string&>> );
+        STATIC_CHECK( is_ska_sortable<std::pair<int, record>> );
+        STATIC_CHECK( is_ska_sortable<std::vector<record>> );
+    }
 }
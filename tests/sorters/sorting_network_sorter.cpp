@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    // The vectorized networks are expected to give exactly the
+    // same results as the scalar ones, which are called directly
+    // through their implementation to avoid the dispatch
+
+    template<std::size_t N, typename T, typename Compare>
+    auto check_network(const std::vector<T>& collection, Compare compare)
+        -> void
+    {
+        std::vector<T> expected(collection.begin(), collection.begin() + N);
+        std::vector<T> result = expected;
+        cppsort::detail::sorting_network_sorter_impl<N>{}(expected.begin(), expected.end(), compare);
+        cppsort::sorting_network_sorter<N>{}(result.begin(), result.end(), compare);
+        for (std::size_t idx = 0 ; idx < N ; ++idx) {
+            // Compare the representations to handle NaN and signed zeros
+            CHECK( std::memcmp(&result[idx], &expected[idx], sizeof(T)) == 0 );
+        }
+    }
+
+    template<typename T, typename Compare, std::size_t... Indices>
+    auto check_networks(const std::vector<T>& collection, Compare compare,
+                        std::index_sequence<Indices...>)
+        -> void
+    {
+        using expander = int[];
+        (void) expander{ 0, (check_network<Indices>(collection, compare), 0)... };
+    }
+
+    template<typename T, typename Compare=std::less<>>
+    auto check_every_network(const std::vector<T>& collection, Compare compare={})
+        -> void
+    {
+        // Sizes around the boundaries of AVX2 and AVX-512 registers,
+        // checking every size would make the test too slow to build
+        check_networks(collection, compare, std::index_sequence<
+            2, 7, 8, 9, 13, 15, 16, 17, 24, 31, 32, 33, 47, 48, 63, 64
+        >{});
+    }
+}
+
+TEMPLATE_TEST_CASE( "vectorized sorting_network_sorter", "[sorting_network_sorter]",
+                    int, unsigned int, long long int, unsigned long long int, float, double )
+{
+    std::vector<TestType> collection;
+
+    SECTION( "shuffled distribution" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 64, 10);
+        check_every_network(collection);
+        check_every_network(collection, std::less<TestType>{});
+    }
+
+    SECTION( "shuffled_16_values distribution" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        distribution.call<TestType>(std::back_inserter(collection), 64);
+        check_every_network(collection);
+    }
+
+    SECTION( "extreme values" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 64);
+        collection[3] = std::numeric_limits<TestType>::max();
+        collection[9] = std::numeric_limits<TestType>::lowest();
+        collection[17] = std::numeric_limits<TestType>::max();
+        collection[42] = std::numeric_limits<TestType>::lowest();
+        check_every_network(collection);
+    }
+
+    SECTION( "non-vectorized comparison" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 64);
+        check_every_network(collection, std::greater<>{});
+    }
+}
+
+TEMPLATE_TEST_CASE( "vectorized sorting_network_sorter with special floating point values",
+                    "[sorting_network_sorter]",
+                    float, double )
+{
+    std::vector<TestType> collection;
+    auto distribution = dist::shuffled{};
+    distribution.call<TestType>(std::back_inserter(collection), 64, -32);
+    collection[1] = std::numeric_limits<TestType>::infinity();
+    collection[5] = -std::numeric_limits<TestType>::infinity();
+    collection[8] = TestType(0.0);
+    collection[11] = TestType(-0.0);
+    collection[19] = std::numeric_limits<TestType>::quiet_NaN();
+    collection[33] = -std::numeric_limits<TestType>::quiet_NaN();
+    check_every_network(collection);
+}
@@ -1,13 +1,20 @@
 /*
- * Copyright (c) 2015-2022 Morwenn
+ * Copyright (c) 2015-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <random>
 #include <string>
+#include <utility>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/comparators/total_less.h>
 #include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/sorters/spread_sorter/float_spread_sorter.h>
 #include <testing-tools/distributions.h>
 #include <testing-tools/random.h>
 
@@ -79,3 +86,98 @@ TEST_CASE( "spread_sorter tests", "[spread_sorter]" )
         CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
     }
 }
+
+TEST_CASE( "float_spread_sorter tests", "[spread_sorter][float_spread_sorter]" )
+{
+    // The sizes are chosen to exercise the small collections sorted
+    // with spreadsort, and every digit size of the LSD radix sort
+
+    auto make_collection = [](auto value, int size) {
+        using float_type = decltype(value);
+        std::uniform_real_distribution<float_type> dist(-1.0e6, 1.0e6);
+        std::vector<float_type> res;
+        res.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            res.push_back(dist(hasard::engine()));
+        }
+        // Add some special values
+        for (int i = 0 ; i < size ; i += 97) {
+            res[i] = (i / 97) % 2 ? float_type(0.0) : float_type(-0.0);
+        }
+        for (int i = 13 ; i < size ; i += 1009) {
+            res[i] = (i / 1009) % 2 ?
+                std::numeric_limits<float_type>::infinity() :
+                -std::numeric_limits<float_type>::infinity();
+        }
+        return res;
+    };
+
+    auto add_nans = [](auto& collection) {
+        using float_type = typename std::decay_t<decltype(collection)>::value_type;
+        for (std::size_t i = 5 ; i < collection.size() ; i += 101) {
+            collection[i] = (i / 101) % 2 ?
+                std::numeric_limits<float_type>::quiet_NaN() :
+                -std::numeric_limits<float_type>::quiet_NaN();
+        }
+    };
+
+    SECTION( "sort float with std::less" )
+    {
+        for (int size: { 500, 5'000, 500'000, 5'000'000 }) {
+            auto vec = make_collection(0.0f, size);
+            cppsort::float_spread_sort(vec);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        }
+    }
+
+    SECTION( "sort double with std::less" )
+    {
+        for (int size: { 500, 10'000, 100'000, 3'000'000 }) {
+            auto vec = make_collection(0.0, size);
+            cppsort::float_spread_sort(vec.begin(), vec.end(), std::less<>{});
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        }
+    }
+
+    SECTION( "sort float with total_less" )
+    {
+        for (int size: { 500, 5'000, 500'000 }) {
+            auto vec = make_collection(0.0f, size);
+            add_nans(vec);
+            cppsort::float_spread_sort(vec, cppsort::total_less);
+            CHECK( std::is_sorted(vec.begin(), vec.end(), cppsort::total_less) );
+            CHECK( std::signbit(vec.front()) );
+            CHECK( std::isnan(vec.front()) );
+            CHECK( std::isnan(vec.back()) );
+        }
+    }
+
+    SECTION( "sort double with total_less" )
+    {
+        for (int size: { 500, 10'000, 100'000 }) {
+            auto vec = make_collection(0.0, size);
+            add_nans(vec);
+            cppsort::spread_sort(vec.begin(), vec.end(), cppsort::total_less);
+            CHECK( std::is_sorted(vec.begin(), vec.end(), cppsort::total_less) );
+        }
+    }
+
+    SECTION( "sort with projection" )
+    {
+        auto values = make_collection(0.0, 100'000);
+        std::vector<std::pair<int, double>> vec;
+        for (auto value: values) {
+            vec.emplace_back(0, value);
+        }
+        cppsort::float_spread_sort(vec, &std::pair<int, double>::second);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second < rhs.second;
+        }) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::float_spread_sort(vec, cppsort::total_less, &std::pair<int, double>::second);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](const auto& lhs, const auto& rhs) {
+            return cppsort::total_less(lhs.second, rhs.second);
+        }) );
+    }
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    template<typename Distribution>
+    auto make_collection(Distribution distribution, int size)
+        -> std::vector<int>
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), size);
+        return vec;
+    }
+}
+
+TEST_CASE( "configurable_tim_sorter tuning", "[tim_sorter]" )
+{
+    std::vector<std::vector<int>> collections = {
+        make_collection(dist::shuffled{}, 10'000),
+        make_collection(dist::shuffled_16_values{}, 10'000),
+        make_collection(dist::ascending_sawtooth{}, 10'000),
+        make_collection(dist::descending_sawtooth{}, 10'000),
+        make_collection(dist::pipe_organ{}, 10'000),
+        make_collection(dist::push_middle{}, 10'000),
+        make_collection(dist::alternating{}, 10'000),
+        make_collection(dist::shuffled{}, 20),
+    };
+
+    SECTION( "default configuration" )
+    {
+        cppsort::configurable_tim_sorter sorter;
+        for (auto vec: collections) {
+            sorter(vec, std::greater<>{});
+            CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+        }
+    }
+
+    SECTION( "every policy and unusual parameters" )
+    {
+        for (auto policy: { cppsort::tim_sorter_policy::classic,
+                            cppsort::tim_sorter_policy::adaptive_shivers,
+                            cppsort::tim_sorter_policy::powersort }) {
+            cppsort::tim_sorter_config configs[5];
+            configs[0].policy = policy;
+            configs[1].policy = policy;
+            configs[1].min_run = 1;
+            configs[1].max_run = 2;
+            configs[1].min_gallop = 1;
+            configs[2].policy = policy;
+            configs[2].min_run = 100;
+            configs[2].max_run = 150;
+            configs[2].min_gallop = 1000;
+            // Out-of-range parameters are clamped
+            configs[3].policy = policy;
+            configs[3].min_run = 0;
+            configs[3].max_run = 0;
+            configs[3].min_gallop = 0;
+            configs[4].policy = policy;
+            configs[4].min_run = 80;
+            configs[4].max_run = -10;
+            configs[4].min_gallop = -1;
+
+            for (const auto& config: configs) {
+                cppsort::configurable_tim_sorter sorter(config);
+                for (auto vec: collections) {
+                    sorter(vec, std::negate<>{});
+                    CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "tim_sorter galloping threshold", "[tim_sorter]" )
+{
+    // Runs whose elements perfectly alternate when merged, galloping
+    // mode never pays off; the threshold adapted by a merge is carried
+    // over to the next one and must not drop to 1, otherwise galloping
+    // mode is entered at the start of most merges
+    constexpr int nb_runs = 2048;
+    constexpr int run_size = 32;
+    std::vector<int> vec;
+    for (int i = 0 ; i < nb_runs ; ++i) {
+        for (int j = 0 ; j < run_size ; ++j) {
+            vec.push_back(j * nb_runs + i);
+        }
+    }
+    auto copy = vec;
+
+    // The default configuration is that of tim_sorter
+    cppsort::tim_sorter_stats stats;
+    cppsort::tim_sorter_config config;
+    config.stats = &stats;
+    cppsort::configurable_tim_sorter sorter(config);
+    long long int count = 0;
+    sorter(vec, [&count](int lhs, int rhs) {
+        ++count;
+        return lhs < rhs;
+    });
+    CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    CHECK( stats.merges == nb_runs - 1 );
+    CHECK( stats.gallop_entries < stats.merges / 2 );
+
+    long long int tim_sort_count = 0;
+    cppsort::tim_sort(copy, [&tim_sort_count](int lhs, int rhs) {
+        ++tim_sort_count;
+        return lhs < rhs;
+    });
+    CHECK( copy == vec );
+    CHECK( tim_sort_count == count );
+}
+
+TEST_CASE( "configurable_tim_sorter statistics", "[tim_sorter]" )
+{
+    cppsort::tim_sorter_stats stats;
+    cppsort::tim_sorter_config config;
+    config.stats = &stats;
+    cppsort::configurable_tim_sorter sorter(config);
+
+    SECTION( "sorted collection" )
+    {
+        auto vec = make_collection(dist::ascending{}, 10'000);
+        sorter(vec);
+        CHECK( stats.runs == 1 );
+        CHECK( stats.merges == 0 );
+        CHECK( stats.gallop_entries == 0 );
+        CHECK( stats.galloped_elements == 0 );
+    }
+
+    SECTION( "two runs merged with galloping" )
+    {
+        // Interleaved blocks of 100 elements make every merge
+        // switch to galloping mode
+        std::vector<int> vec;
+        for (int i = 0 ; i < 50 ; ++i) {
+            for (int j = 0 ; j < 100 ; ++j) {
+                vec.push_back(i * 200 + j);
+            }
+        }
+        for (int i = 0 ; i < 50 ; ++i) {
+            for (int j = 0 ; j < 100 ; ++j) {
+                vec.push_back(i * 200 + 100 + j);
+            }
+        }
+        sorter(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( stats.runs == 2 );
+        CHECK( stats.merges == 1 );
+        CHECK( stats.gallop_entries > 0 );
+        CHECK( stats.galloped_elements > 0 );
+        CHECK( stats.galloped_elements <= 10'000 );
+    }
+
+    SECTION( "counters are accumulated" )
+    {
+        auto vec = make_collection(dist::ascending_sawtooth{}, 10'000);
+        auto copy = vec;
+        sorter(vec);
+        auto runs = stats.runs;
+        auto merges = stats.merges;
+        CHECK( runs > 1 );
+        CHECK( merges == runs - 1 );
+
+        sorter(copy);
+        CHECK( stats.runs == 2 * runs );
+        CHECK( stats.merges == 2 * merges );
+    }
+
+    SECTION( "gallop threshold" )
+    {
+        auto vec = make_collection(dist::ascending_sawtooth{}, 10'000);
+        auto copy = vec;
+        sorter(vec);
+        CHECK( stats.gallop_entries > 0 );
+
+        cppsort::tim_sorter_stats no_gallop_stats;
+        cppsort::tim_sorter_config no_gallop_config;
+        no_gallop_config.min_gallop = 1'000'000;
+        no_gallop_config.stats = &no_gallop_stats;
+        cppsort::configurable_tim_sorter no_gallop_sorter(no_gallop_config);
+        no_gallop_sorter(copy);
+        CHECK( copy == vec );
+        CHECK( no_gallop_stats.runs == stats.runs );
+        CHECK( no_gallop_stats.gallop_entries == 0 );
+    }
+}
+
+TEST_CASE( "configurable_tim_sorter powersort policy", "[tim_sorter]" )
+{
+    // Runs of random lengths, the situation where the merge
+    // policy makes the most difference
+    std::mt19937 engine(1);
+    std::vector<int> vec(100'000);
+    for (auto& value: vec) {
+        value = static_cast<int>(engine() % 1'000'000);
+    }
+    for (int idx = 0 ; idx < 100'000 ;) {
+        int len = (std::min)(static_cast<int>(engine() % 5'000 + 1), 100'000 - idx);
+        std::sort(vec.begin() + idx, vec.begin() + (idx + len));
+        idx += len;
+    }
+
+    auto count_comparisons = [&](cppsort::tim_sorter_policy policy, cppsort::tim_sorter_stats& stats) {
+        cppsort::tim_sorter_config config;
+        config.policy = policy;
+        config.stats = &stats;
+
+        long long count = 0;
+        auto copy = vec;
+        auto sorter = cppsort::configurable_tim_sorter(config);
+        sorter(copy, [&count](int lhs, int rhs) {
+            ++count;
+            return lhs < rhs;
+        });
+        CHECK( std::is_sorted(copy.begin(), copy.end()) );
+        return count;
+    };
+
+    cppsort::tim_sorter_stats classic_stats;
+    cppsort::tim_sorter_stats powersort_stats;
+    auto classic_count = count_comparisons(cppsort::tim_sorter_policy::classic, classic_stats);
+    auto powersort_count = count_comparisons(cppsort::tim_sorter_policy::powersort, powersort_stats);
+
+    CHECK( powersort_stats.runs == classic_stats.runs );
+    CHECK( powersort_stats.merges == powersort_stats.runs - 1 );
+    CHECK( powersort_count < classic_count );
+
+    // The policy can also be chosen at compile time
+    long long static_count = 0;
+    auto copy = vec;
+    cppsort::powersort_sort(copy, [&static_count](int lhs, int rhs) {
+        ++static_count;
+        return lhs < rhs;
+    });
+    CHECK( std::is_sorted(copy.begin(), copy.end()) );
+    CHECK( static_count == powersort_count );
+}
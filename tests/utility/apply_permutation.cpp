@@ -1,16 +1,20 @@
 /*
- * Copyright (c) 2022 Morwenn
+ * Copyright (c) 2022-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <numeric>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/sorters/poplar_sorter.h>
 #include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/parallel_apply_permutation.h>
 #include <cpp-sort/utility/sorted_indices.h>
 #include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
 
 TEST_CASE( "apply_permutation test", "[utility][apply_permutation]" )
 {
@@ -61,3 +65,82 @@ TEST_CASE( "apply_permutation test", "[utility][apply_permutation]" )
         CHECK( std::is_sorted(vec.begin(), vec.end()) );
     }
 }
+
+TEST_CASE( "apply_const_permutation test", "[utility][apply_permutation]" )
+{
+    SECTION( "simple case" )
+    {
+        std::vector<int> vec = { 6, 4, 2, 1, 8, 7, 0, 9, 5, 3 };
+        const std::vector<std::ptrdiff_t> indices = { 6, 3, 2, 9, 1, 8, 0, 5, 4, 7 };
+        auto indices_copy = indices;
+        cppsort::utility::apply_const_permutation(vec, indices);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( indices == indices_copy );
+    }
+
+    SECTION( "empty collection" )
+    {
+        std::vector<int> vec = {};
+        std::vector<std::ptrdiff_t> indices = {};
+        cppsort::utility::apply_const_permutation(vec, indices);
+        CHECK( vec.empty() );
+    }
+
+    SECTION( "reuse the permutation" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 1'000);
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(vec);
+        auto copy = vec;
+
+        cppsort::utility::apply_const_permutation(vec, indices);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        cppsort::utility::apply_const_permutation(copy, indices);
+        CHECK( copy == vec );
+    }
+}
+
+TEST_CASE( "parallel_apply_permutation test", "[utility][apply_permutation]" )
+{
+    // Big enough to exceed the threshold for the parallel algorithm
+    const std::ptrdiff_t size = 3'000'000;
+    std::vector<long long> vec(size);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    SECTION( "random permutation" )
+    {
+        std::vector<std::ptrdiff_t> indices(size);
+        std::iota(indices.begin(), indices.end(), 0);
+        std::shuffle(indices.begin(), indices.end(), hasard::engine());
+        auto indices_copy = indices;
+
+        cppsort::utility::parallel_apply_permutation(vec, indices, 4);
+        CHECK( indices == indices_copy );
+        CHECK( std::equal(vec.begin(), vec.end(), indices.begin()) );
+    }
+
+    SECTION( "many small cycles" )
+    {
+        std::vector<std::ptrdiff_t> indices(size);
+        for (std::ptrdiff_t idx = 0; idx < size; idx += 3) {
+            indices[idx] = idx + 2;
+            indices[idx + 1] = idx;
+            indices[idx + 2] = idx + 1;
+        }
+
+        cppsort::utility::parallel_apply_permutation(vec.begin(), vec.end(),
+                                                     indices.begin(), indices.end(), 4);
+        CHECK( std::equal(vec.begin(), vec.end(), indices.begin()) );
+    }
+
+    SECTION( "single thread" )
+    {
+        std::vector<std::ptrdiff_t> indices(size);
+        std::iota(indices.rbegin(), indices.rend(), 0);
+
+        cppsort::utility::parallel_apply_permutation(vec, indices, 1);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+}
@@ -1,10 +1,17 @@
 /*
- * Copyright (c) 2015-2022 Morwenn
+ * Copyright (c) 2015-2023 Morwenn
  * SPDX-License-Identifier: MIT
  */
+#include <algorithm>
+#include <iterator>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/block_sorter.h>
+#include <cpp-sort/sorters/grail_sorter.h>
+#include <cpp-sort/sorters/wiki_sorter.h>
 #include <cpp-sort/utility/buffer.h>
 #include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
 
 TEST_CASE( "miscellaneous tests for buffer providers",
            "[utility][buffer]" )
@@ -41,4 +48,76 @@ TEST_CASE( "miscellaneous tests for buffer providers",
         CHECK( buffer.end() == buffer.cend() );
         CHECK( buffer.end() == buffer.begin() + buffer.size() );
     }
+
+    SECTION( "cached_buffer" )
+    {
+        using provider = utility::cached_buffer<utility::sqrt>;
+        provider::release();
+        CHECK( provider::capacity() == 0 );
+
+        {
+            provider::buffer<int> buffer(25);
+            CHECK( buffer.size() == 5 );
+            CHECK( buffer.begin() == buffer.cbegin() );
+            CHECK( buffer.end() == buffer.cend() );
+            CHECK( buffer.end() == buffer.begin() + buffer.size() );
+        }
+        CHECK( provider::capacity() == 5 * sizeof(int) );
+
+        {
+            // The cache is reused and grows geometrically
+            provider::buffer<int> buffer(16);
+            CHECK( buffer.size() == 4 );
+        }
+        CHECK( provider::capacity() == 5 * sizeof(int) );
+        {
+            provider::buffer<int> buffer(36);
+            CHECK( buffer.size() == 6 );
+        }
+        CHECK( provider::capacity() == 10 * sizeof(int) );
+
+        {
+            // Nested buffers don't share memory
+            provider::buffer<int> buffer1(16);
+            provider::buffer<int> buffer2(16);
+            CHECK( buffer1.begin() != buffer2.begin() );
+        }
+
+        provider::release();
+        CHECK( provider::capacity() == 0 );
+    }
+}
+
+TEST_CASE( "buffered sorters with cached_buffer",
+           "[utility][buffer][block_sorter][grail_sorter][wiki_sorter]" )
+{
+    using namespace cppsort;
+    using provider = utility::cached_buffer<utility::half>;
+
+    std::vector<int> collection;
+    collection.reserve(1000);
+    auto distribution = dist::shuffled{};
+
+    block_sorter<provider> block_sort;
+    grail_sorter<provider> grail_sort;
+    wiki_sorter<provider> wiki_sort;
+
+    for (int i = 0; i < 3; ++i) {
+        collection.clear();
+        distribution(std::back_inserter(collection), 1000);
+        block_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+        collection.clear();
+        distribution(std::back_inserter(collection), 1000);
+        grail_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+        collection.clear();
+        distribution(std::back_inserter(collection), 1000);
+        wiki_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+    CHECK( provider::capacity() >= 500 * sizeof(int) );
+    provider::release();
 }
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/external_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "external_sorter test", "[utility][external_sorter]" )
+{
+    std::vector<int> collection;
+    collection.reserve(100'000);
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 100'000);
+
+    auto expected = collection;
+    std::sort(expected.begin(), expected.end());
+
+    SECTION( "everything fits in memory" )
+    {
+        cppsort::utility::external_sorter<cppsort::pdq_sorter> sorter;
+        std::vector<int> res;
+        sorter(collection, std::back_inserter(res));
+        CHECK( res == expected );
+    }
+
+    SECTION( "single merge pass" )
+    {
+        // 16 runs of 25 KiB
+        cppsort::utility::external_sorter<cppsort::pdq_sorter> sorter(25'000);
+        CHECK( sorter.memory_budget() == 25'000 );
+        std::vector<int> res(collection.size());
+        auto out = sorter(collection.begin(), collection.end(), res.begin());
+        CHECK( out == res.end() );
+        CHECK( res == expected );
+    }
+
+    SECTION( "several merge passes" )
+    {
+        // The budget is smaller than a block, which limits
+        // the merges to 2 runs at once
+        cppsort::utility::external_sorter<cppsort::pdq_sorter> sorter(1'000);
+        std::vector<int> res;
+        sorter(collection, std::back_inserter(res));
+        CHECK( res == expected );
+    }
+
+    SECTION( "with comparison and projection" )
+    {
+        cppsort::utility::external_sorter<cppsort::pdq_sorter> sorter(1'000);
+        std::vector<int> res;
+        sorter(collection, std::back_inserter(res), std::greater<>{},
+               [](int value) { return value / 2; });
+        CHECK( std::is_sorted(res.begin(), res.end(), [](int lhs, int rhs) {
+            return lhs / 2 > rhs / 2;
+        }) );
+        std::sort(res.begin(), res.end());
+        CHECK( res == expected );
+    }
+
+    SECTION( "empty collection" )
+    {
+        cppsort::utility::external_sorter<cppsort::pdq_sorter> sorter(1'000);
+        std::vector<int> empty;
+        std::vector<int> res;
+        sorter(empty, std::back_inserter(res));
+        CHECK( res.empty() );
+    }
+}
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int order;
+    };
+
+    auto operator==(const record& lhs, const record& rhs)
+        -> bool
+    {
+        return lhs.key == rhs.key && lhs.order == rhs.order;
+    }
+}
+
+TEST_CASE( "external_sorter stability", "[utility][external_sorter][is_stable]" )
+{
+    // With a stable sorter forming the runs, the merge
+    // keeps equivalent elements in their original order
+    std::vector<record> collection;
+    collection.reserve(50'000);
+    for (int idx = 0; idx < 50'000; ++idx) {
+        collection.push_back({ hasard::randint(0, 99, hasard::bit_gen()), idx });
+    }
+
+    cppsort::utility::external_sorter<cppsort::merge_sorter> sorter(4'000);
+    std::vector<record> res;
+    sorter(collection, std::back_inserter(res), std::less<>{}, &record::key);
+
+    auto expected = collection;
+    std::stable_sort(expected.begin(), expected.end(), [](const record& lhs, const record& rhs) {
+        return lhs.key < rhs.key;
+    });
+    CHECK( res == expected );
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/incremental_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "incremental_sorter tests", "[utility][incremental_sorter]" )
+{
+    auto check_distribution = [](auto distribution, int size, int page_size) {
+        std::vector<int> collection;
+        distribution(std::back_inserter(collection), size);
+        auto sorted = collection;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto sorter = cppsort::utility::make_incremental_sorter(collection);
+        auto previous_end = sorter.sorted_end();
+        while (not sorter.done()) {
+            auto sorted_end = sorter.next(page_size);
+            CHECK( sorted_end == sorter.sorted_end() );
+            CHECK( (sorted_end - previous_end >= page_size || sorted_end == collection.end()) );
+            CHECK( std::equal(collection.begin(), sorted_end, sorted.begin()) );
+            previous_end = sorted_end;
+        }
+        CHECK( collection == sorted );
+    };
+
+    SECTION( "different distributions" )
+    {
+        for (int page_size: { 1, 50, 1'000 }) {
+            check_distribution(dist::shuffled{}, 10'000, page_size);
+            check_distribution(dist::shuffled_16_values{}, 10'000, page_size);
+            check_distribution(dist::all_equal{}, 10'000, page_size);
+            check_distribution(dist::ascending{}, 10'000, page_size);
+            check_distribution(dist::descending{}, 10'000, page_size);
+            check_distribution(dist::pipe_organ{}, 10'000, page_size);
+            check_distribution(dist::push_front{}, 10'000, page_size);
+            check_distribution(dist::median_of_3_killer{}, 10'000, page_size);
+        }
+        check_distribution(dist::shuffled{}, 30, 50);
+    }
+
+    SECTION( "empty collection" )
+    {
+        std::vector<int> collection;
+        auto sorter = cppsort::utility::make_incremental_sorter(collection);
+        CHECK( sorter.done() );
+        CHECK( sorter.next(50) == collection.end() );
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        std::vector<generic_wrapper<int>> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000);
+
+        auto sorter = cppsort::utility::make_incremental_sorter(
+            collection.begin(), collection.end(),
+            std::greater<>{}, &generic_wrapper<int>::value
+        );
+        auto is_sorted_prefix = [&](auto sorted_end) {
+            for (auto it = collection.begin() ; it != sorted_end ; ++it) {
+                if (it->value != 9'999 - (it - collection.begin())) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        auto sorted_end = sorter.next(100);
+        CHECK( sorted_end - collection.begin() >= 100 );
+        CHECK( is_sorted_prefix(sorted_end) );
+
+        auto previous_end = sorted_end;
+        sorted_end = sorter.next(100);
+        CHECK( sorted_end - previous_end >= 100 );
+        CHECK( is_sorted_prefix(sorted_end) );
+    }
+
+    SECTION( "work is reused between calls" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'000);
+        auto copy = collection;
+
+        long long int count = 0;
+        auto counting_less = [&count](int lhs, int rhs) {
+            ++count;
+            return lhs < rhs;
+        };
+
+        cppsort::pdq_sort(copy, counting_less);
+        auto full_sort_count = count;
+
+        // The first page only needs a fraction of the work of
+        // a full sort, and sorting the whole collection page by
+        // page doesn't cost more than a full sort
+        count = 0;
+        auto sorter = cppsort::utility::make_incremental_sorter(collection, counting_less);
+        sorter.next(50);
+        CHECK( count < full_sort_count / 4 );
+        while (not sorter.done()) {
+            sorter.next(50);
+        }
+        CHECK( collection == copy );
+        CHECK( count < full_sort_count * 5 / 4 );
+    }
+
+    SECTION( "adversarial comparison function" )
+    {
+        // McIlroy's "A Killer Adversary for Quicksort": the values
+        // of the elements are only decided when they are compared,
+        // in a way that makes every partition as unbalanced as
+        // possible; the number of comparisons must stay O(n log n)
+        for (int page_size: { 1, 100, 100'000 }) {
+            constexpr int size = 100'000;
+            const int gas = size;
+            std::vector<int> values(size, gas);
+            int nb_solid = 0;
+            int candidate = 0;
+            long long int count = 0;
+            auto adversary = [&](int lhs, int rhs) {
+                ++count;
+                if (values[lhs] == gas && values[rhs] == gas) {
+                    values[lhs == candidate ? lhs : rhs] = nb_solid++;
+                }
+                if (values[lhs] == gas) {
+                    candidate = lhs;
+                } else if (values[rhs] == gas) {
+                    candidate = rhs;
+                }
+                return values[lhs] < values[rhs];
+            };
+
+            std::vector<int> collection(size);
+            for (int idx = 0 ; idx < size ; ++idx) {
+                collection[idx] = idx;
+            }
+            auto sorter = cppsort::utility::make_incremental_sorter(collection, adversary);
+            while (not sorter.done()) {
+                sorter.next(page_size);
+            }
+            CHECK( std::is_sorted(collection.begin(), collection.end(), [&](int lhs, int rhs) {
+                return values[lhs] < values[rhs];
+            }) );
+            // About 17 comparisons per element for log2(n)
+            CHECK( count < 4LL * size * 17 );
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/utility/is_sorted.h>
+#include <cpp-sort/detail/config.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "is_sorted and is_sorted_until", "[utility][is_sorted]" )
+{
+    using cppsort::utility::is_sorted;
+    using cppsort::utility::is_sorted_until;
+
+    SECTION( "simple tests" )
+    {
+        std::vector<int> vec = { 0, 1, 1, 2, 5, 8, 3, 9 };
+        CHECK( is_sorted_until(vec) == vec.begin() + 6 );
+        CHECK( is_sorted_until(vec.begin(), vec.end()) == vec.begin() + 6 );
+        CHECK( not is_sorted(vec) );
+        CHECK( is_sorted(vec.begin(), vec.begin() + 6) );
+
+        std::forward_list<int> li = { 5, 4, 4, 2, 3 };
+        CHECK( is_sorted_until(li, std::greater<>{}) == std::next(li.begin(), 4) );
+        CHECK( not is_sorted(li.begin(), li.end(), std::greater<>{}) );
+        CHECK( is_sorted(li, std::less<>{}, std::negate<>{}) == is_sorted(li, std::greater<>{}) );
+
+        std::vector<internal_compare<int>> tricky(vec.begin(), vec.end());
+        CHECK( is_sorted_until(tricky, &internal_compare<int>::compare_to) == tricky.begin() + 6 );
+    }
+
+    SECTION( "corner cases" )
+    {
+        std::vector<int> vec;
+        CHECK( is_sorted(vec) );
+        CHECK( is_sorted_until(vec) == vec.end() );
+
+        vec = { 42 };
+        CHECK( is_sorted(vec) );
+        CHECK( is_sorted_until(vec) == vec.end() );
+    }
+
+#if CPPSORT_IS_CONSTANT_EVALUATED_AVAILABLE
+    SECTION( "constant evaluation" )
+    {
+        // Contiguous arithmetic collections take the vectorized path
+        // at runtime, the scalar one during constant evaluation
+        static constexpr int arr[] = { 0, 1, 1, 2, 5, 8, 3, 9 };
+        static_assert( is_sorted(arr, arr + 6), "" );
+        static_assert( not is_sorted(arr), "" );
+        static_assert( is_sorted_until(arr) == arr + 6, "" );
+        static_assert( is_sorted_until(arr, std::greater<>{}) == arr + 1, "" );
+
+        static constexpr double darr[] = { 0.5, 1.0, 1.5, 2.0 };
+        static_assert( is_sorted(darr), "" );
+        CHECK( is_sorted_until(arr) == arr + 6 );
+    }
+#endif
+
+    SECTION( "vectorized paths" )
+    {
+        // Big enough to go through vector registers, with a
+        // step-down at every position of a register
+        for (int pos = 1 ; pos < 150 ; ++pos) {
+            std::vector<int> vec(200);
+            for (int i = 0 ; i < 200 ; ++i) {
+                vec[i] = i;
+            }
+            vec[pos] = -1;
+            CHECK( is_sorted_until(vec) == vec.begin() + pos );
+
+            std::vector<double> dvec(vec.begin(), vec.end());
+            CHECK( is_sorted_until(dvec) == dvec.begin() + pos );
+            CHECK( not is_sorted(dvec) );
+        }
+    }
+}
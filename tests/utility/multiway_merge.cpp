@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/multiway_merge.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "multiway_merge test", "[utility][multiway_merge]" )
+{
+    using cppsort::utility::multiway_merge;
+
+    SECTION( "vectors of different sizes" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000);
+
+        // 37 sorted runs of different sizes, some of them empty
+        std::vector<std::vector<int>> runs(37);
+        for (std::size_t idx = 0 ; idx < collection.size() ; ++idx) {
+            runs[(idx * idx) % runs.size()].push_back(collection[idx]);
+        }
+        for (auto& run: runs) {
+            std::sort(run.begin(), run.end());
+        }
+
+        std::vector<int> res;
+        multiway_merge(runs, std::back_inserter(res));
+        std::sort(collection.begin(), collection.end());
+        CHECK( res == collection );
+    }
+
+    SECTION( "pairs of iterators" )
+    {
+        std::list<int> li1 = { 0, 3, 6, 9 };
+        std::list<int> li2 = { 1, 4, 7 };
+        std::list<int> li3 = { 2, 5, 8, 10, 11 };
+        using iterator = std::list<int>::iterator;
+        std::vector<std::pair<iterator, iterator>> runs = {
+            { li1.begin(), li1.end() },
+            { li2.begin(), li2.end() },
+            { li3.begin(), li3.end() }
+        };
+
+        std::vector<int> res(12);
+        auto out = multiway_merge(runs, res.begin());
+        CHECK( out == res.end() );
+        CHECK( res == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 } );
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        std::vector<std::vector<int>> runs = {
+            { 9, 7, 5, 3, 1 },
+            { 8, 6, 4, 2, 0 },
+            { 10, 4, -1 }
+        };
+        std::vector<int> res;
+        multiway_merge(runs, std::back_inserter(res), std::less<>{}, std::negate<>{});
+        CHECK( res == std::vector<int>{ 10, 9, 8, 7, 6, 5, 4, 4, 3, 2, 1, 0, -1 } );
+    }
+
+    SECTION( "stability" )
+    {
+        // Equivalent elements are taken from the earliest run first
+        std::vector<std::vector<std::pair<int, int>>> runs = {
+            { {0, 0}, {1, 0}, {2, 0}, {2, 1} },
+            { {0, 1}, {2, 2} },
+            { {1, 1}, {1, 2}, {2, 3} },
+            { {0, 2}, {0, 3} }
+        };
+        std::vector<std::pair<int, int>> res;
+        multiway_merge(runs, std::back_inserter(res), std::less<>{}, &std::pair<int, int>::first);
+
+        std::vector<std::pair<int, int>> expected = {
+            {0, 0}, {0, 1}, {0, 2}, {0, 3},
+            {1, 0}, {1, 1}, {1, 2},
+            {2, 0}, {2, 1}, {2, 2}, {2, 3}
+        };
+        CHECK( res == expected );
+    }
+
+    SECTION( "no runs" )
+    {
+        std::vector<std::vector<int>> runs;
+        std::vector<int> res;
+        multiway_merge(runs, std::back_inserter(res));
+        CHECK( res.empty() );
+
+        runs.resize(5);
+        multiway_merge(runs, std::back_inserter(res));
+        CHECK( res.empty() );
+    }
+}